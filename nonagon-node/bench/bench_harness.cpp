@@ -0,0 +1,14 @@
+#include "bench_harness.hpp"
+
+// Counting replacement for the global allocator. It lives in its own
+// translation unit so the compiler never sees a replaced operator new and
+// the free() in operator delete together, which it would report as a
+// mismatched allocation.
+
+void* operator new(size_t size) {
+    bench::g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Timing, allocation counting and reporting shared by the micro-benchmarks.
+// Benchmarks that report allocations link bench_harness.cpp, which
+// replaces the global operator new/delete with a version that counts into
+// g_allocs. block_stm_bench does not, so its worker threads do not contend
+// on the counter.
+
+namespace bench {
+
+// Global allocation counter for allocs/op figures
+inline std::atomic<size_t> g_allocs{0};
+
+// Keeps results observable so loops are not optimized away. Compound
+// assignment to a volatile is deprecated in C++20, hence the spelled-out
+// read and write.
+inline volatile uint64_t g_sink = 0;
+
+template <typename T>
+void sink(T value) {
+    g_sink = g_sink ^ static_cast<uint64_t>(value);
+}
+
+struct Result {
+    std::string name;
+    std::string variant;      // backend, implementation or size class
+    uint64_t param{0};        // input size, leaf count, batch size...
+    size_t bytes{0};          // bytes per op, 0 when an op has no natural size
+    double ns_per_op{0};
+    double ops_per_sec{0};
+    double mb_per_sec{0};
+    double mgas_per_sec{0};
+    double allocs_per_op{0};
+};
+
+inline std::vector<Result> g_results;
+inline double g_min_seconds = 0.25;
+
+// Runs `fn` (which performs `ops_per_call` ops) until at least
+// g_min_seconds have passed or `max_calls` is reached, doubling the call
+// count each round, and records the last round. The returned row may be
+// amended by the caller.
+template <typename Fn>
+Result& measure(const std::string& name, const std::string& variant, uint64_t param,
+                size_t bytes_per_op, size_t ops_per_call, Fn&& fn,
+                size_t max_calls = size_t(1) << 30) {
+    fn();  // warm caches, lazy tables and memoized encodings
+
+    size_t calls = 1;
+    double seconds = 0;
+    size_t allocs = 0;
+    while (true) {
+        size_t before = g_allocs.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; ++i) fn();
+        auto end = std::chrono::steady_clock::now();
+        allocs = g_allocs.load(std::memory_order_relaxed) - before;
+        seconds = std::chrono::duration<double>(end - start).count();
+        if (seconds >= g_min_seconds || calls >= max_calls) break;
+        calls *= 2;
+    }
+
+    double ops = static_cast<double>(calls) * ops_per_call;
+    Result r;
+    r.name = name;
+    r.variant = variant;
+    r.param = param;
+    r.bytes = bytes_per_op;
+    r.ns_per_op = seconds * 1e9 / ops;
+    r.ops_per_sec = ops / seconds;
+    r.mb_per_sec = bytes_per_op ? r.ops_per_sec * bytes_per_op / 1e6 : 0;
+    r.allocs_per_op = allocs / ops;
+    g_results.push_back(r);
+
+    std::cerr << "." << std::flush;
+    return g_results.back();
+}
+
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Optional per-result fields a suite reports; name, variant, ns_per_op
+// and allocs_per_op are always present
+struct JsonFields {
+    bool param = false;
+    bool bytes = false;
+    bool ops_per_sec = false;
+    bool mb_per_sec = false;
+    bool mgas_per_sec = false;
+};
+
+// Prints g_results as one JSON document; `extra` holds top-level
+// name/value pairs whose values are already JSON-encoded
+inline void print_json(const std::string& suite, const JsonFields& fields,
+                       const std::vector<std::pair<std::string, std::string>>& extra = {}) {
+    std::ostringstream os;
+    os << std::setprecision(6);
+    os << "{\n  \"suite\": \"" << json_escape(suite) << "\",\n";
+    for (const auto& [key, value] : extra) {
+        os << "  \"" << json_escape(key) << "\": " << value << ",\n";
+    }
+    os << "  \"results\": [\n";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        os << "    {\"name\": \"" << json_escape(r.name) << "\", "
+           << "\"variant\": \"" << json_escape(r.variant) << "\", ";
+        if (fields.param) os << "\"param\": " << r.param << ", ";
+        if (fields.bytes) os << "\"bytes\": " << r.bytes << ", ";
+        os << "\"ns_per_op\": " << r.ns_per_op << ", ";
+        if (fields.ops_per_sec) os << "\"ops_per_sec\": " << r.ops_per_sec << ", ";
+        if (fields.mb_per_sec) os << "\"mb_per_sec\": " << r.mb_per_sec << ", ";
+        if (fields.mgas_per_sec) os << "\"mgas_per_sec\": " << r.mgas_per_sec << ", ";
+        os << "\"allocs_per_op\": " << r.allocs_per_op << "}"
+           << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+    std::cout << os.str();
+}
+
+struct Options {
+    bool json = false;
+    bool quick = false;
+};
+
+// Accepts --json and --quick; prints usage and returns nullopt otherwise
+inline std::optional<Options> parse_args(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            opts.json = true;
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            opts.quick = true;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--json] [--quick]" << std::endl;
+            return std::nullopt;
+        }
+    }
+    return opts;
+}
+
+} // namespace bench
@@ -0,0 +1,307 @@
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "nonagon/execution.hpp"
+#include "bench_harness.hpp"
+
+// Block execution throughput, serial against the parallel executor.
+//
+//   nonagon_block_stm_bench           human-readable table
+//   nonagon_block_stm_bench --json    one JSON document on stdout
+//   nonagon_block_stm_bench --quick   fewer rounds
+//
+// Every transaction has its own sender. "transfer" blocks are plain value
+// transfers; "swap" blocks call a pool contract that reads its reserve,
+// does some arithmetic and writes the reserve back. The conflict rate is
+// the share of transactions sent to one hot recipient or pool; the rest
+// go to a recipient or pool of their own. Each block runs from the same
+// genesis state and is timed through commit. Receipts and the state root
+// of every parallel run are checked against serial execution; a mismatch
+// exits with status 1. "execs/tx" counts incarnations per transaction,
+// so anything above 1 is re-execution after a conflict.
+
+using namespace nonagon;
+using namespace nonagon::execution;
+
+namespace {
+
+// ============================================================================
+// Workloads
+// ============================================================================
+
+enum Op : uint8_t {
+    STOP = 0x00, ADD = 0x01, MUL = 0x02, SUB = 0x03, POP = 0x50, SLOAD = 0x54, SSTORE = 0x55,
+    JUMPI = 0x57, JUMPDEST = 0x5B, PUSH1 = 0x60, PUSH2 = 0x61, DUP1 = 0x80, SWAP1 = 0x90,
+};
+
+// acc = reserve; repeat `rounds` times acc = acc * 3 + 7;
+// storage[1] = acc; storage[0] = reserve + 1
+Bytes pool_contract(uint8_t rounds) {
+    Bytes code = {PUSH1, 0, SLOAD, DUP1, PUSH1, rounds};
+    const uint8_t loop = static_cast<uint8_t>(code.size());
+    code.insert(code.end(), {
+        JUMPDEST,
+        SWAP1, PUSH1, 3, MUL, PUSH1, 7, ADD, SWAP1,      // [reserve, acc', n]
+        PUSH1, 1, SWAP1, SUB,                            // [reserve, acc', n - 1]
+        DUP1, PUSH2, 0, loop, JUMPI,
+        POP, PUSH1, 1, SSTORE,
+        PUSH1, 1, ADD, PUSH1, 0, SSTORE,
+        STOP,
+    });
+    return code;
+}
+
+constexpr uint8_t POOL_ROUNDS = 50;
+
+Address make_address(uint32_t tag, uint8_t kind) {
+    Address a;
+    a.payment_credential[0] = kind;
+    std::memcpy(a.payment_credential.data() + 1, &tag, sizeof(tag));
+    return a;
+}
+
+struct Workload {
+    std::string name;
+    double conflict{0};
+    std::vector<TransactionPtr> txs;
+    std::vector<Address> pools;  // Contracts to deploy
+};
+
+Workload make_workload(const std::string& name, size_t tx_count, double conflict) {
+    Workload w;
+    w.name = name;
+    w.conflict = conflict;
+
+    const bool swaps = name == "swap";
+    const Address hot = make_address(0, swaps ? 3 : 2);
+    if (swaps) w.pools.push_back(hot);
+
+    std::mt19937_64 rng(0xb10c);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    for (size_t i = 0; i < tx_count; ++i) {
+        Transaction tx;
+        tx.from = make_address(static_cast<uint32_t>(i), 1);
+        tx.nonce = 0;
+        tx.max_fee_per_gas = 1;
+        tx.max_priority_fee_per_gas = 0;
+        tx.gas_limit = swaps ? 200'000 : 21'000;
+        tx.value = swaps ? 0 : 1;
+
+        if (coin(rng) < conflict) {
+            tx.to = hot;
+        } else {
+            tx.to = make_address(static_cast<uint32_t>(i + 1), swaps ? 3 : 2);
+            if (swaps) w.pools.push_back(tx.to);
+        }
+        w.txs.push_back(Transaction::share(std::move(tx)));
+    }
+    return w;
+}
+
+std::shared_ptr<storage::StateManager> genesis(const Workload& w) {
+    auto state = std::make_shared<storage::StateManager>(
+        std::make_shared<storage::MemoryDatabase>());
+    for (const auto& tx : w.txs) {
+        AccountState account;
+        account.balance = 1'000'000'000;
+        state->set_account(tx->from, account);
+    }
+    const Bytes code = pool_contract(POOL_ROUNDS);
+    for (const auto& pool : w.pools) {
+        state->set_code(pool, code);
+    }
+    state->commit();
+    return state;
+}
+
+ExecutionContext block_context() {
+    ExecutionContext ctx{};
+    ctx.coinbase = make_address(0, 0xFF);
+    ctx.block_number = 1;
+    ctx.gas_limit = 1'000'000'000;
+    ctx.base_fee = 1;
+    return ctx;
+}
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct Outcome {
+    Hash256 state_root;
+    std::vector<TransactionProcessor::ProcessResult> results;
+    double seconds{0};
+    ParallelExecutor::Stats stats;
+};
+
+Outcome run_serial(const Workload& w) {
+    auto state = genesis(w);
+    auto evm = std::make_shared<EVM>(state);
+    TransactionProcessor processor(state, evm);
+    ExecutionContext ctx = block_context();
+
+    Outcome out;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& tx : w.txs) {
+        ctx.caller = tx->from;
+        ctx.origin = tx->from;
+        ctx.gas_price = tx->effective_gas_price(ctx.base_fee);
+        out.results.push_back(processor.process(*tx, ctx));
+    }
+    out.state_root = state->commit();
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return out;
+}
+
+Outcome run_parallel(const Workload& w, size_t threads) {
+    auto state = genesis(w);
+    ParallelExecutor executor(state, threads);
+
+    Outcome out;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& result : executor.execute(w.txs, block_context())) {
+        out.results.push_back(std::move(*result));
+    }
+    out.state_root = state->commit();
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out.stats = executor.last_stats();
+    return out;
+}
+
+struct Result {
+    std::string workload;
+    double conflict{0};
+    std::string executor;
+    size_t threads{1};
+    double tx_per_sec{0};
+    double execs_per_tx{0};
+    double speedup{0};
+};
+
+std::vector<Result> g_results;
+size_t g_rounds = 5;
+bool g_failed = false;
+
+bool same_outcome(const Outcome& want, const Outcome& got) {
+    if (want.state_root != got.state_root || want.results.size() != got.results.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < want.results.size(); ++i) {
+        const auto& a = want.results[i];
+        const auto& b = got.results[i];
+        if (a.success != b.success || a.gas_used != b.gas_used || a.error != b.error ||
+            a.receipt.hash() != b.receipt.hash()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Best of g_rounds runs
+Outcome best_of(const std::function<Outcome()>& run) {
+    Outcome best = run();
+    for (size_t i = 1; i < g_rounds; ++i) {
+        Outcome out = run();
+        if (out.seconds < best.seconds) best = std::move(out);
+    }
+    return best;
+}
+
+std::vector<size_t> thread_counts() {
+    std::vector<size_t> counts = {1, 2, 4, 8};
+    size_t hw = ThreadPool::default_threads();
+    if (hw > counts.back()) counts.push_back(hw);
+    return counts;
+}
+
+void bench_workload(const std::string& name, size_t tx_count) {
+    for (double conflict : {0.0, 0.1, 0.5, 1.0}) {
+        const Workload w = make_workload(name, tx_count, conflict);
+
+        const Outcome serial = best_of([&] { return run_serial(w); });
+        const double serial_tps = tx_count / serial.seconds;
+        g_results.push_back({name, conflict, "serial", 1, serial_tps, 1.0, 1.0});
+
+        for (size_t threads : thread_counts()) {
+            const Outcome parallel = best_of([&] { return run_parallel(w, threads); });
+            if (!same_outcome(serial, parallel)) {
+                std::cerr << "\nMISMATCH " << name << " conflict=" << conflict
+                          << " threads=" << threads << std::endl;
+                g_failed = true;
+                continue;
+            }
+            Result r;
+            r.workload = name;
+            r.conflict = conflict;
+            r.executor = "parallel";
+            r.threads = threads;
+            r.tx_per_sec = tx_count / parallel.seconds;
+            r.execs_per_tx = static_cast<double>(parallel.stats.executions) / tx_count;
+            r.speedup = r.tx_per_sec / serial_tps;
+            g_results.push_back(r);
+        }
+        std::cerr << "." << std::flush;
+    }
+}
+
+void print_json() {
+    std::ostringstream os;
+    os << std::setprecision(6);
+    os << "{\n  \"suite\": \"nonagon_block_stm_bench\",\n"
+       << "  \"hardware_threads\": " << ThreadPool::default_threads() << ",\n"
+       << "  \"results\": [\n";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        os << "    {\"workload\": \"" << bench::json_escape(r.workload) << "\", "
+           << "\"conflict\": " << r.conflict << ", "
+           << "\"executor\": \"" << bench::json_escape(r.executor) << "\", "
+           << "\"threads\": " << r.threads << ", "
+           << "\"tx_per_sec\": " << r.tx_per_sec << ", "
+           << "\"execs_per_tx\": " << r.execs_per_tx << ", "
+           << "\"speedup\": " << r.speedup << "}"
+           << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+    std::cout << os.str();
+}
+
+void print_table() {
+    std::cout << "[BENCH] Block execution, serial vs parallel ("
+              << ThreadPool::default_threads() << " hardware threads)" << std::endl;
+    std::cout << std::left << std::setw(10) << "workload" << std::setw(10) << "conflict"
+              << std::setw(10) << "executor" << std::right << std::setw(8) << "threads"
+              << std::setw(12) << "tx/s" << std::setw(10) << "execs/tx"
+              << std::setw(10) << "speedup" << std::endl;
+    for (const auto& r : g_results) {
+        std::ostringstream conflict;
+        conflict << static_cast<int>(r.conflict * 100) << "%";
+        std::cout << std::left << std::setw(10) << r.workload << std::setw(10) << conflict.str()
+                  << std::setw(10) << r.executor << std::right << std::setw(8) << r.threads
+                  << std::fixed << std::setprecision(0) << std::setw(12) << r.tx_per_sec
+                  << std::setprecision(2) << std::setw(10) << r.execs_per_tx
+                  << std::setw(10) << r.speedup << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = bench::parse_args(argc, argv);
+    if (!opts) return 2;
+    if (opts->quick) g_rounds = 2;
+
+    bench_workload("transfer", 2000);
+    bench_workload("swap", 1000);
+
+    std::cerr << std::endl;
+    if (g_failed) return 1;
+
+    if (opts->json) {
+        print_json();
+    } else {
+        print_table();
+    }
+    return 0;
+}
@@ -0,0 +1,306 @@
+#include "nonagon/types.hpp"
+#include "nonagon/storage.hpp"
+#include "nonagon/network.hpp"
+#include "bench_harness.hpp"
+
+// Binary encode/decode throughput for the wire and storage formats.
+//
+//   nonagon_codec_bench           human-readable table
+//   nonagon_codec_bench --json    one JSON document on stdout
+//   nonagon_codec_bench --quick   shorter runs
+//
+// Every result carries the encoded size, ns/op, MB/s of encoded bytes and
+// heap allocations per op. The traffic_* rows encode the same synthetic
+// transfer traffic in both formats to compare V1 and V2 sizes.
+
+using namespace nonagon;
+using namespace bench;
+
+namespace {
+
+Transaction make_tx(uint64_t i, size_t data_len) {
+    Transaction tx;
+    tx.from.payment_credential.fill(static_cast<uint8_t>(i));
+    tx.to.payment_credential.fill(static_cast<uint8_t>(i + 1));
+    tx.nonce = i;
+    tx.value = 1000 + i;
+    tx.max_fee_per_gas = 2000000000;
+    tx.max_priority_fee_per_gas = 1000000000;
+    tx.data.assign(data_len, static_cast<uint8_t>(i));
+    return tx;
+}
+
+void bench_transactions() {
+    for (size_t data_len : {size_t(0), size_t(256)}) {
+        auto tx = make_tx(7, data_len);
+        auto encoded = tx.encode();
+        measure("tx_encode", "cold", data_len, encoded.size(), 1, [&] {
+            sink(tx.encode().back());
+        });
+        measure("tx_decode", "materialize", data_len, encoded.size(), 1, [&] {
+            sink(Transaction::decode(encoded)->nonce);
+        });
+    }
+}
+
+void bench_blocks() {
+    BlockHeader header;
+    header.number = 42;
+    header.timestamp = 1700000000;
+    measure("header_encode", "", 0, header.encoded_size(), 1, [&] {
+        sink(header.encode().back());
+    });
+
+    for (size_t tx_count : {size_t(100), size_t(1000)}) {
+        Block block;
+        block.header = header;
+        for (size_t i = 0; i < tx_count; ++i) {
+            block.add_transaction(make_tx(i, 64));
+        }
+        auto encoded = block.encode();
+
+        // Tx encodings are memoized after the warm-up call, as in storage
+        measure("block_encode", "", tx_count, encoded.size(), 1, [&] {
+            sink(block.encode().back());
+        });
+        measure("block_decode", "materialize", tx_count, encoded.size(), 1, [&] {
+            sink(Block::decode(encoded)->transactions().size());
+        });
+    }
+}
+
+void bench_state() {
+    AccountState account;
+    account.nonce = 12;
+    account.balance = 1000000;
+    account.code_hash.fill(0xcc);
+    auto encoded = account.encode();
+    measure("account_encode", "", 0, encoded.size(), 1, [&] {
+        sink(account.encode().back());
+    });
+    measure("account_decode", "", 0, encoded.size(), 1, [&] {
+        sink(AccountState::decode(encoded).nonce);
+    });
+
+    // Receipts go through the store so the before/after comparison covers
+    // the same code path; the memory database adds a fixed map cost
+    auto db = std::make_shared<storage::MemoryDatabase>();
+    storage::BlockStore store(db);
+    TransactionReceipt receipt;
+    receipt.transaction_hash.fill(0x11);
+    receipt.success = true;
+    receipt.gas_used = 21000;
+    receipt.cumulative_gas_used = 42000;
+    for (int i = 0; i < 2; ++i) {
+        Log log;
+        log.topics.resize(3);
+        log.data.assign(64, 0x22);
+        receipt.logs.push_back(log);
+    }
+    measure("receipt_store", "2 logs", 2, 0, 1, [&] {
+        store.store_receipt(receipt);
+    });
+    measure("receipt_load", "2 logs", 2, 0, 1, [&] {
+        sink(store.get_receipt(receipt.transaction_hash)->gas_used);
+    });
+}
+
+void bench_messages() {
+    for (size_t len : {size_t(64), size_t(64 * 1024)}) {
+        network::Message msg;
+        msg.type = network::MessageType::NewBlock;
+        msg.timestamp = 1700000000;
+        msg.payload.assign(len, 0x5a);
+        auto encoded = msg.encode();
+        measure("message_encode", "", len, encoded.size(), 1, [&] {
+            sink(msg.encode().back());
+        });
+        measure("message_decode", "", len, encoded.size(), 1, [&] {
+            sink(network::Message::decode(encoded)->payload.size());
+        });
+    }
+
+    SettlementBatch batch;
+    batch.batch_id = 3;
+    batch.compressed_data.assign(4096, 0x33);
+    batch.state_proof.resize(20);
+    auto encoded = batch.encode();
+    measure("batch_encode", "4KiB+20", 4096, encoded.size(), 1, [&] {
+        sink(batch.encode().back());
+    });
+}
+
+// Deterministic stand-in for mainnet traffic: transfers among 50 accounts
+// with 18-decimal values and 1-2 gwei fees, one in ten a token call with
+// 68 bytes of call data and one log
+struct Traffic {
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    template <size_t N>
+    void fill(std::array<uint8_t, N>& out) {
+        for (auto& b : out) b = static_cast<uint8_t>(next());
+    }
+};
+
+struct TrafficBlock {
+    Block block;
+    std::vector<TransactionReceipt> receipts;
+};
+
+TrafficBlock make_traffic(size_t tx_count) {
+    Traffic rng;
+    std::vector<Address> accounts(50);
+    std::vector<crypto::Ed25519::PublicKey> keys(accounts.size());
+    std::vector<uint64_t> nonces(accounts.size(), 0);
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        rng.fill(accounts[i].payment_credential);
+        rng.fill(keys[i]);
+    }
+
+    TrafficBlock out;
+    out.block.header.number = 1234567;
+    out.block.header.timestamp = 1700000000;
+    out.block.header.base_fee = 1000000000;
+    out.block.header.l1_block_number = 19000000;
+    rng.fill(out.block.header.parent_hash);
+    rng.fill(out.block.header.state_root);
+    rng.fill(out.block.header.transactions_root);
+    rng.fill(out.block.header.receipts_root);
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < tx_count; ++i) {
+        size_t from = rng.next() % accounts.size();
+        size_t to = rng.next() % accounts.size();
+        bool call = rng.next() % 10 == 0;
+
+        Transaction tx;
+        tx.from = accounts[from];
+        tx.to = accounts[to];
+        tx.nonce = nonces[from]++;
+        tx.value = call ? 0 : (1 + rng.next() % 5000) * 1000000000000000ULL;
+        tx.gas_limit = call ? 65000 : 21000;
+        tx.max_fee_per_gas = 1000000000 + rng.next() % 1000000000;
+        tx.max_priority_fee_per_gas = 100000000;
+        if (call) {
+            tx.data.resize(68);
+            for (auto& b : tx.data) b = static_cast<uint8_t>(rng.next());
+        }
+        tx.sender_pubkey = keys[from];
+        rng.fill(tx.signature);
+
+        TransactionReceipt receipt;
+        rng.fill(receipt.transaction_hash);
+        receipt.success = true;
+        receipt.gas_used = call ? 51000 : 21000;
+        cumulative += receipt.gas_used;
+        receipt.cumulative_gas_used = cumulative;
+        receipt.block_number = out.block.header.number;
+        receipt.transaction_index = i;
+        receipt.from = tx.from;
+        receipt.to = tx.to;
+        if (call) {
+            Log log;
+            log.address = tx.to;
+            log.topics.resize(3);
+            for (auto& topic : log.topics) rng.fill(topic);
+            log.data.resize(32);
+            receipt.logs.push_back(log);
+        }
+
+        out.block.add_transaction(tx);
+        out.receipts.push_back(std::move(receipt));
+    }
+    return out;
+}
+
+void bench_traffic() {
+    const size_t tx_count = 1000;
+    auto traffic = make_traffic(tx_count);
+    const Block& block = traffic.block;
+    const Transaction& tx = *block.transactions().front();
+
+    for (auto encoding : {Encoding::V1, Encoding::V2}) {
+        const std::string variant = encoding == Encoding::V1 ? "v1" : "v2";
+
+        auto tx_bytes = tx.encode(encoding);
+        measure("traffic_tx_enc", variant, 1, tx_bytes.size(), 1, [&] {
+            sink(tx.encode(encoding).back());
+        });
+        measure("traffic_tx_dec", variant, 1, tx_bytes.size(), 1, [&] {
+            sink(Transaction::decode(tx_bytes)->nonce);
+        });
+
+        auto block_bytes = block.encode(encoding);
+        measure("traffic_blk_enc", variant, tx_count, block_bytes.size(), 1, [&] {
+            sink(block.encode(encoding).back());
+        });
+        measure("traffic_blk_dec", variant, tx_count, block_bytes.size(), 1, [&] {
+            sink(Block::decode(block_bytes)->transactions().size());
+        });
+
+        // Every receipt of the block per op
+        std::vector<Bytes> receipt_bytes;
+        size_t receipt_total = 0;
+        for (const auto& r : traffic.receipts) {
+            receipt_bytes.push_back(r.encode(encoding));
+            receipt_total += receipt_bytes.back().size();
+        }
+        measure("traffic_rcpt_enc", variant, tx_count, receipt_total, 1, [&] {
+            for (const auto& r : traffic.receipts) {
+                sink(r.encode(encoding).back());
+            }
+        });
+        measure("traffic_rcpt_dec", variant, tx_count, receipt_total, 1, [&] {
+            for (size_t i = 0; i < tx_count; ++i) {
+                auto decoded = TransactionReceipt::decode(traffic.receipts[i].transaction_hash,
+                                                          receipt_bytes[i]);
+                sink(decoded->gas_used);
+            }
+        });
+    }
+}
+
+void print_table() {
+    std::cout << "[BENCH] Codec benchmarks" << std::endl;
+    std::cout << std::left << std::setw(18) << "name" << std::setw(14) << "variant"
+              << std::right << std::setw(8) << "param" << std::setw(10) << "bytes"
+              << std::setw(14) << "ns/op"
+              << std::setw(12) << "MB/s" << std::setw(12) << "allocs/op" << std::endl;
+    for (const auto& r : g_results) {
+        std::cout << std::left << std::setw(18) << r.name << std::setw(14) << r.variant
+                  << std::right << std::setw(8) << r.param << std::setw(10) << r.bytes
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << r.ns_per_op
+                  << std::setw(12) << r.mb_per_sec
+                  << std::setw(12) << std::setprecision(2) << r.allocs_per_op << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) return 2;
+    if (opts->quick) g_min_seconds = 0.05;
+
+    bench_transactions();
+    bench_blocks();
+    bench_state();
+    bench_messages();
+    bench_traffic();
+    std::cerr << std::endl;
+
+    if (opts->json) {
+        print_json("nonagon_codec_bench", {.param = true, .bytes = true, .mb_per_sec = true});
+    } else {
+        print_table();
+    }
+    return 0;
+}
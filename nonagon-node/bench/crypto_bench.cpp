@@ -0,0 +1,403 @@
+#include "nonagon/crypto.hpp"
+#include "nonagon/types.hpp"
+#include "bench_harness.hpp"
+
+// Crypto micro-benchmarks.
+//
+//   nonagon_crypto_bench           human-readable table
+//   nonagon_crypto_bench --json    one JSON document on stdout
+//   nonagon_crypto_bench --quick   shorter runs, smaller Merkle sets
+//
+// Every result carries ns/op, ops/s, MB/s (where an op has a byte size)
+// and heap allocations per op. Hashing rows are repeated for each
+// Blake2b backend the CPU supports so SIMD and multi-buffer variants
+// can be compared against the scalar baseline. Keccak-256 is compared
+// against a straightforward transcription of the spec, which it must
+// match bit for bit; the process exits 1 if it does not.
+
+using namespace nonagon::crypto;
+using namespace bench;
+
+namespace {
+
+bool g_failed = false;
+
+std::vector<Blake2b256::HashBytes> make_leaves(size_t count) {
+    std::vector<Blake2b256::HashBytes> leaves(count);
+    for (size_t i = 0; i < count; ++i) {
+        leaves[i].fill(static_cast<uint8_t>(i));
+        leaves[i][1] = static_cast<uint8_t>(i >> 8);
+        leaves[i][2] = static_cast<uint8_t>(i >> 16);
+    }
+    return leaves;
+}
+
+void bench_blake2b(const std::string& backend, const std::vector<size_t>& leaf_counts) {
+    for (size_t len : {size_t(32), size_t(64), size_t(1024), size_t(1024 * 1024)}) {
+        std::vector<uint8_t> input(len, 0xab);
+        measure("blake2b_hash", backend, len, len, 1, [&] {
+            input[0]++;
+            sink(Blake2b256::hash(input.data(), input.size())[0]);
+        });
+    }
+
+    // 64-byte Merkle nodes: one call per pair vs the multi-buffer path
+    const size_t pairs = 1 << 14;
+    auto nodes = make_leaves(2 * pairs);
+    std::vector<Blake2b256::HashBytes> out(pairs);
+    measure("blake2b_pair", backend + "/serial", pairs, 64, pairs, [&] {
+        for (size_t i = 0; i < pairs; ++i) {
+            out[i] = Blake2b256::hash(nodes[2 * i].data(), 64);
+        }
+        sink(out[0][0]);
+    });
+    measure("blake2b_pair", backend + "/multi", pairs, 64, pairs, [&] {
+        Blake2b256::combine_pairs(nodes.data(), pairs, out.data());
+        sink(out[0][0]);
+    });
+
+    for (size_t count : leaf_counts) {
+        auto leaves = make_leaves(count);
+        measure("merkle_root", backend, count, 32 * count, 1, [&] {
+            sink(Blake2b256::merkle_root(leaves)[0]);
+        });
+        size_t index = 0;
+        measure("merkle_proof", backend, count, 0, 1, [&] {
+            index = (index + 7919) % count;
+            sink(Blake2b256::merkle_proof(leaves, index)[0][0]);
+        });
+    }
+}
+
+// Keccak-256 written directly from the spec's step mappings: loops over
+// x and y, a temporary B array and no lane tricks. Baseline for keccak_*.
+namespace reference {
+
+const uint64_t RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// Rotation offsets by lane index x + 5y
+const int RHO[25] = {0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39,
+                     41, 45, 15, 21, 8, 18, 2, 61, 56, 14};
+
+uint64_t rotl(uint64_t v, int n) { return n ? (v << n) | (v >> (64 - n)) : v; }
+
+void keccak_f(uint64_t a[25]) {
+    for (int round = 0; round < 24; ++round) {
+        uint64_t c[5], b[25];
+        for (int x = 0; x < 5; ++x) c[x] = a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20];
+        for (int i = 0; i < 25; ++i) a[i] ^= c[(i + 4) % 5] ^ rotl(c[(i + 1) % 5], 1);
+        for (int x = 0; x < 5; ++x) {
+            for (int y = 0; y < 5; ++y) b[y + 5 * ((2 * x + 3 * y) % 5)] = rotl(a[x + 5 * y], RHO[x + 5 * y]);
+        }
+        for (int x = 0; x < 5; ++x) {
+            for (int y = 0; y < 5; ++y) {
+                a[x + 5 * y] = b[x + 5 * y] ^ (~b[(x + 1) % 5 + 5 * y] & b[(x + 2) % 5 + 5 * y]);
+            }
+        }
+        a[0] ^= RC[round];
+    }
+}
+
+Keccak256::HashBytes keccak256(const uint8_t* data, size_t len) {
+    uint64_t a[25] = {0};
+    std::vector<uint8_t> padded(data, data + len);
+    padded.resize((len / Keccak256::RATE + 1) * Keccak256::RATE, 0);
+    padded[len] ^= 0x01;
+    padded.back() ^= 0x80;
+    for (size_t off = 0; off < padded.size(); off += Keccak256::RATE) {
+        for (size_t i = 0; i < Keccak256::RATE / 8; ++i) {
+            for (size_t k = 0; k < 8; ++k) a[i] ^= uint64_t(padded[off + 8 * i + k]) << (8 * k);
+        }
+        keccak_f(a);
+    }
+    Keccak256::HashBytes out;
+    for (size_t i = 0; i < out.size(); ++i) out[i] = static_cast<uint8_t>(a[i / 8] >> (8 * (i % 8)));
+    return out;
+}
+
+} // namespace reference
+
+void bench_keccak() {
+    for (size_t len : {size_t(0), size_t(64), size_t(135), size_t(136), size_t(1000)}) {
+        std::vector<uint8_t> input(len);
+        for (size_t i = 0; i < len; ++i) input[i] = static_cast<uint8_t>(i * 7 + 1);
+        if (Keccak256::hash(input) != reference::keccak256(input.data(), len)) {
+            std::cerr << "\nMISMATCH keccak256/" << len << std::endl;
+            g_failed = true;
+        }
+    }
+
+    for (size_t len : {size_t(32), size_t(64), size_t(1024), size_t(1024 * 1024)}) {
+        std::vector<uint8_t> input(len, 0xab);
+        measure("keccak256_hash", "reference", len, len, 1, [&] {
+            input[0]++;
+            sink(reference::keccak256(input.data(), input.size())[0]);
+        });
+        measure("keccak256_hash", "unrolled", len, len, 1, [&] {
+            input[0]++;
+            sink(Keccak256::hash(input.data(), input.size())[0]);
+        });
+    }
+
+    // 64-byte mapping-slot preimages (key . slot): serial vs multi-buffer
+    const size_t count = 1 << 12;
+    auto slots = make_leaves(2 * count);
+    std::vector<const uint8_t*> inputs(count);
+    std::vector<size_t> lens(count, 64);
+    for (size_t i = 0; i < count; ++i) inputs[i] = slots[2 * i].data();
+    std::vector<Keccak256::HashBytes> out(count);
+
+    measure("keccak256_slot", "serial", count, 64, count, [&] {
+        for (size_t i = 0; i < count; ++i) out[i] = Keccak256::hash(inputs[i], 64);
+        sink(out[0][0]);
+    });
+    auto selected = Keccak256::backend();
+    for (auto backend : {Keccak256::Backend::Scalar, Keccak256::Backend::AVX2}) {
+        if (!Keccak256::set_backend(backend)) continue;
+        std::vector<Keccak256::HashBytes> many(count);
+        Keccak256::hash_many(inputs.data(), lens.data(), count, many.data());
+        if (many != out) {
+            std::cerr << "\nMISMATCH keccak256_slot/" << Keccak256::backend_name(backend) << std::endl;
+            g_failed = true;
+        }
+        measure("keccak256_slot", std::string(Keccak256::backend_name(backend)) + "/multi",
+                count, 64, count, [&] {
+            Keccak256::hash_many(inputs.data(), lens.data(), count, out.data());
+            sink(out[0][0]);
+        });
+    }
+    Keccak256::set_backend(selected);
+}
+
+void bench_merkle_tree(const std::vector<size_t>& leaf_counts) {
+    for (size_t count : leaf_counts) {
+        auto leaves = make_leaves(count);
+        measure("merkle_tree_build", "MerkleTree", count, 32 * count, 1, [&] {
+            sink(MerkleTree(leaves).root()[0]);
+        });
+
+        MerkleTree tree(leaves);
+        size_t index = 0;
+        measure("merkle_tree_proof", "MerkleTree", count, 0, 1, [&] {
+            index = (index + 7919) % count;
+            sink(tree.proof(index)[0][0]);
+        });
+    }
+}
+
+void bench_ed25519(size_t max_batch) {
+    Ed25519::Seed seed{};
+    seed[0] = 7;
+    auto kp = Ed25519::keypair_from_seed(seed);
+    Blake2b256::HashBytes message{};  // block-hash sized
+
+    measure("ed25519_keygen", "fixed-base", 32, 0, 1, [&] {
+        seed[1]++;
+        sink(Ed25519::keypair_from_seed(seed).public_key[0]);
+    });
+    measure("ed25519_sign", "fixed-base", 32, 0, 1, [&] {
+        message[0]++;
+        sink(Ed25519::sign(message.data(), message.size(), kp.secret_key)[63]);
+    });
+
+    auto sig = Ed25519::sign(message.data(), message.size(), kp.secret_key);
+    measure("ed25519_verify", "single", 32, 0, 1, [&] {
+        sink(Ed25519::verify(message.data(), message.size(), sig, kp.public_key));
+    });
+
+    // Distinct keys and messages; ns/op is per signature
+    std::vector<Ed25519::KeyPair> keys(max_batch);
+    std::vector<Blake2b256::HashBytes> messages(max_batch);
+    std::vector<Ed25519::Signature> sigs(max_batch);
+    for (size_t i = 0; i < max_batch; ++i) {
+        Ed25519::Seed s{};
+        s[0] = static_cast<uint8_t>(i);
+        s[1] = static_cast<uint8_t>(i >> 8);
+        keys[i] = Ed25519::keypair_from_seed(s);
+        messages[i].fill(static_cast<uint8_t>(i * 31));
+        sigs[i] = Ed25519::sign(messages[i].data(), messages[i].size(), keys[i].secret_key);
+    }
+    for (size_t batch = 1; batch <= max_batch; batch *= 4) {
+        std::vector<Ed25519::BatchEntry> entries;
+        for (size_t i = 0; i < batch; ++i) {
+            entries.push_back({messages[i].data(), messages[i].size(), &sigs[i], &keys[i].public_key});
+        }
+        measure("ed25519_verify_batch", "msm", batch, 0, batch, [&] {
+            if (!Ed25519::verify_batch(entries)) {
+                std::cerr << "[BENCH] Ed25519 batch verification failed" << std::endl;
+                std::exit(1);
+            }
+        });
+    }
+}
+
+void bench_encoding() {
+    auto kp = Ed25519::keypair_from_seed(Ed25519::Seed{});
+    auto addr = nonagon::Address::from_public_key(kp.public_key);
+    auto bech = addr.to_bech32();
+    auto hex = "0x" + addr.to_hex();
+
+    std::vector<uint8_t> payload(29, 0x5a);
+    auto encoded = Bech32::encode(Bech32::MAINNET_PREFIX, payload);
+
+    measure("bech32_encode", "29B", 29, 29, 1, [&] {
+        sink(Bech32::encode(Bech32::MAINNET_PREFIX, payload).back());
+    });
+    measure("bech32_decode", "29B", 29, 29, 1, [&] {
+        std::string hrp;
+        std::vector<uint8_t> data;
+        sink(Bech32::decode(encoded, hrp, data));
+    });
+    measure("address_to_bech32", "enterprise", 29, 0, 1, [&] {
+        sink(addr.to_bech32().back());
+    });
+    measure("address_from_bech32", "enterprise", 29, 0, 1, [&] {
+        sink(nonagon::Address::from_bech32(bech).has_value());
+    });
+    measure("address_to_hex", "enterprise", 29, 0, 1, [&] {
+        sink(addr.to_hex().back());
+    });
+    measure("address_from_hex", "enterprise", 29, 0, 1, [&] {
+        sink(nonagon::Address::from_hex(hex).has_value());
+    });
+}
+
+// Every tx hash, the transactions root and the header hash of one block.
+// "cold" re-shares every tx so nothing is memoized; "memoized" reuses the
+// shared transactions the way mempool -> block -> storage does.
+void bench_block_hash() {
+    for (size_t tx_count : {size_t(1), size_t(100), size_t(1000)}) {
+        nonagon::Block block;
+        for (size_t i = 0; i < tx_count; ++i) {
+            nonagon::Transaction tx;
+            tx.nonce = i;
+            tx.value = 1000 + i;
+            block.add_transaction(tx);
+        }
+
+        // The copy is inside the timed region; allocs/op includes it
+        measure("block_hash", "cold", tx_count, 0, 1, [&] {
+            nonagon::Block fresh;
+            fresh.header = block.header;
+            std::vector<nonagon::TransactionPtr> txs;
+            txs.reserve(tx_count);
+            for (const auto& tx : block.transactions()) {
+                txs.push_back(nonagon::Transaction::share(*tx));
+            }
+            fresh.set_transactions(std::move(txs));
+            for (const auto& tx : fresh.transactions()) {
+                sink(tx->hash()[0]);
+            }
+            fresh.header.transactions_root = fresh.compute_transactions_root();
+            sink(fresh.header.hash()[0]);
+        });
+
+        measure("block_hash", "memoized", tx_count, 0, 1, [&] {
+            nonagon::Block fresh;
+            fresh.header = block.header;
+            fresh.set_transactions(block.transactions());
+            for (const auto& tx : fresh.transactions()) {
+                sink(tx->hash()[0]);
+            }
+            fresh.header.transactions_root = fresh.compute_transactions_root();
+            sink(fresh.header.hash()[0]);
+        });
+    }
+}
+
+// Listing the five fields an explorer shows (hash, from, to, value, nonce)
+// from an encoded block: full Block::decode against a BlockView
+void bench_block_decode() {
+    for (size_t tx_count : {size_t(100), size_t(1000)}) {
+        nonagon::Block block;
+        for (size_t i = 0; i < tx_count; ++i) {
+            nonagon::Transaction tx;
+            tx.nonce = i;
+            tx.value = 1000 + i;
+            tx.data.assign(64, static_cast<uint8_t>(i));
+            block.add_transaction(tx);
+        }
+        const nonagon::Bytes encoded = block.encode();
+
+        measure("block_decode", "materialize", tx_count, encoded.size(), 1, [&] {
+            auto decoded = nonagon::Block::decode(encoded);
+            for (const auto& tx : decoded->transactions()) {
+                sink(tx->hash()[0] ^ tx->from.payment_credential[0] ^
+                     tx->to.payment_credential[0] ^ tx->value ^ tx->nonce);
+            }
+        });
+
+        measure("block_decode", "view", tx_count, encoded.size(), 1, [&] {
+            auto view = nonagon::BlockView::parse(encoded);
+            for (const auto& tx : view->transactions()) {
+                sink(tx.hash()[0] ^ tx.from().payment_credential[0] ^
+                     tx.to().payment_credential[0] ^ tx.value() ^ tx.nonce());
+            }
+        });
+    }
+}
+
+void print_table(const std::string& selected) {
+    std::cout << "[BENCH] Crypto micro-benchmarks (Blake2b default: " << selected << ")" << std::endl;
+    std::cout << std::left << std::setw(24) << "name" << std::setw(18) << "variant"
+              << std::right << std::setw(10) << "param" << std::setw(16) << "ns/op"
+              << std::setw(14) << "ops/s" << std::setw(12) << "MB/s"
+              << std::setw(12) << "allocs/op" << std::endl;
+    for (const auto& r : g_results) {
+        std::cout << std::left << std::setw(24) << r.name << std::setw(18) << r.variant
+                  << std::right << std::setw(10) << r.param
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(16) << r.ns_per_op
+                  << std::setw(14) << std::setprecision(0) << r.ops_per_sec
+                  << std::setw(12) << std::setprecision(1) << r.mb_per_sec
+                  << std::setw(12) << std::setprecision(2) << r.allocs_per_op << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) return 2;
+    const bool quick = opts->quick;
+    if (quick) g_min_seconds = 0.05;
+
+    std::vector<size_t> leaf_counts = {1000, 10000, 100000};
+    if (!quick) leaf_counts.push_back(size_t(1) << 20);
+
+    auto selected = Blake2b256::backend();
+    const Blake2b256::Backend backends[] = {
+        Blake2b256::Backend::Scalar, Blake2b256::Backend::SSE41,
+        Blake2b256::Backend::AVX2, Blake2b256::Backend::AVX512
+    };
+    for (auto backend : backends) {
+        if (!Blake2b256::set_backend(backend)) continue;
+        bench_blake2b(Blake2b256::backend_name(backend), leaf_counts);
+    }
+    Blake2b256::set_backend(selected);
+
+    bench_keccak();
+    bench_merkle_tree(leaf_counts);
+    bench_ed25519(quick ? 256 : 4096);
+    bench_encoding();
+    bench_block_hash();
+    bench_block_decode();
+    std::cerr << std::endl;
+
+    if (opts->json) {
+        print_json("nonagon_crypto_bench",
+                   {.param = true, .ops_per_sec = true, .mb_per_sec = true},
+                   {{"blake2b_default_backend",
+                     "\"" + json_escape(Blake2b256::backend_name(selected)) + "\""}});
+    } else {
+        print_table(Blake2b256::backend_name(selected));
+    }
+    return g_failed ? 1 : 0;
+}
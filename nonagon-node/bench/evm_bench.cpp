@@ -0,0 +1,462 @@
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "nonagon/execution.hpp"
+#include "bench_harness.hpp"
+
+// EVM interpreter throughput on small hand-assembled contracts.
+//
+//   nonagon_evm_bench           human-readable table
+//   nonagon_evm_bench --json    one JSON document on stdout
+//   nonagon_evm_bench --quick   shorter runs
+//
+// "arith" is a loop of 256-bit arithmetic and stack shuffling, so it
+// measures dispatch plus uint256; "storage" stores and reloads one slot
+// per iteration through a state-changing transaction; "memory" copies
+// 4 KB of calldata into memory per iteration; "mapping" hashes one of
+// eight mapping keys per iteration with KECCAK256; "call" is a router
+// that CALLs a small contract once per iteration; "transfer" is a plain
+// value transfer between accounts without code; "jump" is a bare loop
+// placed at the end of a 24 KB contract, where every taken jump is
+// validated. "analyze" is the one-off cost of analysing 24 KB of code
+// (basic blocks and JUMPDEST bitmap), which the code cache amortizes.
+// Each contract's output is checked against the same computation done in
+// C++ before it is timed; a mismatch exits with status 1. Configure with
+// -DNONAGON_EVM_SWITCH_DISPATCH=ON to time the portable switch loop.
+
+using namespace nonagon;
+using namespace nonagon::execution;
+using namespace bench;
+
+namespace {
+
+// ============================================================================
+// Assembler
+// ============================================================================
+
+enum Op : uint8_t {
+    STOP = 0x00, ADD = 0x01, MUL = 0x02, SUB = 0x03, AND = 0x16, XOR = 0x18, KECCAK256 = 0x20,
+    ISZERO = 0x15, SHL = 0x1B, SHR = 0x1C, CALLDATASIZE = 0x36, CALLDATACOPY = 0x37, POP = 0x50,
+    MLOAD = 0x51, MSTORE = 0x52, SLOAD = 0x54, SSTORE = 0x55,
+    JUMP = 0x56, JUMPI = 0x57, JUMPDEST = 0x5B, PUSH1 = 0x60, PUSH2 = 0x61,
+    PUSH28 = 0x7B, DUP1 = 0x80, DUP2 = 0x81, DUP3 = 0x82, SWAP1 = 0x90, CALL = 0xF1,
+    RETURN = 0xF3,
+};
+
+// Straight-line bytecode with forward and backward labels
+struct Asm {
+    Bytes code;
+    std::map<std::string, size_t> labels;
+    std::vector<std::pair<size_t, std::string>> fixups;
+
+    Asm& op(uint8_t o) {
+        code.push_back(o);
+        return *this;
+    }
+
+    Asm& push(uint16_t v) {
+        if (v <= 0xFF) return op(PUSH1).op(static_cast<uint8_t>(v));
+        return op(PUSH2).op(static_cast<uint8_t>(v >> 8)).op(static_cast<uint8_t>(v));
+    }
+
+    Asm& push_address(const Address& addr) {
+        op(PUSH28);
+        code.insert(code.end(), addr.payment_credential.begin(), addr.payment_credential.end());
+        return *this;
+    }
+
+    Asm& label(const std::string& name) {
+        labels[name] = code.size();
+        return op(JUMPDEST);
+    }
+
+    Asm& push_label(const std::string& name) {
+        fixups.emplace_back(code.size() + 1, name);
+        return op(PUSH2).op(0).op(0);
+    }
+
+    Bytes finish() {
+        for (const auto& [at, name] : fixups) {
+            size_t dest = labels.at(name);
+            code[at] = static_cast<uint8_t>(dest >> 8);
+            code[at + 1] = static_cast<uint8_t>(dest);
+        }
+        return code;
+    }
+};
+
+// Loop prologue/epilogue around a body that sees [counter, acc] (acc on
+// top) and must leave the same shape; returns acc as 32 bytes. `skipped`
+// is jumped over, so the loop sits at the end of the code.
+Bytes counted_loop(uint16_t iterations, const std::function<void(Asm&)>& body,
+                   const Bytes& skipped = {}) {
+    Asm a;
+    if (!skipped.empty()) {
+        a.push_label("start").op(JUMP);
+        a.code.insert(a.code.end(), skipped.begin(), skipped.end());
+        a.label("start");
+    }
+    a.push(iterations).push(1);
+    a.label("loop");
+    body(a);
+    a.op(SWAP1).push(1).op(SWAP1).op(SUB);              // [acc, counter - 1]
+    a.op(DUP1).op(ISZERO).push_label("end").op(JUMPI);
+    a.op(SWAP1).push_label("loop").op(JUMP);
+    a.label("end");
+    a.op(POP).push(0).op(MSTORE).push(32).push(0).op(RETURN);
+    return a.finish();
+}
+
+// acc = ((acc * 3 + 7) ^ (acc << 5)) + (acc >> 3)
+Bytes arith_contract(uint16_t iterations) {
+    return counted_loop(iterations, [](Asm& a) {
+        a.push(3).op(MUL).push(7).op(ADD);
+        a.op(DUP1).push(5).op(SHL).op(XOR);
+        a.op(DUP1).push(3).op(SHR).op(ADD);
+    });
+}
+
+uint256 arith_expected(uint16_t iterations) {
+    uint256 acc = 1;
+    for (uint16_t i = 0; i < iterations; ++i) {
+        acc = acc * 3 + 7;
+        acc = acc ^ (acc << 5);
+        acc = acc + (acc >> 3);
+    }
+    return acc;
+}
+
+// storage[counter] = acc; acc += storage[counter]
+Bytes storage_contract(uint16_t iterations) {
+    return counted_loop(iterations, [](Asm& a) {
+        a.op(DUP1).op(DUP3).op(SSTORE);                    // key = counter, value = acc
+        a.op(DUP2).op(SLOAD).op(ADD);
+    });
+}
+
+uint256 storage_expected(uint16_t iterations) {
+    uint256 acc = 1;
+    for (uint16_t i = 0; i < iterations; ++i) acc = acc + acc;
+    return acc;
+}
+
+// Copies all calldata to memory, then acc += mload(0) and mstore(4096, acc)
+Bytes memory_contract(uint16_t iterations) {
+    return counted_loop(iterations, [](Asm& a) {
+        a.op(CALLDATASIZE).push(0).push(0).op(CALLDATACOPY);
+        a.push(0).op(MLOAD).op(ADD);
+        a.op(DUP1).push(4096).op(MSTORE);
+    });
+}
+
+// 4 KB of calldata whose first word is 5
+Bytes memory_input() {
+    Bytes input(4096);
+    for (size_t i = 32; i < input.size(); ++i) input[i] = static_cast<uint8_t>(i * 31);
+    input[31] = 5;
+    return input;
+}
+
+// acc += keccak256(counter % 8 . 1): the slot of mapping entry
+// counter % 8 when the mapping is declared in storage slot 1
+Bytes mapping_contract(uint16_t iterations) {
+    return counted_loop(iterations, [](Asm& a) {
+        a.op(DUP2).push(7).op(AND).push(0).op(MSTORE);
+        a.push(1).push(32).op(MSTORE);
+        a.push(64).push(0).op(KECCAK256).op(ADD);
+    });
+}
+
+uint256 mapping_expected(uint16_t iterations) {
+    uint256 acc = 1;
+    for (uint16_t counter = iterations; counter > 0; --counter) {
+        uint8_t preimage[64];
+        uint256(counter % 8).to_bytes(preimage);
+        uint256(1).to_bytes(preimage + 32);
+        auto slot = nonagon::crypto::Keccak256::hash(preimage, sizeof(preimage));
+        acc = acc + uint256::from_bytes(slot.data(), slot.size());
+    }
+    return acc;
+}
+
+// acc += CALL(callee), with 32 bytes of return data; the callee is
+// returns_word()
+Bytes router_contract(uint16_t iterations, const Address& callee) {
+    return counted_loop(iterations, [&](Asm& a) {
+        a.push(32).push(0).push(0).push(0).push(0);     // ret size/offset, args size/offset, value
+        a.push_address(callee).push(0xFFFF).op(CALL).op(ADD);
+    });
+}
+
+Bytes returns_word() {
+    Asm a;
+    a.push(42).push(0).op(MSTORE).push(32).push(0).op(RETURN);
+    return a.finish();
+}
+
+// Deterministic stand-in for compiled code: mostly short PUSHes and
+// plain opcodes, with 0x5B bytes inside PUSH data as well as real
+// JUMPDESTs
+Bytes filler(size_t size) {
+    std::mt19937_64 rng(0xc0de);
+    Bytes code;
+    code.reserve(size + 32);
+    while (code.size() < size) {
+        unsigned r = rng() % 100;
+        if (r < 35) {
+            size_t n = r < 5 ? 32 : 1 + rng() % 4;
+            code.push_back(static_cast<uint8_t>(PUSH1 + n - 1));
+            for (size_t i = 0; i < n; ++i) {
+                code.push_back(rng() % 4 ? static_cast<uint8_t>(rng()) : static_cast<uint8_t>(JUMPDEST));
+            }
+        } else if (r < 40) {
+            code.push_back(JUMPDEST);
+        } else {
+            static const uint8_t plain[] = {ADD, MUL, SUB, XOR, ISZERO, SHL, SHR, POP, MSTORE,
+                                            SLOAD, DUP1, DUP2, DUP3, SWAP1, JUMPI, JUMP};
+            code.push_back(plain[rng() % sizeof(plain)]);
+        }
+    }
+    code.resize(size);
+    return code;
+}
+
+constexpr size_t LARGE_CODE = 24 * 1024;
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+bool g_failed = false;
+
+Address make_address(uint8_t tag) {
+    Address a;
+    a.payment_credential.fill(tag);
+    return a;
+}
+
+struct Fixture {
+    std::shared_ptr<storage::StateManager> state =
+        std::make_shared<storage::StateManager>(std::make_shared<storage::MemoryDatabase>());
+    EVM evm{state};
+    Address sender = make_address(0x11);
+    Address contract = make_address(0x22);
+    ExecutionContext ctx{};
+};
+
+// Times `fn`, which returns the gas used by one execution
+template <typename Fn>
+void measure(const std::string& name, const std::string& variant, Fn&& fn,
+             size_t bytes_per_op = 0) {
+    uint64_t gas = 0;
+    size_t runs = 0;
+    Result& r = bench::measure(name, variant, 0, bytes_per_op, 1, [&] {
+        gas += fn();
+        ++runs;
+    }, size_t(1) << 20);
+    r.mgas_per_sec = static_cast<double>(gas) / runs * r.ops_per_sec / 1e6;
+}
+
+bool check(const std::string& name, const ExecutionResult& res, const uint256& want) {
+    uint256 got = res.return_data.size() == 32 ? uint256::from_bytes(res.return_data.data(), 32)
+                                               : uint256{};
+    if (res.success && got == want) return true;
+    std::cerr << "\nMISMATCH " << name << ": success=" << res.success << " error=\""
+              << res.error << "\"" << std::endl;
+    g_failed = true;
+    return false;
+}
+
+void bench_arith() {
+    for (uint16_t iterations : {uint16_t(16), uint16_t(1000)}) {
+        Fixture f;
+        f.state->set_code(f.contract, arith_contract(iterations));
+        const uint64_t gas_limit = 10'000'000;
+
+        const std::string variant = std::to_string(iterations);
+        if (!check("arith/" + variant, f.evm.call(f.sender, f.contract, {}, gas_limit),
+                   arith_expected(iterations))) {
+            continue;
+        }
+        measure("arith", variant, [&] {
+            return f.evm.call(f.sender, f.contract, {}, gas_limit).gas_used;
+        });
+    }
+}
+
+void bench_storage() {
+    for (uint16_t iterations : {uint16_t(16), uint16_t(200)}) {
+        Fixture f;
+        f.state->set_code(f.contract, storage_contract(iterations));
+
+        // Zero fees, so the sender's balance never runs out
+        Transaction tx;
+        tx.from = f.sender;
+        tx.to = f.contract;
+        tx.gas_limit = 30'000'000;
+
+        const std::string variant = std::to_string(iterations);
+        if (!check("storage/" + variant, f.evm.execute_transaction(tx, f.ctx),
+                   storage_expected(iterations))) {
+            continue;
+        }
+        measure("storage", variant, [&] {
+            return f.evm.execute_transaction(tx, f.ctx).gas_used;
+        });
+    }
+}
+
+void bench_memory() {
+    for (uint16_t iterations : {uint16_t(16), uint16_t(200)}) {
+        Fixture f;
+        f.state->set_code(f.contract, memory_contract(iterations));
+        const Bytes input = memory_input();
+        const uint64_t gas_limit = 10'000'000;
+
+        const std::string variant = std::to_string(iterations);
+        if (!check("memory/" + variant, f.evm.call(f.sender, f.contract, input, gas_limit),
+                   uint256(1) + uint256(5) * iterations)) {
+            continue;
+        }
+        measure("memory", variant, [&] {
+            return f.evm.call(f.sender, f.contract, input, gas_limit).gas_used;
+        });
+    }
+}
+
+void bench_mapping() {
+    for (uint16_t iterations : {uint16_t(16), uint16_t(200)}) {
+        Fixture f;
+        f.state->set_code(f.contract, mapping_contract(iterations));
+        const uint64_t gas_limit = 10'000'000;
+
+        const std::string variant = std::to_string(iterations);
+        if (!check("mapping/" + variant, f.evm.call(f.sender, f.contract, {}, gas_limit),
+                   mapping_expected(iterations))) {
+            continue;
+        }
+        measure("mapping", variant, [&] {
+            return f.evm.call(f.sender, f.contract, {}, gas_limit).gas_used;
+        });
+    }
+}
+
+void bench_calls() {
+    for (uint16_t iterations : {uint16_t(1), uint16_t(100)}) {
+        Fixture f;
+        const Address callee = make_address(0x33);
+        f.state->set_code(callee, returns_word());
+        f.state->set_code(f.contract, router_contract(iterations, callee));
+        const uint64_t gas_limit = 10'000'000;
+
+        const std::string variant = std::to_string(iterations);
+        if (!check("call/" + variant, f.evm.call(f.sender, f.contract, {}, gas_limit),
+                   uint256(1) + iterations)) {
+            continue;
+        }
+        measure("call", variant, [&] {
+            return f.evm.call(f.sender, f.contract, {}, gas_limit).gas_used;
+        });
+    }
+}
+
+void bench_transfer() {
+    Fixture f;
+    const Address recipient = make_address(0x33);
+    const Address coinbase = make_address(0x44);
+    AccountState funded;
+    funded.balance = 1ULL << 62;
+    f.state->set_account(f.sender, funded);
+    f.ctx.base_fee = 1;
+    f.ctx.coinbase = coinbase;
+    
+    Transaction tx;
+    tx.from = f.sender;
+    tx.to = recipient;
+    tx.value = 1;
+    tx.gas_limit = 50'000;
+    tx.max_fee_per_gas = 1;
+    
+    auto res = f.evm.execute_transaction(tx, f.ctx);
+    if (!res.success || res.gas_used != GasCosts::TRANSACTION ||
+        f.state->get_balance(recipient) != 1 ||
+        f.state->get_balance(coinbase) != GasCosts::TRANSACTION ||
+        f.state->get_balance(f.sender) != funded.balance - 1 - GasCosts::TRANSACTION ||
+        f.state->get_nonce(f.sender) != 1) {
+        std::cerr << "\nMISMATCH transfer: success=" << res.success << " error=\""
+                  << res.error << "\"" << std::endl;
+        g_failed = true;
+        return;
+    }
+    
+    // Rewinding now and then keeps the state journal from growing without bound
+    const auto start = f.state->snapshot();
+    size_t count = 0;
+    measure("transfer", "native", [&] {
+        if (++count % 4096 == 0) f.state->revert(start);
+        return f.evm.execute_transaction(tx, f.ctx).gas_used;
+    });
+}
+
+void bench_jumps() {
+    const Bytes skipped = filler(LARGE_CODE);
+    Fixture f;
+    f.state->set_code(f.contract, counted_loop(1000, [](Asm&) {}, skipped));
+    const uint64_t gas_limit = 10'000'000;
+
+    const std::string variant = std::to_string(LARGE_CODE);
+    if (!check("jump/" + variant, f.evm.call(f.sender, f.contract, {}, gas_limit), 1)) return;
+    measure("jump", variant, [&] {
+        return f.evm.call(f.sender, f.contract, {}, gas_limit).gas_used;
+    });
+}
+
+void bench_analysis() {
+    const Bytes code = filler(LARGE_CODE);
+    measure("analyze", std::to_string(LARGE_CODE), [&] {
+        sink(CodeAnalysis::analyze(code)->block_count());
+        return uint64_t(0);
+    }, code.size());
+}
+
+void print_table() {
+    std::cout << "[BENCH] EVM interpreter benchmarks" << std::endl;
+    std::cout << std::left << std::setw(10) << "contract" << std::setw(8) << "variant"
+              << std::right << std::setw(14) << "us/call" << std::setw(12) << "Mgas/s"
+              << std::setw(12) << "MB/s" << std::setw(14) << "allocs/call" << std::endl;
+    for (const auto& r : g_results) {
+        std::cout << std::left << std::setw(10) << r.name << std::setw(8) << r.variant
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << r.ns_per_op / 1e3
+                  << std::setw(12) << r.mgas_per_sec
+                  << std::setw(12) << r.mb_per_sec
+                  << std::setw(14) << r.allocs_per_op << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) return 2;
+    g_min_seconds = opts->quick ? 0.1 : 0.5;
+
+    bench_arith();
+    bench_storage();
+    bench_memory();
+    bench_mapping();
+    bench_calls();
+    bench_transfer();
+    bench_jumps();
+    bench_analysis();
+    std::cerr << std::endl;
+    if (g_failed) return 1;
+
+    if (opts->json) {
+        print_json("nonagon_evm_bench", {.mb_per_sec = true, .mgas_per_sec = true});
+    } else {
+        print_table();
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <random>
+#include "nonagon/storage.hpp"
+#include "bench_harness.hpp"
+
+// State proof generation and verification over a committed trie.
+//
+//   nonagon_state_bench           human-readable table
+//   nonagon_state_bench --json    one JSON document on stdout
+//   nonagon_state_bench --quick   shorter runs
+//
+// Each key count gets a multiproof_gen and a multiproof_verify row with
+// ns/op and heap allocations per op; "bytes" is the size of the encoded
+// multiproof. The table also compares it with the same keys proven one
+// at a time.
+
+using namespace nonagon;
+using namespace bench;
+
+namespace {
+
+constexpr uint64_t STATE_SIZE = 100000;
+
+Bytes make_key(uint64_t i) {
+    Bytes key(8);
+    for (int b = 7; b >= 0; --b) {
+        key[7 - b] = static_cast<uint8_t>(i >> (b * 8));
+    }
+    return key;
+}
+
+// Proof sizes for one key count, printed beside the timings
+struct ProofSize {
+    size_t keys{0};
+    size_t multi_bytes{0};
+    size_t single_bytes{0};
+    size_t nodes{0};
+};
+
+std::vector<ProofSize> g_sizes;
+
+bool bench_proofs() {
+    auto db = std::make_shared<storage::MemoryDatabase>();
+    storage::StateTrie trie(db);
+
+    // 80-byte values, same size as an encoded AccountState
+    for (uint64_t i = 0; i < STATE_SIZE; ++i) {
+        trie.put(make_key(i), Bytes(80, static_cast<uint8_t>(i)));
+    }
+    auto root = trie.commit();
+
+    std::mt19937_64 rng(42);
+    for (size_t count : {size_t(1), size_t(100), size_t(10000)}) {
+        std::vector<storage::StateKey> keys;
+        keys.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            keys.push_back(storage::StateKey::from_key(make_key(rng() % STATE_SIZE)));
+        }
+
+        auto proof = trie.get_multiproof(keys);
+        if (!proof) {
+            std::cerr << "\n[BENCH] Proof generation failed" << std::endl;
+            return false;
+        }
+        if (!storage::StateTrie::verify_multiproof(root, *proof)) {
+            std::cerr << "\n[BENCH] Proof verification failed" << std::endl;
+            return false;
+        }
+        const size_t multi_bytes = proof->encode().size();
+
+        measure("multiproof_gen", "", count, multi_bytes, 1, [&] {
+            sink(trie.get_multiproof(keys)->nodes.size());
+        });
+        measure("multiproof_verify", "", count, multi_bytes, 1, [&] {
+            sink(storage::StateTrie::verify_multiproof(root, *proof));
+        });
+
+        // Size of the same keys proven one at a time
+        size_t single_bytes = 0;
+        for (const auto& key : keys) {
+            auto single = trie.get_multiproof(std::vector<storage::StateKey>{key});
+            single_bytes += single->encode().size();
+        }
+        g_sizes.push_back({count, multi_bytes, single_bytes, proof->nodes.size()});
+    }
+    return true;
+}
+
+void print_table() {
+    std::cout << "[BENCH] State proofs over " << STATE_SIZE << " committed leaves" << std::endl;
+    std::cout << std::left << std::setw(20) << "name"
+              << std::right << std::setw(8) << "keys" << std::setw(14) << "us/op"
+              << std::setw(12) << "allocs/op" << std::endl;
+    for (const auto& r : g_results) {
+        std::cout << std::left << std::setw(20) << r.name
+                  << std::right << std::setw(8) << r.param
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << r.ns_per_op / 1e3
+                  << std::setw(12) << r.allocs_per_op << std::endl;
+    }
+    std::cout << std::endl << std::left << std::setw(8) << "keys"
+              << std::right << std::setw(14) << "multi (B)" << std::setw(14) << "single (B)"
+              << std::setw(8) << "nodes" << std::endl;
+    for (const auto& s : g_sizes) {
+        std::cout << std::left << std::setw(8) << s.keys
+                  << std::right << std::setw(14) << s.multi_bytes
+                  << std::setw(14) << s.single_bytes
+                  << std::setw(8) << s.nodes << std::endl;
+    }
+}
+
+std::string sizes_json() {
+    std::ostringstream os;
+    os << "[";
+    for (size_t i = 0; i < g_sizes.size(); ++i) {
+        const auto& s = g_sizes[i];
+        os << (i ? ", " : "") << "{\"keys\": " << s.keys
+           << ", \"multi_bytes\": " << s.multi_bytes
+           << ", \"single_bytes\": " << s.single_bytes
+           << ", \"nodes\": " << s.nodes << "}";
+    }
+    os << "]";
+    return os.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) return 2;
+    if (opts->quick) g_min_seconds = 0.05;
+
+    if (!bench_proofs()) return 1;
+    std::cerr << std::endl;
+
+    if (opts->json) {
+        print_json("nonagon_state_bench", {.param = true, .bytes = true},
+                   {{"state_size", std::to_string(STATE_SIZE)}, {"proof_sizes", sizes_json()}});
+    } else {
+        print_table();
+    }
+    return 0;
+}
@@ -0,0 +1,400 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "nonagon/uint256.hpp"
+#include "bench_harness.hpp"
+
+// 256-bit EVM arithmetic: differential check, then per-op throughput.
+//
+//   nonagon_uint256_bench           human-readable table
+//   nonagon_uint256_bench --json    one JSON document on stdout
+//   nonagon_uint256_bench --quick   shorter runs, fewer checked cases
+//
+// Before timing anything, every operation is compared against a slow
+// bit-serial reference on 32-bit limbs: edge values crossed with each
+// other, then random operands built from edge-heavy limbs (these reach
+// the rare add-back step of the Knuth division). Any mismatch is printed
+// and the process exits with status 1.
+
+using namespace nonagon;
+using namespace bench;
+
+// Compile-time spot checks; the type is usable in constant expressions
+static_assert(uint256(7) * uint256(6) == uint256(42));
+static_assert((uint256(1) << 255) / (uint256(1) << 128) == uint256(1) << 127);
+static_assert(~uint256{} * ~uint256{} == uint256(1));
+static_assert(mulmod(~uint256{}, ~uint256{}, uint256(0, 0, 1, 0)) == uint256(1));
+static_assert(addmod(~uint256{}, uint256(2), ~uint256{}) == uint256(2));
+static_assert(exp(uint256(3), uint256(5)) == uint256(243));
+static_assert((int256(-uint256(7)) / int256(uint256(2))).bits == -uint256(3));
+static_assert((int256(-uint256(7)) % int256(uint256(2))).bits == -uint256(1));
+static_assert(signextend(uint256(0), uint256(0xFF)) == ~uint256{});
+
+namespace {
+
+// ============================================================================
+// Reference implementation: 32-bit limbs, one bit at a time
+// ============================================================================
+
+// Little-endian 32-bit limbs, wide enough for a 512-bit product
+struct Ref {
+    uint32_t l[16] = {};
+};
+
+Ref to_ref(const uint256& x) {
+    Ref r;
+    for (int i = 0; i < 4; ++i) {
+        r.l[2 * i] = static_cast<uint32_t>(x[3 - i]);
+        r.l[2 * i + 1] = static_cast<uint32_t>(x[3 - i] >> 32);
+    }
+    return r;
+}
+
+uint256 from_ref(const Ref& r) {
+    uint256 x;
+    for (int i = 0; i < 4; ++i) {
+        x[3 - i] = uint64_t(r.l[2 * i]) | (uint64_t(r.l[2 * i + 1]) << 32);
+    }
+    return x;
+}
+
+Ref ref_add(const Ref& a, const Ref& b) {
+    Ref r;
+    uint64_t carry = 0;
+    for (int i = 0; i < 16; ++i) {
+        uint64_t s = uint64_t(a.l[i]) + b.l[i] + carry;
+        r.l[i] = static_cast<uint32_t>(s);
+        carry = s >> 32;
+    }
+    return r;
+}
+
+Ref ref_sub(const Ref& a, const Ref& b) {
+    Ref r;
+    int64_t borrow = 0;
+    for (int i = 0; i < 16; ++i) {
+        int64_t d = int64_t(a.l[i]) - b.l[i] - borrow;
+        borrow = d < 0;
+        r.l[i] = static_cast<uint32_t>(d);
+    }
+    return r;
+}
+
+Ref ref_mul(const Ref& a, const Ref& b) {
+    Ref r;
+    for (int i = 0; i < 8; ++i) {
+        uint64_t carry = 0;
+        for (int j = 0; j < 8; ++j) {
+            uint64_t t = uint64_t(a.l[i]) * b.l[j] + r.l[i + j] + carry;
+            r.l[i + j] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+        for (int k = i + 8; carry && k < 16; ++k) {
+            uint64_t t = uint64_t(r.l[k]) + carry;
+            r.l[k] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+    return r;
+}
+
+bool ref_bit(const Ref& a, int i) { return (a.l[i / 32] >> (i % 32)) & 1; }
+
+bool ref_ge(const Ref& a, const Ref& b) {
+    for (int i = 15; i >= 0; --i) {
+        if (a.l[i] != b.l[i]) return a.l[i] > b.l[i];
+    }
+    return true;
+}
+
+bool ref_zero(const Ref& a) {
+    for (auto v : a.l) {
+        if (v) return false;
+    }
+    return true;
+}
+
+// Restoring division, one bit per step; zero divisor gives zeros
+void ref_divmod(const Ref& a, const Ref& b, Ref& q, Ref& r) {
+    q = Ref{};
+    r = Ref{};
+    if (ref_zero(b)) return;
+    for (int i = 511; i >= 0; --i) {
+        r = ref_add(r, r);
+        r.l[0] |= ref_bit(a, i);
+        if (ref_ge(r, b)) {
+            r = ref_sub(r, b);
+            q.l[i / 32] |= 1u << (i % 32);
+        }
+    }
+}
+
+Ref truncate(Ref a) {
+    for (int i = 8; i < 16; ++i) a.l[i] = 0;
+    return a;
+}
+
+uint256 ref_div(const uint256& a, const uint256& b) {
+    Ref q, r;
+    ref_divmod(to_ref(a), to_ref(b), q, r);
+    return from_ref(q);
+}
+
+uint256 ref_mod(const uint256& a, const uint256& b) {
+    Ref q, r;
+    ref_divmod(to_ref(a), to_ref(b), q, r);
+    return from_ref(r);
+}
+
+uint256 ref_addmod(const uint256& a, const uint256& b, const uint256& n) {
+    Ref q, r;
+    ref_divmod(ref_add(to_ref(a), to_ref(b)), to_ref(n), q, r);
+    return from_ref(r);
+}
+
+uint256 ref_mulmod(const uint256& a, const uint256& b, const uint256& n) {
+    Ref q, r;
+    ref_divmod(ref_mul(to_ref(a), to_ref(b)), to_ref(n), q, r);
+    return from_ref(r);
+}
+
+uint256 ref_exp(const uint256& base, const uint256& e) {
+    Ref result = to_ref(uint256(1));
+    Ref eb = to_ref(e);
+    for (int i = 255; i >= 0; --i) {
+        result = truncate(ref_mul(result, result));
+        if (ref_bit(eb, i)) result = truncate(ref_mul(result, to_ref(base)));
+    }
+    return from_ref(result);
+}
+
+bool ref_negative(const uint256& a) { return ref_bit(to_ref(a), 255); }
+uint256 ref_neg(const uint256& a) { return from_ref(truncate(ref_sub(Ref{}, to_ref(a)))); }
+uint256 ref_abs(const uint256& a) { return ref_negative(a) ? ref_neg(a) : a; }
+
+uint256 ref_sdiv(const uint256& a, const uint256& b) {
+    uint256 q = ref_div(ref_abs(a), ref_abs(b));
+    return ref_negative(a) != ref_negative(b) ? ref_neg(q) : q;
+}
+
+uint256 ref_smod(const uint256& a, const uint256& b) {
+    uint256 r = ref_mod(ref_abs(a), ref_abs(b));
+    return ref_negative(a) ? ref_neg(r) : r;
+}
+
+bool ref_slt(const uint256& a, const uint256& b) {
+    if (ref_negative(a) != ref_negative(b)) return ref_negative(a);
+    return a < b;
+}
+
+uint256 ref_shift(const uint256& a, uint64_t s, bool left, bool arithmetic) {
+    Ref in = to_ref(a), out;
+    bool fill = arithmetic && ref_bit(in, 255);
+    for (int i = 0; i < 256; ++i) {
+        int src = left ? i - int(std::min<uint64_t>(s, 256)) : i + int(std::min<uint64_t>(s, 256));
+        bool bit = (src >= 0 && src < 256) ? ref_bit(in, src) : (!left && fill);
+        if (bit) out.l[i / 32] |= 1u << (i % 32);
+    }
+    return from_ref(out);
+}
+
+uint256 ref_signextend(const uint256& b, const uint256& x) {
+    if (!b.fits_u64() || b[3] >= 31) return x;
+    Ref in = to_ref(x), out = in;
+    int sign = int(b[3]) * 8 + 7;
+    for (int i = sign + 1; i < 256; ++i) {
+        out.l[i / 32] &= ~(1u << (i % 32));
+        if (ref_bit(in, sign)) out.l[i / 32] |= 1u << (i % 32);
+    }
+    return from_ref(out);
+}
+
+// ============================================================================
+// Differential check
+// ============================================================================
+
+std::string hex(const uint256& x) {
+    std::ostringstream os;
+    os << "0x" << std::hex << std::setfill('0');
+    for (auto w : x.words) os << std::setw(16) << w;
+    return os.str();
+}
+
+size_t g_checked = 0;
+size_t g_failures = 0;
+
+void expect(const char* op, const uint256& got, const uint256& want,
+            const uint256& a, const uint256& b, const uint256& c = {}) {
+    ++g_checked;
+    if (got == want) return;
+    if (++g_failures <= 20) {
+        std::cerr << "\nMISMATCH " << op << "\n  a=" << hex(a) << "\n  b=" << hex(b)
+                  << "\n  c=" << hex(c) << "\n  got  " << hex(got) << "\n  want " << hex(want)
+                  << std::endl;
+    }
+}
+
+void check_all(const uint256& a, const uint256& b, const uint256& c, bool with_exp) {
+    expect("add", a + b, from_ref(truncate(ref_add(to_ref(a), to_ref(b)))), a, b);
+    expect("sub", a - b, from_ref(truncate(ref_sub(to_ref(a), to_ref(b)))), a, b);
+    expect("mul", a * b, from_ref(truncate(ref_mul(to_ref(a), to_ref(b)))), a, b);
+    expect("div", a / b, ref_div(a, b), a, b);
+    expect("mod", a % b, ref_mod(a, b), a, b);
+    expect("sdiv", (int256(a) / int256(b)).bits, ref_sdiv(a, b), a, b);
+    expect("smod", (int256(a) % int256(b)).bits, ref_smod(a, b), a, b);
+    expect("addmod", addmod(a, b, c), ref_addmod(a, b, c), a, b, c);
+    expect("mulmod", mulmod(a, b, c), ref_mulmod(a, b, c), a, b, c);
+    expect("slt", int256(a) < int256(b) ? 1 : 0, ref_slt(a, b) ? 1 : 0, a, b);
+
+    uint64_t s = b.fits_u64() ? b[3] % 300 : 300;
+    expect("shl", a << s, ref_shift(a, s, true, false), a, s);
+    expect("shr", a >> s, ref_shift(a, s, false, false), a, s);
+    expect("sar", (int256(a) >> s).bits, ref_shift(a, s, false, true), a, s);
+    expect("signextend", signextend(b[3] % 33, a), ref_signextend(b[3] % 33, a), b[3] % 33, a);
+    if (with_exp) expect("exp", exp(a, b), ref_exp(a, b), a, b);
+}
+
+std::vector<uint256> edge_values() {
+    const uint64_t top = uint64_t(1) << 63;
+    return {
+        0, 1, 2, 3, 7, 10, uint64_t(-1), top,
+        uint256(0, 0, 1, 0), uint256(0, 0, 1, 1), uint256(0, 1, 0, 0),
+        uint256(1, 0, 0, 0), uint256(top, 0, 0, 0), uint256(top, 0, 0, 1),
+        uint256(top - 1, ~0ull, ~0ull, ~0ull), ~uint256{}, ~uint256{} - 1,
+        uint256(0, 0, ~0ull, ~0ull), uint256(0, ~0ull, ~0ull, ~0ull),
+        uint256(0, top, 0, 0), uint256(0, 0, top, ~0ull), -uint256(2),
+    };
+}
+
+// Limbs drawn mostly from edge patterns; random high limbs are cleared
+// so every operand width is common
+struct Gen {
+    std::mt19937_64 rng{0x5eed};
+
+    uint64_t limb() {
+        static const uint64_t pattern[] = {0, 1, 2, uint64_t(1) << 63, (uint64_t(1) << 63) - 1,
+                                           ~0ull, ~1ull};
+        return rng() % 3 == 0 ? rng() : pattern[rng() % 7];
+    }
+
+    uint256 value() {
+        uint256 x{limb(), limb(), limb(), limb()};
+        size_t cleared = rng() % 4;
+        for (size_t i = 0; i < cleared; ++i) x[i] = 0;
+        return x;
+    }
+};
+
+bool run_differential(size_t random_cases) {
+    auto edges = edge_values();
+    for (const auto& a : edges) {
+        for (const auto& b : edges) {
+            for (const auto& c : {edges[1], edges[5], edges[11], edges[15], edges[19]}) {
+                check_all(a, b, c, c == edges[1]);
+            }
+        }
+    }
+
+    Gen gen;
+    for (size_t i = 0; i < random_cases; ++i) {
+        // Exponentiation's reference is slow; check a tenth of the cases
+        check_all(gen.value(), gen.value(), gen.value(), i % 10 == 0);
+    }
+
+    std::cerr << "differential: " << g_checked << " checks, " << g_failures << " mismatches"
+              << std::endl;
+    return g_failures == 0;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+constexpr size_t OPERANDS = 1024;
+
+// Runs `fn` over the whole operand set per call; reports per single operation
+template <typename Fn>
+void measure(const std::string& name, const std::string& variant, Fn&& fn) {
+    bench::measure(name, variant, 0, 0, OPERANDS, [&] {
+        uint64_t acc = 0;
+        for (size_t i = 0; i < OPERANDS; ++i) acc ^= fn(i);
+        sink(acc);
+    }, size_t(1) << 24);
+}
+
+// Operand sets: "64" has values below 2^64, "128" below 2^128, "256" full width
+std::vector<uint256> operands(std::mt19937_64& rng, size_t words) {
+    std::vector<uint256> v(OPERANDS);
+    for (auto& x : v) {
+        for (size_t i = 4 - words; i < 4; ++i) x[i] = rng();
+        x[3] |= 1;  // Never zero, so divisions do real work
+    }
+    return v;
+}
+
+void bench_ops() {
+    std::mt19937_64 rng(42);
+    for (size_t words : {size_t(1), size_t(2), size_t(4)}) {
+        const std::string variant = std::to_string(words * 64);
+        auto a = operands(rng, words);
+        auto b = operands(rng, words);
+        auto n = operands(rng, words);
+        auto half = operands(rng, (words + 1) / 2);  // Divisors narrower than a
+        std::vector<uint256> small_exp(OPERANDS);
+        for (auto& e : small_exp) e = rng() % 256;
+
+        measure("add", variant, [&](size_t i) { return (a[i] + b[i])[3]; });
+        measure("sub", variant, [&](size_t i) { return (a[i] - b[i])[3]; });
+        measure("mul", variant, [&](size_t i) { return (a[i] * b[i])[2]; });
+        measure("div", variant, [&](size_t i) { return (a[i] / half[i])[3]; });
+        measure("mod", variant, [&](size_t i) { return (a[i] % half[i])[3]; });
+        measure("sdiv", variant, [&](size_t i) { return (int256(a[i]) / int256(half[i])).bits[3]; });
+        measure("addmod", variant, [&](size_t i) { return addmod(a[i], b[i], n[i])[3]; });
+        measure("mulmod", variant, [&](size_t i) { return mulmod(a[i], b[i], n[i])[3]; });
+        measure("exp", variant, [&](size_t i) { return exp(a[i], small_exp[i])[3]; });
+        measure("shl", variant, [&](size_t i) { return (a[i] << (b[i][3] & 0xFF))[1]; });
+        measure("sar", variant, [&](size_t i) { return (int256(a[i]) >> (b[i][3] & 0xFF)).bits[1]; });
+    }
+}
+
+void print_table() {
+    std::cout << "[BENCH] uint256 benchmarks (" << g_checked << " differential checks passed)"
+              << std::endl;
+    std::cout << std::left << std::setw(10) << "op" << std::setw(8) << "bits"
+              << std::right << std::setw(12) << "ns/op" << std::setw(14) << "Mops/s"
+              << std::setw(12) << "allocs/op" << std::endl;
+    for (const auto& r : g_results) {
+        std::cout << std::left << std::setw(10) << r.name << std::setw(8) << r.variant
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << r.ns_per_op
+                  << std::setw(14) << r.ops_per_sec / 1e6
+                  << std::setw(12) << r.allocs_per_op << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) return 2;
+    size_t random_cases = 200000;
+    if (opts->quick) {
+        g_min_seconds = 0.05;
+        random_cases = 20000;
+    }
+
+    if (!run_differential(random_cases)) return 1;
+
+    bench_ops();
+    std::cerr << std::endl;
+
+    if (opts->json) {
+        print_json("nonagon_uint256_bench", {.ops_per_sec = true},
+                   {{"differential_checks", std::to_string(g_checked)},
+                    {"differential_mismatches", std::to_string(g_failures)}});
+    } else {
+        print_table();
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace nonagon {
+
+/**
+ * @brief Append-only big-endian / LEB128 encoder
+ *
+ * Reserved once from the caller's exact length, then filled with
+ * block appends; no per-byte push_back loops and no zero-fill of the
+ * buffer. An undersized estimate still works but costs a reallocation.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(size_t exact_size = 0) { buf_.reserve(exact_size); }
+
+    void u8(uint8_t v) { buf_.push_back(v); }
+
+    void u32_be(uint32_t v) {
+        const uint8_t b[4] = {static_cast<uint8_t>(v >> 24), static_cast<uint8_t>(v >> 16),
+                              static_cast<uint8_t>(v >> 8), static_cast<uint8_t>(v)};
+        bytes(b, sizeof(b));
+    }
+
+    void u64_be(uint64_t v) {
+        uint8_t b[8];
+        for (int i = 0; i < 8; ++i) {
+            b[i] = static_cast<uint8_t>(v >> ((7 - i) * 8));
+        }
+        bytes(b, sizeof(b));
+    }
+
+    // Unsigned LEB128: seven bits per byte, low group first
+    void varint(uint64_t v) {
+        if (v < 0x80) {
+            buf_.push_back(static_cast<uint8_t>(v));
+            return;
+        }
+        uint8_t b[10];
+        size_t n = 0;
+        while (v >= 0x80) {
+            b[n++] = static_cast<uint8_t>(v) | 0x80;
+            v >>= 7;
+        }
+        b[n++] = static_cast<uint8_t>(v);
+        bytes(b, n);
+    }
+
+    static size_t varint_size(uint64_t v) {
+        size_t n = 1;
+        while (v >= 0x80) {
+            v >>= 7;
+            ++n;
+        }
+        return n;
+    }
+
+    void bytes(const uint8_t* data, size_t len) { buf_.insert(buf_.end(), data, data + len); }
+
+    void bytes(const std::vector<uint8_t>& data) { bytes(data.data(), data.size()); }
+
+    template <size_t N>
+    void bytes(const std::array<uint8_t, N>& data) { bytes(data.data(), N); }
+
+    // u64 length prefix followed by the bytes
+    void prefixed(const uint8_t* data, size_t len) {
+        u64_be(len);
+        bytes(data, len);
+    }
+
+    void prefixed(const std::vector<uint8_t>& data) { prefixed(data.data(), data.size()); }
+
+    size_t size() const { return buf_.size(); }
+
+    // Hands the buffer over; the writer is empty afterwards
+    std::vector<uint8_t> finish() { return std::move(buf_); }
+
+private:
+    std::vector<uint8_t> buf_;
+};
+
+/**
+ * @brief Bounds-checked big-endian / LEB128 decoder over a borrowed buffer
+ *
+ * A read past the end returns zeros and sets a sticky failure flag, so a
+ * decoder can read every field and check ok() once at the end.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t len) : data_(data), len_(len) {}
+    explicit ByteReader(const std::vector<uint8_t>& data) : ByteReader(data.data(), data.size()) {}
+
+    uint8_t u8() {
+        const uint8_t* p = take(1);
+        return p ? p[0] : 0;
+    }
+
+    uint32_t u32_be() {
+        const uint8_t* p = take(4);
+        if (!p) return 0;
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+    }
+
+    uint64_t u64_be() {
+        const uint8_t* p = take(8);
+        if (!p) return 0;
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) {
+            v = (v << 8) | p[i];
+        }
+        return v;
+    }
+
+    // Unsigned LEB128. Only the shortest form of a value that fits in 64
+    // bits is accepted, so every value has exactly one encoding.
+    uint64_t varint() {
+        uint64_t v = 0;
+        size_t i = pos_;
+        for (unsigned shift = 0; ok_ && i < len_ && shift < 64; shift += 7) {
+            uint8_t b = data_[i++];
+            if (shift == 63 && b > 1) break;      // Overflows 64 bits
+            v |= uint64_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) {
+                if (b == 0 && shift > 0) break;  // Redundant trailing group
+                pos_ = i;
+                return v;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    // Copies exactly `len` bytes; leaves `out` untouched on failure
+    void bytes(uint8_t* out, size_t len) {
+        if (const uint8_t* p = take(len)) {
+            if (len) std::memcpy(out, p, len);
+        }
+    }
+
+    template <size_t N>
+    void bytes(std::array<uint8_t, N>& out) { bytes(out.data(), N); }
+
+    // Pointer to the next `len` bytes, or nullptr (and failure) if short
+    const uint8_t* take(size_t len) {
+        if (!ok_ || len > len_ - pos_) {
+            ok_ = false;
+            return nullptr;
+        }
+        const uint8_t* p = data_ + pos_;
+        pos_ += len;
+        return p;
+    }
+
+    bool ok() const { return ok_; }
+    size_t offset() const { return pos_; }
+    size_t remaining() const { return len_ - pos_; }
+
+private:
+    const uint8_t* data_;
+    size_t len_;
+    size_t pos_{0};
+    bool ok_{true};
+};
+
+} // namespace nonagon
@@ -89,6 +89,7 @@ struct BlockProposal {
     Block block;
     crypto::Ed25519::Signature signature;
     
+    void sign(const crypto::Ed25519::SecretKey& sk);
     bool verify(const crypto::Ed25519::PublicKey& pk) const;
     Bytes encode() const;
 };
@@ -119,7 +120,7 @@ public:
     // Block production
     std::optional<Block> produce_block(const Address& sequencer,
                                         const Hash256& parent_hash,
-                                        const std::vector<Transaction>& txs,
+                                        const std::vector<TransactionPtr>& txs,
                                         const Hash256& state_root);
     
     // Block validation
@@ -192,18 +193,19 @@ public:
         PoolFull,
         Invalid
     };
-    AddResult add_transaction(Transaction tx, uint64_t sender_balance);
+    AddResult add_transaction(TransactionPtr tx, uint64_t sender_balance);
+    AddResult add_transaction(const Transaction& tx, uint64_t sender_balance);
     
     bool remove_transaction(const Hash256& hash);
     void remove_confirmed(const std::vector<Hash256>& hashes);
     
     // Query
-    std::optional<Transaction> get_transaction(const Hash256& hash) const;
-    std::vector<Transaction> get_pending_for(const Address& addr) const;
+    TransactionPtr get_transaction(const Hash256& hash) const;  // nullptr if unknown
+    std::vector<TransactionPtr> get_pending_for(const Address& addr) const;
     size_t size() const;
     
     // Block production - get best transactions
-    std::vector<Transaction> get_block_transactions(uint64_t gas_limit, 
+    std::vector<TransactionPtr> get_block_transactions(uint64_t gas_limit, 
                                                      uint64_t base_fee);
     
     // Nonce management
@@ -222,15 +224,16 @@ private:
     size_t max_size_;
     mutable std::shared_mutex mutex_;
     
-    // Transaction pool organized by sender
+    // Transaction pool organized by sender. Both indexes share one
+    // immutable object per transaction.
     struct SenderTxs {
-        std::map<uint64_t, Transaction> by_nonce;  // nonce -> tx
+        std::map<uint64_t, TransactionPtr> by_nonce;  // nonce -> tx
         uint64_t pending_nonce;  // Next expected nonce
     };
     std::unordered_map<std::string, SenderTxs> by_sender_;
     
     // Global index
-    std::unordered_map<std::string, Transaction> by_hash_;
+    std::unordered_map<std::string, TransactionPtr> by_hash_;
     
     // Priority queue by effective gas price
     struct TxPriority {
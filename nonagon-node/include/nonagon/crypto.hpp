@@ -1,10 +1,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <shared_mutex>
+#include <unordered_set>
 
 namespace nonagon {
 namespace crypto {
@@ -26,6 +31,23 @@ public:
     static HashBytes hash(const std::vector<uint8_t>& data);
     static HashBytes hash(const std::string& data);
 
+    // Compression kernel, picked from CPUID on first use. Scalar is the
+    // reference; all backends produce identical digests.
+    enum class Backend { Scalar, SSE41, AVX2, AVX512 };
+    static Backend backend();
+    static bool set_backend(Backend backend);  // False if the CPU lacks it
+    static bool backend_supported(Backend backend);
+    static const char* backend_name(Backend backend);
+
+    // Multi-buffer hashing of independent messages: 8 (AVX-512) or 4 (AVX2)
+    // run in lockstep across SIMD lanes. out[i] == hash(inputs[i], lens[i]).
+    static void hash_many(const uint8_t* const* inputs, const size_t* lens,
+                          size_t count, HashBytes* out);
+    static size_t lanes();
+    
+    // out[i] = H(nodes[2i] || nodes[2i+1]) for i < pairs
+    static void combine_pairs(const HashBytes* nodes, size_t pairs, HashBytes* out);
+
     // Merkle tree operations
     static HashBytes merkle_root(const std::vector<HashBytes>& leaves);
     static std::vector<HashBytes> merkle_proof(const std::vector<HashBytes>& leaves, size_t index);
@@ -33,16 +55,148 @@ public:
                                      size_t index, const HashBytes& root);
 
 private:
+    friend class MerkleAccumulator;
     static HashBytes combine_hashes(const HashBytes& left, const HashBytes& right);
 };
 
 /**
- * @brief Ed25519 signature scheme
+ * @brief Keccak-256 as used by the EVM
+ * 
+ * The original Keccak padding (domain byte 0x01), not FIPS 202 SHA3-256:
+ * KECCAK256, Solidity storage slots and event topics all depend on it.
+ * The scalar permutation is fully unrolled and lane-complemented; on AVX2
+ * CPUs hash_many() runs four messages in lockstep, one per 64-bit lane.
+ */
+class Keccak256 {
+public:
+    static constexpr size_t HASH_SIZE = 32;
+    static constexpr size_t RATE = 136;  // Bytes absorbed per permutation
+    using HashBytes = std::array<uint8_t, HASH_SIZE>;
+
+    static HashBytes hash(const uint8_t* data, size_t len);
+    static HashBytes hash(const std::vector<uint8_t>& data);
+
+    // Multi-buffer kernel, picked from CPUID on first use. Single
+    // messages always take the scalar path; digests never differ.
+    enum class Backend { Scalar, AVX2 };
+    static Backend backend();
+    static bool set_backend(Backend backend);  // False if the CPU lacks it
+    static bool backend_supported(Backend backend);
+    static const char* backend_name(Backend backend);
+
+    // out[i] == hash(inputs[i], lens[i]); lanes() messages per permutation
+    static void hash_many(const uint8_t* const* inputs, const size_t* lens,
+                          size_t count, HashBytes* out);
+    static size_t lanes();
+};
+
+/**
+ * @brief Incremental Blake2b-256 (init / update / final)
+ * 
+ * Fixed-size state that never allocates, so callers can hash fields in
+ * place instead of concatenating them into a temporary buffer. Supports
+ * the keyed (MAC) and personalised modes of the BLAKE2 spec; the default
+ * mode gives the same digest as Blake2b256::hash.
+ */
+class Blake2bHasher {
+public:
+    using HashBytes = Blake2b256::HashBytes;
+    static constexpr size_t BLOCK_SIZE = 128;
+    static constexpr size_t MAX_KEY_SIZE = 64;
+    static constexpr size_t PERSONAL_SIZE = 16;
+
+    Blake2bHasher();
+    // Keys longer than MAX_KEY_SIZE are truncated; `personal` is 16 bytes or null
+    Blake2bHasher(const uint8_t* key, size_t key_len, const uint8_t* personal = nullptr);
+
+    Blake2bHasher& update(const uint8_t* data, size_t len);
+    Blake2bHasher& update(const std::vector<uint8_t>& data) { return update(data.data(), data.size()); }
+    template <size_t N>
+    Blake2bHasher& update(const std::array<uint8_t, N>& data) { return update(data.data(), N); }
+    Blake2bHasher& update_u64_be(uint64_t v);
+
+    HashBytes final();
+
+private:
+    uint64_t h_[8];
+    uint8_t buf_[BLOCK_SIZE];
+    size_t buf_len_{0};
+    uint64_t t_{0};
+};
+
+/**
+ * @brief Append-only Merkle root builder
+ * 
+ * Keeps one pending subtree root per level (O(log n) memory) so leaves can
+ * be fed as they are produced. root() gives the same result as
+ * Blake2b256::merkle_root over all appended leaves.
+ */
+class MerkleAccumulator {
+public:
+    using HashBytes = Blake2b256::HashBytes;
+    
+    void append(const HashBytes& leaf);
+    HashBytes root() const;
+    
+    size_t size() const { return static_cast<size_t>(count_); }
+    void clear();
+
+private:
+    // frontier_[level] is live while bit `level` of count_ is set
+    std::vector<HashBytes> frontier_;
+    uint64_t count_{0};
+};
+
+/**
+ * @brief Merkle tree with every level kept for repeated proofs
+ * 
+ * All levels live back to back in one flat array, leaves first. An odd
+ * level carries a copy of its last node, so the children of node i are
+ * always 2i and 2i+1. Large levels are hashed across the shared thread
+ * pool. The root matches Blake2b256::merkle_root. Proofs are O(log n)
+ * reads and check with Blake2b256::verify_merkle_proof.
+ */
+class MerkleTree {
+public:
+    using HashBytes = Blake2b256::HashBytes;
+    
+    // Levels with at least this many pairs are split across threads
+    static constexpr size_t PARALLEL_MIN_PAIRS = 4096;
+    
+    MerkleTree() = default;
+    explicit MerkleTree(std::vector<HashBytes> leaves);
+    
+    HashBytes root() const;
+    size_t leaf_count() const { return leaf_count_; }
+    bool empty() const { return leaf_count_ == 0; }
+    
+    // Sibling path for a leaf, bottom-up (empty for a single-leaf tree)
+    std::vector<HashBytes> proof(size_t index) const;
+    
+    // Level 0 holds the leaves; sizes exclude the odd-level padding node
+    size_t levels() const { return level_sizes_.size(); }
+    size_t level_size(size_t level) const { return level_sizes_[level]; }
+    const HashBytes& node(size_t level, size_t index) const {
+        return nodes_[level_offsets_[level] + index];
+    }
+
+private:
+    std::vector<HashBytes> nodes_;
+    std::vector<size_t> level_offsets_;
+    std::vector<size_t> level_sizes_;
+    size_t leaf_count_{0};
+};
+
+/**
+ * @brief Ed25519 signature scheme (RFC 8032)
  * 
  * Used for:
  * - Transaction signing (Cardano compatible)
  * - Block producer attestations
  * - Bridge message signing
+ * 
+ * Verification is cofactored, so verify() and verify_batch() accept
+ * exactly the same signatures.
  */
 class Ed25519 {
 public:
@@ -65,6 +219,90 @@ public:
     static KeyPair keypair_from_seed(const Seed& seed);
     static Signature sign(const uint8_t* message, size_t len, const SecretKey& sk);
     static bool verify(const uint8_t* message, size_t len, const Signature& sig, const PublicKey& pk);
+    
+    // One signature of a batch; the pointed-to data must outlive the call
+    struct BatchEntry {
+        const uint8_t* message;
+        size_t len;
+        const Signature* signature;
+        const PublicKey* public_key;
+    };
+    
+    // True iff every entry verifies. Checks one random linear combination
+    // with a multi-scalar multiplication; on false, use verify() per entry
+    // to find the bad ones.
+    static bool verify_batch(const std::vector<BatchEntry>& entries);
+};
+
+/**
+ * @brief Hash functor for containers keyed by a digest
+ * 
+ * A digest is already uniformly distributed, so its first word serves as
+ * the bucket hash.
+ */
+struct DigestHash {
+    size_t operator()(const Blake2b256::HashBytes& key) const {
+        size_t h;
+        std::memcpy(&h, key.data(), sizeof h);
+        return h;
+    }
+};
+
+/**
+ * @brief Bounded cache of signatures that already verified
+ * 
+ * Entries are keyed by H(message || public key || signature), so a hit
+ * means this exact triple was checked before. A transaction hash alone
+ * would not do, since it does not cover the signature. The cache is
+ * split into shards with their own lock, and each shard evicts its
+ * oldest entries first.
+ */
+class SignatureCache {
+public:
+    using Key = Blake2b256::HashBytes;
+    
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 16;
+    static constexpr size_t SHARDS = 16;
+    
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        size_t size{0};
+        
+        double hit_rate() const {
+            uint64_t total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+    
+    explicit SignatureCache(size_t capacity = DEFAULT_CAPACITY);
+    
+    static Key key(const uint8_t* message, size_t len,
+                   const Ed25519::Signature& sig, const Ed25519::PublicKey& pk);
+    
+    // Lookups count towards the hit rate
+    bool contains(const Key& key) const;
+    void insert(const Key& key);
+    void clear();
+    
+    Stats stats() const;
+    
+    // Process-wide cache shared by mempool admission and block validation
+    static SignatureCache& instance();
+
+private:
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_set<Key, DigestHash> entries;
+        std::deque<Key> order;  // insertion order, oldest first
+    };
+    
+    Shard& shard_for(const Key& key) const { return shards_[key[31] % SHARDS]; }
+    
+    size_t shard_capacity_;
+    mutable std::array<Shard, SHARDS> shards_;
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
 };
 
 /**
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <functional>
 #include <set>
+#include <shared_mutex>
 #include <unordered_map>
 #include "nonagon/types.hpp"
 #include "nonagon/storage.hpp"
-
-// 256-bit unsigned integer for EVM stack (4 x 64-bit words)
-using uint256 = std::array<uint64_t, 4>;
+#include "nonagon/thread_pool.hpp"
+#include "nonagon/uint256.hpp"
 
 namespace nonagon {
 namespace execution {
@@ -95,6 +99,242 @@ public:
     virtual uint64_t gas_cost(const Bytes& input) const = 0;
 };
 
+/**
+ * @brief Bytecode pre-analysis shared by every execution of the same code
+ * 
+ * The code is split into basic blocks: a block starts at offset 0, at
+ * every JUMPDEST and after every instruction that leaves it (jumps,
+ * halts, and GAS/CALL/CREATE, which observe the gas counter). Each block
+ * carries the static gas of its instructions and the stack height it
+ * needs and may reach, so the interpreter charges gas and checks the
+ * stack once on block entry instead of per instruction.
+ * 
+ * Jump targets are validated against a bitmap of JUMPDEST offsets that
+ * excludes bytes inside PUSH data, so a jump costs one bit test.
+ * 
+ * The stored code is zero-padded past the end: PUSH immediates never
+ * read out of bounds, and running off the end executes STOP.
+ */
+class CodeAnalysis {
+public:
+    struct Block {
+        uint64_t gas{0};            // Sum of static gas
+        uint32_t stack_req{0};      // Items required on entry
+        uint32_t stack_growth{0};   // Highest point above the entry height
+    };
+    
+    // One PUSH32 immediate plus a trailing STOP
+    static constexpr size_t PADDING = 33;
+    
+    static std::shared_ptr<const CodeAnalysis> analyze(const Bytes& code);
+    
+    const uint8_t* data() const { return code_.data(); }
+    size_t size() const { return size_; }
+    
+    // Only meaningful at a block start
+    const Block& block(size_t pc) const { return blocks_[block_at_[pc]]; }
+    size_t block_count() const { return blocks_.size(); }
+    
+    // True if `dest` is a JUMPDEST instruction, not a byte of PUSH data
+    bool valid_jump(const uint256& dest) const {
+        if (!dest.fits_u64() || dest[3] >= size_) return false;
+        return (jumpdests_[dest[3] / 64] >> (dest[3] % 64)) & 1;
+    }
+
+private:
+    Bytes code_;
+    size_t size_{0};
+    std::vector<Block> blocks_;
+    std::vector<uint32_t> block_at_;  // Block index by code offset
+    std::vector<uint64_t> jumpdests_; // One bit per code offset
+};
+
+/**
+ * @brief Bounded cache of code analyses keyed by code hash
+ * 
+ * A contract is analysed the first time it runs; later calls reuse the
+ * analysis, and the code it holds, without reading the code from state
+ * again. The oldest entry is evicted first.
+ */
+class CodeCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+    
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        size_t size{0};
+        
+        double hit_rate() const {
+            uint64_t total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+    
+    explicit CodeCache(size_t capacity = DEFAULT_CAPACITY);
+    
+    // Lookups count towards the hit rate
+    std::shared_ptr<const CodeAnalysis> find(const Hash256& code_hash) const;
+    void insert(const Hash256& code_hash, std::shared_ptr<const CodeAnalysis> analysis);
+    void clear();
+    
+    Stats stats() const;
+    
+    // Process-wide cache shared by every EVM instance
+    static CodeCache& instance();
+
+private:
+    size_t capacity_;
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Hash256, std::shared_ptr<const CodeAnalysis>, crypto::DigestHash> entries_;
+    std::deque<Hash256> order_;  // insertion order, oldest first
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+};
+
+/**
+ * @brief Fixed-capacity EVM operand stack
+ * 
+ * 1024 32-byte slots stored inline, so a frame's stack needs no
+ * allocation. Bounds are not checked here: the interpreter validates the
+ * stack height once per basic block. The interface is the subset of
+ * std::vector the opcode handlers use.
+ */
+class EvmStack {
+public:
+    static constexpr size_t CAPACITY = 1024;
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear() { size_ = 0; }
+    
+    uint256& back() { return slots_[size_ - 1]; }
+    void pop_back() { --size_; }
+    void push_back(const uint256& value) { slots_[size_++] = value; }
+    
+    uint256& operator[](size_t i) { return slots_[i]; }
+
+private:
+    alignas(32) uint256 slots_[CAPACITY];
+    size_t size_{0};
+};
+
+/**
+ * @brief Byte-addressed EVM memory with quadratic expansion gas
+ *
+ * The active size is always a whole number of 32-byte words and only
+ * grows through expand(), which charges the expansion fee first. The
+ * buffer behind it grows geometrically in whole pages and survives
+ * clear(), so a pooled frame reuses it; only newly exposed bytes are
+ * zeroed.
+ */
+class EvmMemory {
+public:
+    static constexpr size_t PAGE_SIZE = 4096;
+    // Past 4 GiB the fee alone is over 3.5e13 gas, so larger ranges are
+    // out of gas without pricing them (and words^2 cannot overflow)
+    static constexpr uint64_t MAX_SIZE = uint64_t(1) << 32;
+
+    static constexpr uint64_t words(uint64_t len) { return len / 32 + (len % 32 != 0); }
+
+    // Total fee for a memory of `n` words: 3 gas per word plus n^2 / 512
+    static constexpr uint64_t cost(uint64_t n) { return GasCosts::MEMORY * n + n * n / 512; }
+
+    /**
+     * @brief Make [offset, offset + len) addressable, paying from `gas`
+     *
+     * A zero length touches nothing, at any offset. Returns false, with
+     * memory and gas unchanged, if the range ends past MAX_SIZE or the
+     * fee exceeds `gas`.
+     */
+    bool expand(uint64_t offset, uint64_t len, uint64_t& gas) {
+        if (len == 0) return true;
+        if (len > MAX_SIZE || offset > MAX_SIZE - len) return false;
+        if (offset + len <= size_) return true;
+
+        const uint64_t new_words = words(offset + len);
+        const uint64_t fee = cost(new_words) - cost(size_ / 32);
+        if (fee > gas) return false;
+        gas -= fee;
+        resize(new_words * 32);
+        return true;
+    }
+
+    /**
+     * @brief Copy src[src_offset, src_offset + len) to `offset`
+     *
+     * Bytes past the end of `src` read as zero. The destination must
+     * already be expanded.
+     */
+    void copy_in(uint64_t offset, const uint8_t* src, size_t src_size,
+                 const uint256& src_offset, uint64_t len) {
+        if (len == 0) return;
+        uint8_t* dest = data_.get() + offset;
+        size_t avail = 0;
+        if (src_offset.fits_u64() && src_offset[3] < src_size) {
+            avail = std::min<uint64_t>(len, src_size - src_offset[3]);
+            std::memcpy(dest, src + src_offset[3], avail);
+        }
+        std::memset(dest + avail, 0, len - avail);
+    }
+
+    uint8_t* data() { return data_.get(); }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+
+    // Empties memory but keeps the buffer for the next frame
+    void clear() { size_ = 0; }
+
+    // Empties memory and frees the buffer
+    void reset() {
+        data_.reset();
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+private:
+    void resize(size_t new_size) {
+        if (new_size > capacity_) grow(new_size);
+        std::memset(data_.get() + size_, 0, new_size - size_);
+        size_ = new_size;
+    }
+
+    void grow(size_t min_capacity);
+
+    std::unique_ptr<uint8_t[]> data_;
+    size_t size_{0};
+    size_t capacity_{0};
+};
+
+/**
+ * @brief Direct-mapped cache of short KECCAK256 inputs
+ *
+ * Solidity finds a mapping entry at keccak256(key . slot) and an array at
+ * keccak256(slot), and a transaction usually hashes the same few of them
+ * again and again (a balance is read, then written). Inputs of up to 64
+ * bytes are remembered, one per slot; a colliding input replaces the old
+ * one. The digest is a pure function of the input, so entries never go
+ * stale and may be kept from one transaction to the next.
+ */
+class KeccakCache {
+public:
+    static constexpr size_t ENTRIES = 64;
+    static constexpr size_t MAX_CACHED_SIZE = 64;
+    using HashBytes = crypto::Keccak256::HashBytes;
+
+    HashBytes hash(const uint8_t* data, size_t len);
+
+private:
+    struct Entry {
+        bool used{false};
+        uint8_t len{0};
+        std::array<uint8_t, MAX_CACHED_SIZE> input{};
+        HashBytes digest{};
+    };
+
+    std::array<Entry, ENTRIES> entries_{};
+};
+
 /**
  * @brief EVM Virtual Machine
  * 
@@ -103,7 +343,7 @@ public:
  */
 class EVM {
 public:
-    explicit EVM(std::shared_ptr<storage::StateManager> state);
+    explicit EVM(std::shared_ptr<storage::StateView> state);
     
     // Execute a transaction
     ExecutionResult execute_transaction(const Transaction& tx, const ExecutionContext& ctx);
@@ -127,27 +367,38 @@ public:
     uint64_t chain_id() const { return chain_id_; }
 
 private:
-    std::shared_ptr<storage::StateManager> state_;
+    std::shared_ptr<storage::StateView> state_;
     std::unordered_map<std::string, std::shared_ptr<Precompile>> precompiles_;
     uint64_t chain_id_{1};  // Default mainnet
+    KeccakCache keccak_cache_;
     
-    // Internal execution
+    // Analysed code of an account, through the code cache
+    std::shared_ptr<const CodeAnalysis> load_code(const Address& addr);
+    
+    // Value transfer to an account without code: each account involved is
+    // read and written once, with the same effects as the general path
+    ExecutionResult execute_transfer(const Transaction& tx, const ExecutionContext& ctx,
+                                     AccountState recipient);
+    
+    // Internal execution; `depth` counts the CALL/CREATE frames above this one
     ExecutionResult execute_code(const Address& caller, const Address& address,
-                                  const Bytes& code, const Bytes& input,
+                                  const CodeAnalysis& code, const Bytes& input,
                                   uint64_t value, uint64_t gas_limit,
-                                  bool is_static);
+                                  bool is_static, size_t depth = 0);
     
     // Memory and stack management
     struct ExecutionState {
-        std::vector<uint8_t> memory;
-        std::vector<uint256> stack;  // 256-bit words (4 x uint64)
-        uint64_t gas_remaining;
-        size_t pc;  // Program counter
+        EvmMemory memory;
+        EvmStack stack;
         bool stopped;
         bool reverted;
         Bytes return_data;
     };
     
+    // Per-thread pool of execution frames, reused across calls and
+    // transactions; a frame keeps its memory buffer
+    class FramePool;
+    
     // Access list for EIP-2929
     struct AccessList {
         std::set<std::string> addresses;
@@ -166,7 +417,7 @@ private:
  */
 class TransactionProcessor {
 public:
-    TransactionProcessor(std::shared_ptr<storage::StateManager> state,
+    TransactionProcessor(std::shared_ptr<storage::StateView> state,
                          std::shared_ptr<EVM> evm);
     
     // Process a single transaction
@@ -189,12 +440,75 @@ public:
     uint64_t estimate_gas(const Transaction& tx, const ExecutionContext& ctx);
     
 private:
-    std::shared_ptr<storage::StateManager> state_;
+    std::shared_ptr<storage::StateView> state_;
     std::shared_ptr<EVM> evm_;
     
     uint64_t intrinsic_gas(const Transaction& tx) const;
 };
 
+/**
+ * @brief Parallel block executor (Block-STM)
+ * 
+ * Runs a block's transactions optimistically on a worker pool. Every
+ * execution sees the state through a multi-version store: reads resolve
+ * to the latest write by a lower transaction and are recorded with its
+ * version. Once a transaction has executed it is validated by re-reading
+ * that set; if a lower transaction has since written something it read,
+ * its writes become estimates and it runs again. A read that hits an
+ * estimate stops the reader until the writer has re-executed. Fees are
+ * summed per block rather than written to the coinbase by every
+ * transaction. Receipts, gas and the final state are those of executing
+ * the block in order.
+ */
+class ParallelExecutor {
+public:
+    explicit ParallelExecutor(std::shared_ptr<storage::StateManager> state,
+                              size_t threads = ThreadPool::default_threads());
+    ~ParallelExecutor();
+    
+    ParallelExecutor(const ParallelExecutor&) = delete;
+    ParallelExecutor& operator=(const ParallelExecutor&) = delete;
+    
+    // Checked against a transaction's view of the state before it runs;
+    // a rejected transaction makes no changes
+    using Admission = std::function<bool(const storage::StateView&, const Transaction&)>;
+    
+    /**
+     * @brief Execute `txs` as one block and apply the result to the state
+     * 
+     * `ctx` carries the block fields; caller, origin and gas price are set
+     * per transaction. The state is left uncommitted. Entry i is empty if
+     * `admit` rejected txs[i].
+     */
+    std::vector<std::optional<TransactionProcessor::ProcessResult>> execute(
+        const std::vector<TransactionPtr>& txs, const ExecutionContext& ctx,
+        const Admission& admit = nullptr);
+    
+    // Counters for the last execute()
+    struct Stats {
+        uint64_t executions{0};   // Including ones later aborted
+        uint64_t validations{0};
+        uint64_t aborts{0};       // Failed validations
+        uint64_t suspensions{0};  // Executions stopped on an estimate
+    };
+    Stats last_stats() const { return stats_; }
+    
+    size_t threads() const { return pool_.size(); }
+
+private:
+    std::shared_ptr<storage::StateManager> state_;
+    ThreadPool pool_;
+    Stats stats_;
+    
+    class MultiVersionStore;
+    class Scheduler;
+    class IncarnationView;
+    
+    // EVM and processor bound to one worker's view, reused across blocks
+    struct Worker;
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
 /**
  * @brief Block processor
  * 
@@ -216,6 +530,12 @@ public:
     };
     BlockResult process_block(const Block& block);
     
+    // Run transactions on a parallel executor over the same state rather
+    // than one after another through tx_processor_
+    void set_parallel_executor(std::shared_ptr<ParallelExecutor> executor) {
+        parallel_executor_ = std::move(executor);
+    }
+    
     // Validate block before processing
     bool validate_block(const Block& block) const;
     
@@ -226,6 +546,7 @@ public:
 private:
     std::shared_ptr<storage::StateManager> state_;
     std::shared_ptr<TransactionProcessor> tx_processor_;
+    std::shared_ptr<ParallelExecutor> parallel_executor_;
     
     static constexpr uint64_t TARGET_GAS_USED = 15000000;  // 50% of 30M limit
     static constexpr uint64_t BASE_FEE_CHANGE_DENOMINATOR = 8;
@@ -277,6 +277,15 @@ public:
     };
     SyncStatus status() const;
     
+    // Validates an encoded block (parent link, transactions root,
+    // signatures) through a BlockView and stores the bytes as received.
+    // Returns false for malformed, unlinked or already-known blocks.
+    // The block becomes the head without being executed, and neither its
+    // state root nor its proposer is checked, so it is not wired to
+    // network messages: callers must have executed the block against
+    // local state first.
+    bool import_block(const Bytes& encoded);
+    
     // Callbacks
     using ProgressCallback = std::function<void(uint64_t current, uint64_t target)>;
     using CompleteCallback = std::function<void()>;
@@ -42,6 +42,10 @@ struct NodeConfig {
     std::string sequencer_key_file;
     Address sequencer_address;
     
+    // Worker threads for parallel block execution, which runs every
+    // transaction through the EVM; 0 or 1 executes them one after another
+    size_t execution_threads{0};
+    
     // Logging
     enum class LogLevel {
         Trace,
@@ -118,6 +122,10 @@ public:
     static constexpr const char* BATCH_SUBMITTED = "nonagon_batches_submitted_total";
     static constexpr const char* BLOCK_TIME_MS = "nonagon_block_time_ms";
     static constexpr const char* GAS_USED = "nonagon_gas_used_total";
+    static constexpr const char* SIG_CACHE_HITS = "nonagon_sig_cache_hits_total";
+    static constexpr const char* SIG_CACHE_MISSES = "nonagon_sig_cache_misses_total";
+    static constexpr const char* SIG_CACHE_HIT_RATE = "nonagon_sig_cache_hit_rate";
+    static constexpr const char* SIG_CACHE_SIZE = "nonagon_sig_cache_entries";
 
 private:
     Metrics() = default;
@@ -155,7 +163,7 @@ public:
     Block latest_block() const;
     
     // Transaction submission
-    Hash256 submit_transaction(const Transaction& tx);
+    Hash256 submit_transaction(TransactionPtr tx);
     
     // Sequencer operations (if enabled)
     bool is_sequencer() const { return config_.is_sequencer; }
@@ -196,6 +204,7 @@ private:
     std::shared_ptr<execution::EVM> evm_;
     std::shared_ptr<execution::TransactionProcessor> tx_processor_;
     std::shared_ptr<execution::BlockProcessor> block_processor_;
+    std::shared_ptr<execution::ParallelExecutor> parallel_executor_;
     
     // Consensus layer
     std::shared_ptr<consensus::ConsensusEngine> consensus_;
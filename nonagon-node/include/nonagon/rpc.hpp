@@ -195,6 +195,7 @@ public:
     Response get_transaction_count(const Request& req);
     Response get_code(const Request& req);
     Response get_storage_at(const Request& req);
+    Response get_proof(const Request& req);  // Batched: all addresses share one multiproof
     
     // Block queries
     Response get_block_by_number(const Request& req);
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <map>
 #include <functional>
 #include <future>
 #include <mutex>
@@ -200,14 +201,25 @@ public:
     // Accessors
     uint64_t current_batch_id() const { return next_batch_id_; }
     const std::vector<Block>& get_pending_blocks() const { return pending_blocks_; }
+    
+    // Inclusion proof of a block hash under a built batch's transactions_root
+    std::vector<Hash256> block_proof(uint64_t batch_id, uint64_t block_number) const;
 
 private:
+    // Block-hash trees of recent batches, kept for withdrawal proofs
+    static constexpr size_t MAX_BATCH_TREES = 64;
+    struct BatchTree {
+        uint64_t start_block{0};
+        crypto::MerkleTree tree;
+    };
+    
     Config config_;
     mutable std::mutex mutex_;
     
     std::vector<Block> pending_blocks_;
     uint64_t batch_start_time_{0};
     uint64_t next_batch_id_{1};
+    std::map<uint64_t, BatchTree> batch_trees_;
 };
 
 /**
@@ -4,6 +4,7 @@
 #include <optional>
 #include <unordered_map>
 #include <map>
+#include <array>
 #include <mutex>
 #include <shared_mutex>
 #include <fstream>
@@ -88,6 +89,91 @@ private:
     std::ofstream file_;
 };
 
+/**
+ * @brief Fixed-size state trie key
+ * 
+ * DB prefix byte followed by the Blake2b-256 hash of the logical key.
+ * Lives on the stack so trie lookups never allocate to build a path.
+ */
+struct StateKey {
+    static constexpr uint8_t PREFIX = 0x01;
+    static constexpr size_t SIZE = 1 + crypto::Blake2b256::HASH_SIZE;
+    
+    std::array<uint8_t, SIZE> bytes{};
+    
+    static StateKey from_key(const uint8_t* key, size_t len);
+    static StateKey from_key(const Bytes& key) { return from_key(key.data(), key.size()); }
+    
+    // Key hash (trie path) without the DB prefix
+    const uint8_t* path() const { return bytes.data() + 1; }
+    Bytes to_db_key() const { return Bytes(bytes.begin(), bytes.end()); }
+    
+    // Path bytes are already uniform, so the first word is a good table hash
+    uint64_t slot_hash() const;
+    
+    bool operator==(const StateKey& other) const = default;
+};
+
+/**
+ * @brief Flat open-addressing table of uncommitted trie writes
+ * 
+ * Linear probing over a power-of-two slot array. Entries are never removed
+ * individually (a delete is an empty value), and clear() keeps the slot
+ * storage so the next block reuses it.
+ */
+class DirtyNodeTable {
+public:
+    Bytes& operator[](const StateKey& key);
+    const Bytes* find(const StateKey& key) const;
+    void clear();
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& slot : slots_) {
+            if (slot.used) fn(slot.key, slot.value);
+        }
+    }
+
+private:
+    struct Slot {
+        StateKey key;
+        Bytes value;
+        bool used{false};
+    };
+    std::vector<Slot> slots_;
+    size_t size_{0};
+    
+    static constexpr size_t INITIAL_CAPACITY = 64;
+    void grow();
+};
+
+/**
+ * @brief Proof for several keys against one committed state root
+ * 
+ * Leaves are H(path || value) in the tree built by the last commit.
+ * `nodes` holds only the sibling hashes a verifier cannot recompute from
+ * the proven leaves, bottom-up and left-to-right, so path segments shared
+ * between keys appear once.
+ */
+struct StateMultiProof {
+    struct Leaf {
+        uint64_t index{0};
+        Hash256 path{};
+        Bytes value;
+    };
+    
+    Hash256 root{};
+    uint64_t leaf_count{0};
+    std::vector<Leaf> leaves;     // Sorted by index
+    std::vector<Hash256> nodes;
+    
+    Bytes encode() const;
+    static std::optional<StateMultiProof> decode(const Bytes& data);
+};
+
 /**
  * @brief Merkle Patricia Trie for state storage
  * 
@@ -107,6 +193,11 @@ public:
     std::optional<Bytes> get(const Bytes& key) const;
     void del(const Bytes& key);
     
+    // Pre-hashed key variants (no per-access hashing or allocation)
+    void put(const StateKey& key, const Bytes& value);
+    std::optional<Bytes> get(const StateKey& key) const;
+    void del(const StateKey& key);
+    
     // Commit changes and get new root
     Hash256 commit();
     Hash256 root() const { return root_; }
@@ -115,11 +206,22 @@ public:
     std::vector<Bytes> get_proof(const Bytes& key) const;
     static bool verify_proof(const Hash256& root, const Bytes& key, 
                              const Bytes& value, const std::vector<Bytes>& proof);
+    
+    // Batched proofs: one traversal, shared nodes emitted once.
+    // Returns nullopt if any key is not a leaf of the current root.
+    std::optional<StateMultiProof> get_multiproof(const std::vector<StateKey>& keys) const;
+    std::optional<StateMultiProof> get_multiproof(const std::vector<Bytes>& keys) const;
+    static bool verify_multiproof(const Hash256& root, const StateMultiProof& proof);
 
 private:
     std::shared_ptr<Database> db_;
     Hash256 root_;
-    std::unordered_map<std::string, Bytes> dirty_nodes_;
+    DirtyNodeTable dirty_nodes_;
+    
+    // Tree of the last commit: leaf paths (sorted) and every level, leaves first
+    mutable std::shared_mutex committed_mutex_;
+    std::vector<Hash256> committed_paths_;
+    crypto::MerkleTree committed_tree_;
 };
 
 /**
@@ -134,6 +236,10 @@ public:
     std::optional<Block> get_block(uint64_t number) const;
     std::optional<Block> get_block_by_hash(const Hash256& hash) const;
     
+    // Encoded form, for BlockView readers and imports that skip decoding
+    bool store_encoded_block(uint64_t number, const Hash256& hash, const Bytes& encoded);
+    std::optional<Bytes> get_block_bytes(uint64_t number) const;
+    
     // Chain head management
     void set_head(uint64_t number);
     uint64_t get_head() const;
@@ -153,18 +259,21 @@ private:
 };
 
 /**
- * @brief State manager for account states
+ * @brief Account, storage and code access used by transaction execution
+ * 
+ * StateManager is the persistent implementation. The parallel block
+ * executor runs each transaction against its own view of a multi-version
+ * store, so the EVM and TransactionProcessor only see this interface.
  */
-class StateManager {
+class StateView {
 public:
-    explicit StateManager(std::shared_ptr<Database> db);
-    StateManager(std::shared_ptr<Database> db, const Hash256& state_root);
+    virtual ~StateView() = default;
     
     // Account state operations
-    AccountState get_account(const Address& addr) const;
-    void set_account(const Address& addr, const AccountState& state);
+    virtual AccountState get_account(const Address& addr) const = 0;
+    virtual void set_account(const Address& addr, const AccountState& state) = 0;
     
-    // Convenience methods
+    // Convenience methods, on top of get_account/set_account
     uint64_t get_balance(const Address& addr) const;
     void add_balance(const Address& addr, uint64_t amount);
     void sub_balance(const Address& addr, uint64_t amount);
@@ -172,36 +281,119 @@ public:
     uint64_t get_nonce(const Address& addr) const;
     void increment_nonce(const Address& addr);
     
+    // Pay a transaction's fee to the block producer. Views may hold fees
+    // back and credit the coinbase once per block; reads of the coinbase
+    // include them either way.
+    virtual void credit_fee(const Address& coinbase, uint64_t amount);
+    
     // Contract storage
-    Bytes get_storage(const Address& addr, const Hash256& key) const;
-    void set_storage(const Address& addr, const Hash256& key, const Bytes& value);
+    virtual Bytes get_storage(const Address& addr, const Hash256& key) const = 0;
+    virtual void set_storage(const Address& addr, const Hash256& key, const Bytes& value) = 0;
     
     // Contract code
-    Bytes get_code(const Address& addr) const;
-    void set_code(const Address& addr, const Bytes& code);
+    virtual Bytes get_code(const Address& addr) const = 0;
+    virtual void set_code(const Address& addr, const Bytes& code) = 0;
     
-    // State root
-    Hash256 commit();
-    Hash256 state_root() const;
-    
-    // Snapshot for revert on failed tx
+    // Snapshot for revert on failed tx. Reverts roll back account writes
+    // made since the snapshot; storage writes are not journaled.
     struct Snapshot {
         Hash256 state_root;
         size_t journal_size;
+        std::optional<uint64_t> pending_fees;  // Fees credited since the coinbase was written
     };
-    Snapshot snapshot() const;
-    void revert(const Snapshot& snap);
+    virtual Snapshot snapshot() const = 0;
+    virtual void revert(const Snapshot& snap) = 0;
+};
+
+/**
+ * @brief State manager for account states
+ */
+class StateManager : public StateView {
+public:
+    explicit StateManager(std::shared_ptr<Database> db);
+    StateManager(std::shared_ptr<Database> db, const Hash256& state_root);
+    
+    // Account state operations
+    AccountState get_account(const Address& addr) const override;
+    void set_account(const Address& addr, const AccountState& state) override;
+    
+    // Contract storage
+    Bytes get_storage(const Address& addr, const Hash256& key) const override;
+    void set_storage(const Address& addr, const Hash256& key, const Bytes& value) override;
+    
+    // Contract code
+    Bytes get_code(const Address& addr) const override;
+    void set_code(const Address& addr, const Bytes& code) override;
+    
+    // Code blobs by hash, without touching any account
+    Bytes get_code_by_hash(const Hash256& code_hash) const;
+    Hash256 put_code(const Bytes& code);
+    
+    /**
+     * Fees for the first coinbase credited since the last settle are
+     * summed in memory rather than written per transaction, so a block
+     * writes its producer's account once. Fees for any other address are
+     * credited directly.
+     */
+    void credit_fee(const Address& coinbase, uint64_t amount) override;
+    
+    // Write pending fees to the coinbase account; commit() does this first
+    void settle_fees();
+    
+    // State root. state_root() and proofs do not see unsettled fees.
+    Hash256 commit();
+    Hash256 state_root() const;
+    
+    // Account proofs against the current state root
+    std::optional<StateMultiProof> get_account_proof(const std::vector<Address>& addrs) const;
+    
+    Snapshot snapshot() const override;
+    void revert(const Snapshot& snap) override;
 
 private:
     std::shared_ptr<Database> db_;
     std::unique_ptr<StateTrie> account_trie_;
     
+    /**
+     * Direct-mapped address -> StateKey memo. Hot accounts (senders,
+     * coinbase, popular contracts) skip the Blake2b key hash entirely.
+     */
+    class AccountKeyMemo {
+    public:
+        AccountKeyMemo();
+        StateKey lookup(const Address& addr);
+    
+    private:
+        struct Entry {
+            std::array<uint8_t, 28> credential{};
+            StateKey key;
+            bool valid{false};
+        };
+        static constexpr size_t CAPACITY = 4096;  // Power of two
+        std::vector<Entry> entries_;
+        std::mutex mutex_;
+    };
+    mutable AccountKeyMemo key_memo_;
+    
+    StateKey account_key(const Address& addr) const { return key_memo_.lookup(addr); }
+    
     // Journal for reverts
     struct JournalEntry {
         Address addr;
         std::optional<AccountState> prev_state;
     };
     std::vector<JournalEntry> journal_;
+    
+    // Fees held back for fee_recipient_, empty if none since it was last
+    // written. A write to that account replaces the balance they were
+    // folded into, so it clears them; a credit of zero still makes settling
+    // write the account, as crediting it directly would.
+    std::optional<Address> fee_recipient_;
+    std::optional<uint64_t> pending_fees_;
+    
+    bool is_fee_recipient(const Address& addr) const {
+        return fee_recipient_ && fee_recipient_->payment_credential == addr.payment_credential;
+    }
 };
 
 } // namespace storage
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nonagon {
+
+/**
+ * @brief Fixed-size worker pool for data-parallel loops
+ *
+ * parallel_for() splits an index range across the workers and the calling
+ * thread and returns once every index has run. Several callers may share
+ * the pool; their jobs are served in FIFO order.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = default_threads()) {
+        // The caller always works too, so spawn one fewer
+        for (size_t i = 1; i < threads; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_) {
+            if (w.joinable()) w.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that run jobs, including the caller
+    size_t size() const { return workers_.size() + 1; }
+
+    void parallel_for(size_t count, const std::function<void(size_t)>& fn) {
+        if (count == 0) return;
+        if (workers_.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) fn(i);
+            return;
+        }
+
+        auto job = std::make_shared<Job>(fn, count);
+        {
+            std::lock_guard lock(mutex_);
+            jobs_.push_back(job);
+        }
+        cv_.notify_all();
+
+        run(*job);
+
+        std::unique_lock lock(job->mutex);
+        job->cv.wait(lock, [&]() { return job->done.load() == job->count; });
+    }
+
+    // Process-wide pool sized to the hardware, created on first use
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    static size_t default_threads() {
+        size_t n = std::thread::hardware_concurrency();
+        return n > 0 ? n : 1;
+    }
+
+private:
+    struct Job {
+        Job(const std::function<void(size_t)>& f, size_t n) : fn(f), count(n) {}
+
+        std::function<void(size_t)> fn;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    static void run(Job& job) {
+        size_t i;
+        while ((i = job.next.fetch_add(1)) < job.count) {
+            job.fn(i);
+            if (job.done.fetch_add(1) + 1 == job.count) {
+                std::lock_guard lock(job.mutex);
+                job.cv.notify_all();
+            }
+        }
+    }
+
+    void worker_loop() {
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+                if (stop_) return;
+
+                job = jobs_.front();
+                if (job->next.load() >= job->count) {
+                    // Fully claimed; stragglers finish on their own threads
+                    jobs_.pop_front();
+                    continue;
+                }
+            }
+            run(*job);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_{false};
+};
+
+} // namespace nonagon
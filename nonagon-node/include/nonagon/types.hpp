@@ -5,7 +5,11 @@
 #include <array>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include "nonagon/crypto.hpp"
 
 namespace nonagon {
@@ -13,6 +17,9 @@ namespace nonagon {
 using Bytes = std::vector<uint8_t>;
 using Hash256 = crypto::Blake2b256::HashBytes;
 
+class ByteWriter;
+class ByteReader;
+
 /**
  * @brief Nonagon Address - Cardano-compatible Bech32 format
  * 
@@ -45,6 +52,34 @@ struct Address {
     std::string to_hex() const;
 };
 
+/**
+ * @brief Binary format of encoded transactions, blocks and receipts
+ * 
+ * V1: fixed-width big-endian integers and inline 28-byte credentials.
+ * V2: LEB128 varints, flags for optional fields and, in blocks, one table
+ *     of distinct addresses referenced by index. A V2 encoding starts with
+ *     ENCODING_V2_MAGIC; a V1 one starts with 0x00 (or 0x01 for a
+ *     successful receipt), so decoders tell them apart from the first byte.
+ * 
+ * Decoders accept both. Encoders write V2 unless asked for V1.
+ */
+enum class Encoding : uint8_t {
+    V1 = 1,
+    V2 = 2
+};
+
+constexpr uint8_t ENCODING_V2_MAGIC = 0xF2;
+
+struct Transaction;
+
+/**
+ * @brief Immutable, shareable transaction
+ * 
+ * Created by Transaction::share(). Its hash and encoding are computed at
+ * most once and reused by the mempool, block assembly and storage.
+ */
+using TransactionPtr = std::shared_ptr<const Transaction>;
+
 /**
  * @brief Transaction structure for Nonagon L2
  * 
@@ -70,12 +105,44 @@ struct Transaction {
 
     // Computed fields
     Hash256 hash() const;
+    void append_hash_preimage(Bytes& out) const;  // Bytes hashed by hash(), for batched hashing
     uint64_t effective_gas_price(uint64_t base_fee) const;
     bool verify_signature() const;
     
-    // Serialization
-    Bytes encode() const;
+    // Serialization. Only the default (V2) encoding is memoized.
+    Bytes encode(Encoding encoding = Encoding::V2) const;
     static std::optional<Transaction> decode(const Bytes& data);
+    size_t encoded_size(Encoding encoding = Encoding::V2) const;
+    void encode_to(ByteWriter& out, Encoding encoding = Encoding::V2) const;
+    
+    // Freezes `tx` so hash() and encode() are computed once and memoized.
+    // Copies taken from a shared transaction start unfrozen.
+    static TransactionPtr share(Transaction tx);
+    bool is_shared() const { return memo_.frozen; }
+
+private:
+    friend struct Block;
+    
+    // Lazily filled once frozen; never copied, so an edited copy can't
+    // return a stale hash
+    struct Memo {
+        Memo() = default;
+        Memo(const Memo&) {}
+        Memo& operator=(const Memo&) { return *this; }
+        
+        bool frozen{false};
+        std::once_flag hash_once;
+        std::atomic<bool> hash_ready{false};
+        Hash256 hash{};
+        std::once_flag encoded_once;
+        std::atomic<bool> encoded_ready{false};
+        Bytes encoded;
+    };
+    mutable Memo memo_;
+    
+    Hash256 compute_hash() const;
+    Bytes compute_encoding(Encoding encoding) const;
+    void memoize_hash(const Hash256& h) const;
 };
 
 /**
@@ -99,8 +166,12 @@ struct BlockHeader {
     // Settlement tracking
     uint64_t batch_id{0};        // Which L1 batch includes this block
     
+    static constexpr size_t V1_ENCODED_SIZE = 212;
+    
     Hash256 hash() const;
-    Bytes encode() const;
+    Bytes encode(Encoding encoding = Encoding::V2) const;
+    size_t encoded_size(Encoding encoding = Encoding::V2) const;
+    void encode_to(ByteWriter& out, Encoding encoding = Encoding::V2) const;
 };
 
 /**
@@ -108,11 +179,137 @@ struct BlockHeader {
  */
 struct Block {
     BlockHeader header;
-    std::vector<Transaction> transactions;
     
-    Hash256 compute_transactions_root() const;
-    Bytes encode() const;
+    const std::vector<TransactionPtr>& transactions() const { return transactions_; }
+    
+    // Transactions only change through these, which fold their hashes into
+    // the root as they go, so it can never go stale
+    void add_transaction(TransactionPtr tx);
+    void add_transaction(const Transaction& tx);
+    void set_transactions(std::vector<TransactionPtr> txs);  // Hashed as one batch
+    void reserve_transactions(size_t count) { transactions_.reserve(count); }
+    
+    // Root of the transactions added so far; nothing is hashed here
+    Hash256 compute_transactions_root() const { return tx_root_acc_.root(); }
+    
+    // Every transaction signature, checked as one Ed25519 batch
+    bool verify_signatures() const;
+    
+    Bytes encode(Encoding encoding = Encoding::V2) const;
     static std::optional<Block> decode(const Bytes& data);
+    size_t encoded_size(Encoding encoding = Encoding::V2) const;
+    void encode_to(ByteWriter& out, Encoding encoding = Encoding::V2) const;
+
+private:
+    std::vector<TransactionPtr> transactions_;
+    crypto::MerkleAccumulator tx_root_acc_;
+};
+
+/**
+ * @brief Read-only transaction over a borrowed encoding
+ * 
+ * parse() walks the encoding once (V1 or V2), decoding the integers and
+ * recording where the byte fields are. Accessors read the buffer in place
+ * and hash() works on demand without materializing `data`. The buffer
+ * must outlive the view.
+ */
+class TransactionView {
+public:
+    static std::optional<TransactionView> parse(const uint8_t* data, size_t len);
+    static std::optional<TransactionView> parse(const Bytes& data) {
+        return parse(data.data(), data.size());
+    }
+    
+    Address from() const;
+    Address to() const;
+    uint64_t value() const { return value_; }
+    uint64_t nonce() const { return nonce_; }
+    uint64_t gas_limit() const { return gas_limit_; }
+    uint64_t max_fee_per_gas() const { return max_fee_per_gas_; }
+    uint64_t max_priority_fee_per_gas() const { return max_priority_fee_per_gas_; }
+    std::span<const uint8_t> data() const { return {data_, data_len_}; }
+    crypto::Ed25519::PublicKey sender_pubkey() const;
+    crypto::Ed25519::Signature signature() const;
+    
+    Hash256 hash() const;
+    void append_hash_preimage(Bytes& out) const;
+    
+    // Full copy, for execution
+    Transaction materialize() const;
+
+private:
+    friend class BlockView;
+    
+    // Credentials are null for the default address
+    const uint8_t* from_{nullptr};
+    const uint8_t* to_{nullptr};
+    uint64_t value_{0};
+    uint64_t nonce_{0};
+    uint64_t gas_limit_{0};
+    uint64_t max_fee_per_gas_{0};
+    uint64_t max_priority_fee_per_gas_{0};
+    const uint8_t* data_{nullptr};
+    size_t data_len_{0};
+    const uint8_t* pubkey_{nullptr};
+    const uint8_t* signature_{nullptr};  // Null when absent (all zero)
+    
+    static std::optional<TransactionView> parse_v1(const uint8_t* data, size_t len);
+    
+    // `table` is the block's address table, or null for inline credentials
+    static std::optional<TransactionView> parse_v2(ByteReader& in, const uint8_t* table,
+                                                   size_t table_count);
+};
+
+/**
+ * @brief Read-only block over a borrowed encoding
+ * 
+ * The header is decoded and transactions are located once at parse();
+ * transactions are exposed as TransactionViews. The buffer must outlive
+ * the view.
+ */
+class BlockView {
+public:
+    static std::optional<BlockView> parse(const uint8_t* data, size_t len);
+    static std::optional<BlockView> parse(const Bytes& data) {
+        return parse(data.data(), data.size());
+    }
+    
+    Encoding encoding() const { return encoding_; }
+    
+    uint64_t number() const { return header_.number; }
+    const Hash256& parent_hash() const { return header_.parent_hash; }
+    const Hash256& state_root() const { return header_.state_root; }
+    const Hash256& transactions_root() const { return header_.transactions_root; }
+    const Hash256& receipts_root() const { return header_.receipts_root; }
+    uint64_t gas_limit() const { return header_.gas_limit; }
+    uint64_t gas_used() const { return header_.gas_used; }
+    uint64_t base_fee() const { return header_.base_fee; }
+    uint64_t timestamp() const { return header_.timestamp; }
+    
+    const BlockHeader& header() const { return header_; }
+    Hash256 header_hash() const { return header_.hash(); }
+    
+    size_t transaction_count() const { return txs_.size(); }
+    const TransactionView& transaction(size_t i) const { return txs_[i]; }
+    const std::vector<TransactionView>& transactions() const { return txs_; }
+    
+    // Same results as the Block methods, without materializing
+    std::vector<Hash256> transaction_hashes() const;  // One batched pass
+    Hash256 compute_transactions_root() const;
+    bool verify_signatures() const;
+    bool verify_signatures(const std::vector<Hash256>& tx_hashes) const;
+    
+    std::span<const uint8_t> encoded() const { return {buf_, len_}; }
+    
+    // Full copy, for execution
+    Block materialize() const;
+
+private:
+    const uint8_t* buf_{nullptr};
+    size_t len_{0};
+    Encoding encoding_{Encoding::V1};
+    BlockHeader header_;
+    std::vector<TransactionView> txs_;
 };
 
 /**
@@ -146,6 +343,11 @@ struct TransactionReceipt {
     std::vector<Log> logs;
 
     Hash256 hash() const;
+    
+    // Storage layout; transaction_hash is the key and is not included
+    size_t encoded_size(Encoding encoding = Encoding::V2) const;
+    Bytes encode(Encoding encoding = Encoding::V2) const;
+    static std::optional<TransactionReceipt> decode(const Hash256& tx_hash, const Bytes& data);
 };
 
 /**
@@ -157,6 +359,8 @@ struct AccountState {
     Hash256 storage_root{};      // Merkle root of contract storage
     Hash256 code_hash{};         // Hash of contract bytecode
     
+    static constexpr size_t ENCODED_SIZE = 80;
+    
     bool is_contract() const;
     Bytes encode() const;
     static AccountState decode(const Bytes& data);
@@ -193,6 +397,7 @@ struct SettlementBatch {
     };
     Status status{Status::Pending};
     
+    size_t encoded_size() const;
     Bytes encode() const;
 };
 
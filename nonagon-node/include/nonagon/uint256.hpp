@@ -0,0 +1,440 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nonagon {
+
+/**
+ * @brief 256-bit unsigned integer for the EVM stack
+ *
+ * Four 64-bit words, most significant first (words[0] is the high word),
+ * which is the layout the interpreter indexes directly. Arithmetic wraps
+ * modulo 2^256 as the EVM requires.
+ *
+ * Carries and products go through unsigned __int128, so compilers emit
+ * add/adc and mul (mulx/adcx when BMI2/ADX are enabled) chains. Division
+ * is Knuth's algorithm D. Each operation has a fast path for operands
+ * that fit in one word, the common case for counters, offsets and token
+ * amounts. Everything is constexpr.
+ */
+struct uint256 {
+    std::array<uint64_t, 4> words{};
+
+    constexpr uint256() = default;
+    constexpr uint256(uint64_t v) : words{0, 0, 0, v} {}
+    constexpr uint256(uint64_t w0, uint64_t w1, uint64_t w2, uint64_t w3) : words{w0, w1, w2, w3} {}
+
+    constexpr uint64_t& operator[](size_t i) { return words[i]; }
+    constexpr const uint64_t& operator[](size_t i) const { return words[i]; }
+
+    constexpr bool is_zero() const { return (words[0] | words[1] | words[2] | words[3]) == 0; }
+    constexpr bool fits_u64() const { return (words[0] | words[1] | words[2]) == 0; }
+    constexpr uint64_t low64() const { return words[3]; }
+
+    // Big-endian bytes, right-aligned: a short input is the low bytes
+    static constexpr uint256 from_bytes(const uint8_t* data, size_t len) {
+        uint256 r;
+        if (len > 32) {
+            data += len - 32;
+            len = 32;
+        }
+        for (size_t i = 0; i < len; ++i) {
+            size_t pos = 32 - len + i;
+            r.words[pos / 8] |= uint64_t(data[i]) << (56 - (pos % 8) * 8);
+        }
+        return r;
+    }
+
+    constexpr void to_bytes(uint8_t* out) const {
+        for (size_t i = 0; i < 32; ++i) {
+            out[i] = static_cast<uint8_t>(words[i / 8] >> (56 - (i % 8) * 8));
+        }
+    }
+
+    // Bytes needed without leading zeros (EXP gas)
+    constexpr size_t byte_length() const {
+        for (size_t i = 0; i < 4; ++i) {
+            if (words[i]) return (4 - i) * 8 - std::countl_zero(words[i]) / 8;
+        }
+        return 0;
+    }
+
+    // Word order matches significance, so comparison is lexicographic
+    friend constexpr bool operator==(const uint256&, const uint256&) = default;
+    friend constexpr auto operator<=>(const uint256& a, const uint256& b) { return a.words <=> b.words; }
+};
+
+namespace u256_detail {
+
+__extension__ using u128 = unsigned __int128;
+
+// Little-endian limb order for the multi-word algorithms
+template <size_t N>
+using Limbs = std::array<uint64_t, N>;
+
+constexpr Limbs<4> to_limbs(const uint256& x) { return {x[3], x[2], x[1], x[0]}; }
+constexpr uint256 from_limbs(const uint64_t* l) { return {l[3], l[2], l[1], l[0]}; }
+
+// (hi:lo) / d for hi < d, via the hardware 128/64 divide at run time
+constexpr uint64_t div_128_64(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem) {
+#if defined(__x86_64__) && defined(__GNUC__)
+    if (!std::is_constant_evaluated()) {
+        uint64_t q, r;
+        __asm__("divq %4" : "=a"(q), "=d"(r) : "a"(lo), "d"(hi), "rm"(d));
+        rem = r;
+        return q;
+    }
+#endif
+    u128 n = (u128(hi) << 64) | lo;
+    rem = static_cast<uint64_t>(n % d);
+    return static_cast<uint64_t>(n / d);
+}
+
+template <size_t N>
+constexpr size_t significant_limbs(const Limbs<N>& x) {
+    size_t n = N;
+    while (n > 0 && x[n - 1] == 0) --n;
+    return n;
+}
+
+// Knuth, TAOCP vol. 2, 4.3.1, algorithm D. `v` must be non-zero.
+// Quotient has M limbs, remainder 4.
+template <size_t M>
+constexpr void divrem(const Limbs<M>& u, const Limbs<4>& v, Limbs<M>& q, Limbs<4>& r) {
+    q = {};
+    r = {};
+    const size_t n = significant_limbs(v);
+    const size_t m = significant_limbs(u);
+    if (m < n) {
+        for (size_t i = 0; i < m; ++i) r[i] = u[i];
+        return;
+    }
+
+    // Single-word divisor: one hardware divide per limb
+    if (n == 1) {
+        uint64_t rem = 0;
+        for (size_t i = m; i-- > 0;) {
+            q[i] = div_128_64(rem, u[i], v[0], rem);
+        }
+        r[0] = rem;
+        return;
+    }
+
+    // Normalize so the divisor's top bit is set; keeps q-hat within 2 of q
+    const int s = std::countl_zero(v[n - 1]);
+    Limbs<4> vn{};
+    Limbs<M + 1> un{};
+    for (size_t i = n - 1; i > 0; --i) {
+        vn[i] = s ? (v[i] << s) | (v[i - 1] >> (64 - s)) : v[i];
+    }
+    vn[0] = v[0] << s;
+    un[m] = s ? u[m - 1] >> (64 - s) : 0;
+    for (size_t i = m - 1; i > 0; --i) {
+        un[i] = s ? (u[i] << s) | (u[i - 1] >> (64 - s)) : u[i];
+    }
+    un[0] = u[0] << s;
+
+    for (size_t j = m - n + 1; j-- > 0;) {
+        // Estimate the quotient digit from the top two limbs
+        u128 qhat, rhat;
+        if (un[j + n] >= vn[n - 1]) {
+            u128 num = (u128(un[j + n]) << 64) | un[j + n - 1];
+            qhat = num / vn[n - 1];
+            rhat = num % vn[n - 1];
+        } else {
+            uint64_t rem = 0;
+            qhat = div_128_64(un[j + n], un[j + n - 1], vn[n - 1], rem);
+            rhat = rem;
+        }
+        while ((qhat >> 64) != 0 ||
+               qhat * vn[n - 2] > ((rhat << 64) | un[j + n - 2])) {
+            --qhat;
+            rhat += vn[n - 1];
+            if ((rhat >> 64) != 0) break;
+        }
+
+        // Multiply and subtract
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            u128 p = qhat * vn[i];
+            u128 t = u128(un[i + j]) - borrow - static_cast<uint64_t>(p);
+            un[i + j] = static_cast<uint64_t>(t);
+            borrow = static_cast<uint64_t>(p >> 64) - static_cast<uint64_t>(t >> 64);
+        }
+        u128 t = u128(un[j + n]) - borrow;
+        un[j + n] = static_cast<uint64_t>(t);
+
+        q[j] = static_cast<uint64_t>(qhat);
+        if ((t >> 64) != 0) {
+            // Estimate was one too large; add the divisor back
+            --q[j];
+            u128 carry = 0;
+            for (size_t i = 0; i < n; ++i) {
+                u128 sum = u128(un[i + j]) + vn[i] + carry;
+                un[i + j] = static_cast<uint64_t>(sum);
+                carry = sum >> 64;
+            }
+            un[j + n] += static_cast<uint64_t>(carry);
+        }
+    }
+
+    // Denormalize the remainder
+    for (size_t i = 0; i < n; ++i) {
+        r[i] = s ? (un[i] >> s) | (un[i + 1] << (64 - s)) : un[i];
+    }
+}
+
+} // namespace u256_detail
+
+// ============================================================================
+// Arithmetic (wrapping modulo 2^256)
+// ============================================================================
+
+constexpr uint256 operator+(const uint256& a, const uint256& b) {
+    using u256_detail::u128;
+    uint256 r;
+    u128 carry = 0;
+    for (int i = 3; i >= 0; --i) {
+        u128 sum = u128(a[i]) + b[i] + carry;
+        r[i] = static_cast<uint64_t>(sum);
+        carry = sum >> 64;
+    }
+    return r;
+}
+
+constexpr uint256 operator-(const uint256& a, const uint256& b) {
+    using u256_detail::u128;
+    uint256 r;
+    uint64_t borrow = 0;
+    for (int i = 3; i >= 0; --i) {
+        u128 diff = u128(a[i]) - b[i] - borrow;
+        r[i] = static_cast<uint64_t>(diff);
+        borrow = static_cast<uint64_t>(diff >> 64) & 1;
+    }
+    return r;
+}
+
+constexpr uint256 operator-(const uint256& a) { return uint256{} - a; }
+
+constexpr uint256 operator*(const uint256& a, const uint256& b) {
+    using u256_detail::u128;
+    if (a.fits_u64() && b.fits_u64()) {
+        u128 p = u128(a[3]) * b[3];
+        return {0, 0, static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p)};
+    }
+
+    // Schoolbook, dropping partial products above 2^256
+    auto x = u256_detail::to_limbs(a);
+    auto y = u256_detail::to_limbs(b);
+    uint64_t r[4] = {};
+    for (size_t i = 0; i < 4; ++i) {
+        if (x[i] == 0) continue;
+        uint64_t carry = 0;
+        for (size_t j = 0; i + j < 4; ++j) {
+            u128 t = u128(x[i]) * y[j] + r[i + j] + carry;
+            r[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+    }
+    return u256_detail::from_limbs(r);
+}
+
+// Full 512-bit product, little-endian limbs
+constexpr u256_detail::Limbs<8> mul_full(const uint256& a, const uint256& b) {
+    using u256_detail::u128;
+    auto x = u256_detail::to_limbs(a);
+    auto y = u256_detail::to_limbs(b);
+    u256_detail::Limbs<8> r{};
+    for (size_t i = 0; i < 4; ++i) {
+        if (x[i] == 0) continue;
+        uint64_t carry = 0;
+        for (size_t j = 0; j < 4; ++j) {
+            u128 t = u128(x[i]) * y[j] + r[i + j] + carry;
+            r[i + j] = static_cast<uint64_t>(t);
+            carry = static_cast<uint64_t>(t >> 64);
+        }
+        r[i + 4] = carry;
+    }
+    return r;
+}
+
+struct DivResult {
+    uint256 quotient;
+    uint256 remainder;
+};
+
+// Division by zero yields zero quotient and remainder, as in the EVM
+constexpr DivResult divmod(const uint256& a, const uint256& b) {
+    if (b.is_zero()) return {};
+    if (a.fits_u64() && b.fits_u64()) return {a[3] / b[3], a[3] % b[3]};
+    if (a < b) return {0, a};
+
+    u256_detail::Limbs<4> q{}, r{};
+    u256_detail::divrem(u256_detail::to_limbs(a), u256_detail::to_limbs(b), q, r);
+    return {u256_detail::from_limbs(q.data()), u256_detail::from_limbs(r.data())};
+}
+
+constexpr uint256 operator/(const uint256& a, const uint256& b) { return divmod(a, b).quotient; }
+constexpr uint256 operator%(const uint256& a, const uint256& b) { return divmod(a, b).remainder; }
+
+// (a + b) mod n without wrapping at 2^256; zero when n is zero
+constexpr uint256 addmod(const uint256& a, const uint256& b, const uint256& n) {
+    using u256_detail::u128;
+    if (n.is_zero()) return {};
+    if (a.fits_u64() && b.fits_u64() && n.fits_u64()) {
+        return static_cast<uint64_t>((u128(a[3]) + b[3]) % n[3]);
+    }
+
+    u256_detail::Limbs<5> sum{};
+    u128 carry = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        u128 t = u128(a[3 - i]) + b[3 - i] + carry;
+        sum[i] = static_cast<uint64_t>(t);
+        carry = t >> 64;
+    }
+    sum[4] = static_cast<uint64_t>(carry);
+
+    u256_detail::Limbs<5> q{};
+    u256_detail::Limbs<4> r{};
+    u256_detail::divrem(sum, u256_detail::to_limbs(n), q, r);
+    return u256_detail::from_limbs(r.data());
+}
+
+// (a * b) mod n over the full 512-bit product; zero when n is zero
+constexpr uint256 mulmod(const uint256& a, const uint256& b, const uint256& n) {
+    using u256_detail::u128;
+    if (n.is_zero()) return {};
+    if (a.fits_u64() && b.fits_u64() && n.fits_u64()) {
+        return static_cast<uint64_t>((u128(a[3]) * b[3]) % n[3]);
+    }
+
+    u256_detail::Limbs<8> q{};
+    u256_detail::Limbs<4> r{};
+    u256_detail::divrem(mul_full(a, b), u256_detail::to_limbs(n), q, r);
+    return u256_detail::from_limbs(r.data());
+}
+
+// ============================================================================
+// Bitwise operations and shifts
+// ============================================================================
+
+constexpr uint256 operator&(const uint256& a, const uint256& b) {
+    return {a[0] & b[0], a[1] & b[1], a[2] & b[2], a[3] & b[3]};
+}
+constexpr uint256 operator|(const uint256& a, const uint256& b) {
+    return {a[0] | b[0], a[1] | b[1], a[2] | b[2], a[3] | b[3]};
+}
+constexpr uint256 operator^(const uint256& a, const uint256& b) {
+    return {a[0] ^ b[0], a[1] ^ b[1], a[2] ^ b[2], a[3] ^ b[3]};
+}
+constexpr uint256 operator~(const uint256& a) { return {~a[0], ~a[1], ~a[2], ~a[3]}; }
+
+constexpr uint256 operator<<(const uint256& a, uint64_t shift) {
+    if (shift >= 256) return {};
+    const size_t words = shift / 64;
+    const unsigned bits = shift % 64;
+    uint256 r;
+    for (size_t i = 0; i + words < 4; ++i) {
+        uint64_t v = a[i + words] << bits;
+        if (bits && i + words + 1 < 4) v |= a[i + words + 1] >> (64 - bits);
+        r[i] = v;
+    }
+    return r;
+}
+
+constexpr uint256 operator>>(const uint256& a, uint64_t shift) {
+    if (shift >= 256) return {};
+    const size_t words = shift / 64;
+    const unsigned bits = shift % 64;
+    uint256 r;
+    for (size_t i = words; i < 4; ++i) {
+        uint64_t v = a[i - words] >> bits;
+        if (bits && i > words) v |= a[i - words - 1] << (64 - bits);
+        r[i] = v;
+    }
+    return r;
+}
+
+// Shift amounts are themselves 256-bit on the stack
+constexpr uint64_t shift_amount(const uint256& s) { return s.fits_u64() ? s[3] : 256; }
+
+// Byte `i` of `x`, counting from the most significant; zero past 31
+constexpr uint256 byte_at(const uint256& i, const uint256& x) {
+    if (!i.fits_u64() || i[3] >= 32) return {};
+    return (x[i[3] / 8] >> (56 - (i[3] % 8) * 8)) & 0xFF;
+}
+
+// base^exponent mod 2^256 by square-and-multiply
+constexpr uint256 exp(uint256 base, const uint256& exponent) {
+    // Powers of two are a shift
+    if (base == uint256(2)) return exponent.fits_u64() ? uint256(1) << exponent[3] : uint256{};
+
+    uint256 result = 1;
+    const size_t bits = exponent.byte_length() * 8;
+    for (size_t i = 0; i < bits; ++i) {
+        if ((exponent[3 - i / 64] >> (i % 64)) & 1) result = result * base;
+        if (i + 1 < bits) base = base * base;
+    }
+    return result;
+}
+
+// ============================================================================
+// Two's complement (signed) operations
+// ============================================================================
+
+/**
+ * @brief Signed view of a uint256 for SDIV, SMOD, SLT, SGT and SAR
+ */
+struct int256 {
+    uint256 bits;
+
+    constexpr int256() = default;
+    constexpr explicit int256(const uint256& b) : bits(b) {}
+
+    constexpr bool is_negative() const { return (bits[0] >> 63) != 0; }
+    constexpr uint256 magnitude() const { return is_negative() ? -bits : bits; }
+
+    friend constexpr bool operator==(const int256&, const int256&) = default;
+    friend constexpr auto operator<=>(const int256& a, const int256& b) {
+        // Flipping the sign bit maps signed order onto unsigned order
+        uint256 x = a.bits, y = b.bits;
+        x[0] ^= uint64_t(1) << 63;
+        y[0] ^= uint64_t(1) << 63;
+        return x <=> y;
+    }
+
+    // Truncates toward zero; division by zero yields zero. The one
+    // overflowing case, -2^255 / -1, wraps to -2^255 as the EVM requires.
+    friend constexpr int256 operator/(const int256& a, const int256& b) {
+        uint256 q = a.magnitude() / b.magnitude();
+        return int256(a.is_negative() != b.is_negative() ? -q : q);
+    }
+
+    // Remainder takes the sign of the dividend
+    friend constexpr int256 operator%(const int256& a, const int256& b) {
+        uint256 r = a.magnitude() % b.magnitude();
+        return int256(a.is_negative() ? -r : r);
+    }
+
+    friend constexpr int256 operator>>(const int256& a, uint64_t shift) {
+        if (!a.is_negative()) return int256(a.bits >> shift);
+        if (shift >= 256) return int256(~uint256{});
+        return int256(~(~a.bits >> shift));
+    }
+};
+
+// Sign-extends `x` from byte `b` (counting from the least significant)
+constexpr uint256 signextend(const uint256& b, const uint256& x) {
+    if (!b.fits_u64() || b[3] >= 31) return x;
+    const uint64_t bit = b[3] * 8 + 7;
+    const uint256 mask = (uint256(1) << bit) - 1;
+    const bool negative = ((x[3 - bit / 64] >> (bit % 64)) & 1) != 0;
+    return negative ? x | ~mask : x & mask;
+}
+
+} // namespace nonagon
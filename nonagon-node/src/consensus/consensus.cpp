@@ -1,5 +1,6 @@
 #include "nonagon/consensus.hpp"
 #include "nonagon/crypto.hpp"
+#include "nonagon/byte_io.hpp"
 #include <algorithm>
 #include <chrono>
 
@@ -10,15 +11,21 @@ namespace consensus {
 // BlockProposal Implementation
 // ============================================================================
 
+void BlockProposal::sign(const crypto::Ed25519::SecretKey& sk) {
+    auto block_hash = block.header.hash();
+    signature = crypto::Ed25519::sign(block_hash.data(), block_hash.size(), sk);
+}
+
 bool BlockProposal::verify(const crypto::Ed25519::PublicKey& pk) const {
     auto block_hash = block.header.hash();
     return crypto::Ed25519::verify(block_hash.data(), block_hash.size(), signature, pk);
 }
 
 Bytes BlockProposal::encode() const {
-    Bytes result = block.encode();
-    result.insert(result.end(), signature.begin(), signature.end());
-    return result;
+    ByteWriter out(block.encoded_size() + signature.size());
+    block.encode_to(out);
+    out.bytes(signature);
+    return out.finish();
 }
 
 // ============================================================================
@@ -157,7 +164,7 @@ uint64_t ConsensusEngine::total_active_stake() const {
 
 std::optional<Block> ConsensusEngine::produce_block(const Address& sequencer,
                                                      const Hash256& parent_hash,
-                                                     const std::vector<Transaction>& txs,
+                                                     const std::vector<TransactionPtr>& txs,
                                                      const Hash256& state_root) {
     std::shared_lock lock(mutex_);
     
@@ -169,14 +176,14 @@ std::optional<Block> ConsensusEngine::produce_block(const Address& sequencer,
     block.header.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     
-    block.transactions = txs;
-    block.header.transactions_root = block.compute_transactions_root();
-    
     // Calculate gas used
     uint64_t total_gas = 0;
+    block.reserve_transactions(txs.size());
     for (const auto& tx : txs) {
-        total_gas += tx.gas_limit;  // Simplified; should be actual gas used
+        block.add_transaction(tx);
+        total_gas += tx->gas_limit;  // Simplified; should be actual gas used
     }
+    block.header.transactions_root = block.compute_transactions_root();
     block.header.gas_used = total_gas;
     
     return block;
@@ -204,11 +211,16 @@ ConsensusEngine::ValidationResult ConsensusEngine::validate_block(const Block& b
     }
     
     // Check transactions root
-    Hash256 computed_tx_root = const_cast<Block&>(block).compute_transactions_root();
+    Hash256 computed_tx_root = block.compute_transactions_root();
     if (computed_tx_root != block.header.transactions_root) {
         return {false, "Transactions root mismatch"};
     }
     
+    // Check transaction signatures
+    if (!block.verify_signatures()) {
+        return {false, "Invalid transaction signature"};
+    }
+    
     // Check gas limit
     if (block.header.gas_used > block.header.gas_limit) {
         return {false, "Gas used exceeds limit"};
@@ -306,10 +318,17 @@ void ConsensusEngine::on_epoch_end(uint64_t epoch) {
 
 Mempool::Mempool(size_t max_size) : max_size_(max_size) {}
 
-Mempool::AddResult Mempool::add_transaction(Transaction tx, uint64_t sender_balance) {
-    std::unique_lock lock(mutex_);
+Mempool::AddResult Mempool::add_transaction(const Transaction& tx, uint64_t sender_balance) {
+    return add_transaction(Transaction::share(tx), sender_balance);
+}
+
+Mempool::AddResult Mempool::add_transaction(TransactionPtr tx_ptr, uint64_t sender_balance) {
+    const Transaction& tx = *tx_ptr;
     
+    // Hash outside the lock; it is memoized on the shared object
     auto tx_hash = tx.hash();
+    
+    std::unique_lock lock(mutex_);
     std::string hash_str(tx_hash.begin(), tx_hash.end());
     
     // Check if already known
@@ -337,24 +356,24 @@ Mempool::AddResult Mempool::add_transaction(Transaction tx, uint64_t sender_bala
     auto existing = sender_txs.by_nonce.find(tx.nonce);
     if (existing != sender_txs.by_nonce.end()) {
         // Allow replacement if higher gas price (10% bump required)
-        if (tx.max_fee_per_gas <= existing->second.max_fee_per_gas * 110 / 100) {
+        if (tx.max_fee_per_gas <= existing->second->max_fee_per_gas * 110 / 100) {
             return AddResult::Underpriced;
         }
         
         // Remove old transaction
-        auto old_hash = existing->second.hash();
+        auto old_hash = existing->second->hash();
         std::string old_hash_str(old_hash.begin(), old_hash.end());
         by_hash_.erase(old_hash_str);
         
-        sender_txs.by_nonce[tx.nonce] = tx;
-        by_hash_[hash_str] = tx;
+        existing->second = tx_ptr;
+        by_hash_[hash_str] = std::move(tx_ptr);
         
         return AddResult::Replaced;
     }
     
     // Add new transaction
-    sender_txs.by_nonce[tx.nonce] = tx;
-    by_hash_[hash_str] = tx;
+    sender_txs.by_nonce[tx.nonce] = tx_ptr;
+    by_hash_[hash_str] = tx_ptr;
     
     // Update pending nonce
     if (sender_txs.by_nonce.begin()->first == sender_txs.pending_nonce) {
@@ -379,7 +398,7 @@ bool Mempool::remove_transaction(const Hash256& hash) {
         return false;
     }
     
-    auto& tx = it->second;
+    const auto& tx = *it->second;
     std::string sender_key = tx.from.to_hex();
     
     auto sender_it = by_sender_.find(sender_key);
@@ -400,7 +419,7 @@ void Mempool::remove_confirmed(const std::vector<Hash256>& hashes) {
     }
 }
 
-std::optional<Transaction> Mempool::get_transaction(const Hash256& hash) const {
+TransactionPtr Mempool::get_transaction(const Hash256& hash) const {
     std::shared_lock lock(mutex_);
     
     std::string hash_str(hash.begin(), hash.end());
@@ -408,10 +427,10 @@ std::optional<Transaction> Mempool::get_transaction(const Hash256& hash) const {
     if (it != by_hash_.end()) {
         return it->second;
     }
-    return std::nullopt;
+    return nullptr;
 }
 
-std::vector<Transaction> Mempool::get_pending_for(const Address& addr) const {
+std::vector<TransactionPtr> Mempool::get_pending_for(const Address& addr) const {
     std::shared_lock lock(mutex_);
     
     std::string addr_key = addr.to_hex();
@@ -420,7 +439,8 @@ std::vector<Transaction> Mempool::get_pending_for(const Address& addr) const {
         return {};
     }
     
-    std::vector<Transaction> result;
+    std::vector<TransactionPtr> result;
+    result.reserve(it->second.by_nonce.size());
     for (const auto& [nonce, tx] : it->second.by_nonce) {
         result.push_back(tx);
     }
@@ -432,11 +452,11 @@ size_t Mempool::size() const {
     return by_hash_.size();
 }
 
-std::vector<Transaction> Mempool::get_block_transactions(uint64_t gas_limit, 
-                                                          uint64_t base_fee) {
+std::vector<TransactionPtr> Mempool::get_block_transactions(uint64_t gas_limit, 
+                                                             uint64_t base_fee) {
     std::unique_lock lock(mutex_);
     
-    std::vector<Transaction> result;
+    std::vector<TransactionPtr> result;
     uint64_t gas_used = 0;
     
     // Rebuild priority queue with current base fee
@@ -455,7 +475,8 @@ std::vector<Transaction> Mempool::get_block_transactions(uint64_t gas_limit,
             continue;
         }
         
-        auto& tx = by_hash_[hash_str];
+        const auto& tx_ptr = by_hash_[hash_str];
+        const auto& tx = *tx_ptr;
         
         // Check if fits in block
         if (gas_used + tx.gas_limit > gas_limit) {
@@ -467,7 +488,7 @@ std::vector<Transaction> Mempool::get_block_transactions(uint64_t gas_limit,
             continue;
         }
         
-        result.push_back(tx);
+        result.push_back(tx_ptr);
         selected_hashes.insert(hash_str);
         gas_used += tx.gas_limit;
     }
@@ -496,11 +517,11 @@ Mempool::Stats Mempool::get_stats() const {
     stats.max_gas_price = 0;
     
     for (const auto& [hash, tx] : by_hash_) {
-        if (tx.max_fee_per_gas < stats.min_gas_price) {
-            stats.min_gas_price = tx.max_fee_per_gas;
+        if (tx->max_fee_per_gas < stats.min_gas_price) {
+            stats.min_gas_price = tx->max_fee_per_gas;
         }
-        if (tx.max_fee_per_gas > stats.max_gas_price) {
-            stats.max_gas_price = tx.max_fee_per_gas;
+        if (tx->max_fee_per_gas > stats.max_gas_price) {
+            stats.max_gas_price = tx->max_fee_per_gas;
         }
     }
     
@@ -520,7 +541,7 @@ void Mempool::rebuild_priority_queue(uint64_t base_fee) {
     for (const auto& [hash_str, tx] : by_hash_) {
         Hash256 hash;
         std::copy(hash_str.begin(), hash_str.begin() + 32, hash.begin());
-        priority_queue_.push({hash, tx.effective_gas_price(base_fee)});
+        priority_queue_.push({hash, tx->effective_gas_price(base_fee)});
     }
 }
 
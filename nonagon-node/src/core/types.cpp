@@ -1,8 +1,10 @@
 #include "nonagon/types.hpp"
 #include "nonagon/crypto.hpp"
+#include "nonagon/byte_io.hpp"
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cstring>
 
 namespace nonagon {
 
@@ -85,63 +87,107 @@ std::optional<Address> Address::from_hex(const std::string& str) {
     return addr;
 }
 
-std::string Address::to_hex() const {
-    std::stringstream ss;
-    ss << std::hex << std::setfill('0');
-    ss << std::setw(2) << static_cast<int>(type);
-    for (auto b : payment_credential) {
-        ss << std::setw(2) << static_cast<int>(b);
-    }
-    if (stake_credential.has_value()) {
-        for (auto b : *stake_credential) {
-            ss << std::setw(2) << static_cast<int>(b);
-        }
+// Lowercase hex of type || payment || stake credential, without prefix.
+// Writes at most ADDRESS_HEX_MAX chars and returns the length.
+static constexpr size_t ADDRESS_HEX_MAX = 2 * (1 + 28 + 28);
+
+static size_t address_hex(const Address& addr, char* out) {
+    static const char* digits = "0123456789abcdef";
+    size_t n = 0;
+    auto put = [&](uint8_t b) {
+        out[n++] = digits[b >> 4];
+        out[n++] = digits[b & 0x0F];
+    };
+    
+    put(static_cast<uint8_t>(addr.type));
+    for (auto b : addr.payment_credential) put(b);
+    if (addr.stake_credential.has_value()) {
+        for (auto b : *addr.stake_credential) put(b);
     }
-    return ss.str();
+    return n;
+}
+
+std::string Address::to_hex() const {
+    char buf[ADDRESS_HEX_MAX];
+    return std::string(buf, address_hex(*this, buf));
 }
 
 // ============================================================================
 // Transaction Implementation
 // ============================================================================
 
-Hash256 Transaction::hash() const {
-    std::vector<uint8_t> data;
+// Feeds the hashed transaction fields to anything with
+// update(const uint8_t*, size_t). `ints` is value, nonce, gas_limit,
+// max_fee_per_gas, max_priority_fee_per_gas.
+template <typename Sink>
+static void write_tx_preimage(const Address& from, const Address& to, const uint64_t ints_in[5],
+                              const uint8_t* data, size_t data_len,
+                              const uint8_t* pubkey, Sink& sink) {
+    char hex[ADDRESS_HEX_MAX];
     
     // Serialize core fields
-    auto from_hex = from.to_hex();
-    auto to_hex = to.to_hex();
-    
-    data.insert(data.end(), from_hex.begin(), from_hex.end());
-    data.insert(data.end(), to_hex.begin(), to_hex.end());
+    sink.update(reinterpret_cast<const uint8_t*>(hex), address_hex(from, hex));
+    sink.update(reinterpret_cast<const uint8_t*>(hex), address_hex(to, hex));
     
-    // Encode value (big endian)
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
-    }
-    
-    // Encode nonce
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((nonce >> (i * 8)) & 0xFF));
+    // Value, nonce and gas fields (big endian)
+    uint8_t ints[5 * 8];
+    for (size_t f = 0; f < 5; ++f) {
+        for (int i = 0; i < 8; ++i) {
+            ints[f * 8 + i] = static_cast<uint8_t>(ints_in[f] >> ((7 - i) * 8));
+        }
     }
+    sink.update(ints, sizeof(ints));
     
-    // Encode gas fields
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((gas_limit >> (i * 8)) & 0xFF));
-    }
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((max_fee_per_gas >> (i * 8)) & 0xFF));
-    }
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((max_priority_fee_per_gas >> (i * 8)) & 0xFF));
+    // Call data and sender pubkey
+    sink.update(data, data_len);
+    sink.update(pubkey, crypto::Ed25519::PUBLIC_KEY_SIZE);
+}
+
+template <typename Sink>
+static void write_tx_preimage(const Transaction& tx, Sink& sink) {
+    const uint64_t ints[5] = {tx.value, tx.nonce, tx.gas_limit,
+                              tx.max_fee_per_gas, tx.max_priority_fee_per_gas};
+    write_tx_preimage(tx.from, tx.to, ints, tx.data.data(), tx.data.size(),
+                      tx.sender_pubkey.data(), sink);
+}
+
+namespace {
+struct AppendSink {
+    Bytes& out;
+    void update(const uint8_t* data, size_t len) { out.insert(out.end(), data, data + len); }
+};
+} // namespace
+
+Hash256 Transaction::hash() const {
+    if (!memo_.frozen) return compute_hash();
+    if (!memo_.hash_ready.load(std::memory_order_acquire)) {
+        memoize_hash(compute_hash());
     }
-    
-    // Append call data
-    data.insert(data.end(), this->data.begin(), this->data.end());
-    
-    // Append sender pubkey
-    data.insert(data.end(), sender_pubkey.begin(), sender_pubkey.end());
-    
-    return crypto::Blake2b256::hash(data);
+    return memo_.hash;
+}
+
+void Transaction::memoize_hash(const Hash256& h) const {
+    std::call_once(memo_.hash_once, [&]() {
+        memo_.hash = h;
+        memo_.hash_ready.store(true, std::memory_order_release);
+    });
+}
+
+Hash256 Transaction::compute_hash() const {
+    crypto::Blake2bHasher hasher;
+    write_tx_preimage(*this, hasher);
+    return hasher.final();
+}
+
+TransactionPtr Transaction::share(Transaction tx) {
+    auto shared = std::make_shared<Transaction>(std::move(tx));
+    shared->memo_.frozen = true;
+    return shared;
+}
+
+void Transaction::append_hash_preimage(Bytes& out) const {
+    AppendSink sink{out};
+    write_tx_preimage(*this, sink);
 }
 
 uint64_t Transaction::effective_gas_price(uint64_t base_fee) const {
@@ -154,276 +200,743 @@ uint64_t Transaction::effective_gas_price(uint64_t base_fee) const {
     return base_fee + priority_fee;
 }
 
+// DEV BYPASS: an all-0xFF signature is accepted for testing
+static bool is_dev_signature(const crypto::Ed25519::Signature& signature) {
+    for (auto b : signature) {
+        if (b != 0xFF) return false;
+    }
+    return true;
+}
+
 bool Transaction::verify_signature() const {
     // Get message hash for signing (exclude signature)
     auto tx_hash = hash();
     
     // Verify signature using the included public key
-    // DEV BYPASS: Allow 0xFF signature for testing
-    bool all_ff = true;
-    for(auto b : signature) if(b != 0xFF) { all_ff = false; break; }
-    if(all_ff) return true;
+    if (is_dev_signature(signature)) return true;
+    
+    // Admission fills the cache so block validation can skip the curve work
+    auto& cache = crypto::SignatureCache::instance();
+    auto key = crypto::SignatureCache::key(tx_hash.data(), tx_hash.size(), signature, sender_pubkey);
+    if (cache.contains(key)) return true;
+    
+    if (!crypto::Ed25519::verify(tx_hash.data(), tx_hash.size(), signature, sender_pubkey)) {
+        return false;
+    }
+    cache.insert(key);
+    return true;
+}
 
-    return crypto::Ed25519::verify(tx_hash.data(), tx_hash.size(), 
-                                    signature, sender_pubkey);
+// V2 flag bits for a transaction's optional fields
+namespace {
+constexpr uint8_t TX_HAS_PRIORITY_FEE = 0x01;
+constexpr uint8_t TX_HAS_DATA = 0x02;
+constexpr uint8_t TX_HAS_SIGNATURE = 0x04;
+constexpr uint8_t TX_FLAGS_MASK = 0x07;
+} // namespace
+
+template <size_t N>
+static bool all_zero(const std::array<uint8_t, N>& bytes) {
+    for (auto b : bytes) {
+        if (b != 0) return false;
+    }
+    return true;
+}
+
+static uint8_t tx_flags(const Transaction& tx) {
+    uint8_t flags = 0;
+    if (tx.max_priority_fee_per_gas != 0) flags |= TX_HAS_PRIORITY_FEE;
+    if (!tx.data.empty()) flags |= TX_HAS_DATA;
+    if (!all_zero(tx.signature)) flags |= TX_HAS_SIGNATURE;
+    return flags;
 }
 
-Bytes Transaction::encode() const {
-    Bytes result;
+// V2 body: flags, from, to, varint integers, optional fields. Standalone
+// transactions carry the credentials inline; block bodies carry indices
+// into the block's address table. `address_size(i)` is the size of the
+// from (i = 0) or to (i = 1) reference and `write_address(i)` writes it.
+template <typename AddressSize>
+static size_t tx_v2_size(const Transaction& tx, AddressSize address_size) {
+    size_t size = 1 + address_size(0) + address_size(1);
+    size += ByteWriter::varint_size(tx.value);
+    size += ByteWriter::varint_size(tx.nonce);
+    size += ByteWriter::varint_size(tx.gas_limit);
+    size += ByteWriter::varint_size(tx.max_fee_per_gas);
+    
+    uint8_t flags = tx_flags(tx);
+    if (flags & TX_HAS_PRIORITY_FEE) size += ByteWriter::varint_size(tx.max_priority_fee_per_gas);
+    if (flags & TX_HAS_DATA) size += ByteWriter::varint_size(tx.data.size()) + tx.data.size();
+    size += crypto::Ed25519::PUBLIC_KEY_SIZE;
+    if (flags & TX_HAS_SIGNATURE) size += crypto::Ed25519::SIGNATURE_SIZE;
+    return size;
+}
+
+template <typename WriteAddress>
+static void write_tx_v2(const Transaction& tx, ByteWriter& out, WriteAddress write_address) {
+    uint8_t flags = tx_flags(tx);
+    out.u8(flags);
+    write_address(0);
+    write_address(1);
+    
+    out.varint(tx.value);
+    out.varint(tx.nonce);
+    out.varint(tx.gas_limit);
+    out.varint(tx.max_fee_per_gas);
+    if (flags & TX_HAS_PRIORITY_FEE) out.varint(tx.max_priority_fee_per_gas);
+    if (flags & TX_HAS_DATA) {
+        out.varint(tx.data.size());
+        out.bytes(tx.data);
+    }
     
-    // Helper function to append uint64
-    auto append_uint64 = [&result](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
+    out.bytes(tx.sender_pubkey);
+    if (flags & TX_HAS_SIGNATURE) out.bytes(tx.signature);
+}
+
+Bytes Transaction::encode(Encoding encoding) const {
+    if (!memo_.frozen || encoding != Encoding::V2) return compute_encoding(encoding);
+    if (!memo_.encoded_ready.load(std::memory_order_acquire)) {
+        std::call_once(memo_.encoded_once, [this]() {
+            memo_.encoded = compute_encoding(Encoding::V2);
+            memo_.encoded_ready.store(true, std::memory_order_release);
+        });
+    }
+    return memo_.encoded;
+}
+
+Bytes Transaction::compute_encoding(Encoding encoding) const {
+    ByteWriter out(encoded_size(encoding));
+    encode_to(out, encoding);
+    return out.finish();
+}
+
+size_t Transaction::encoded_size(Encoding encoding) const {
+    if (encoding == Encoding::V1) return 216 + data.size();
+    if (memo_.encoded_ready.load(std::memory_order_acquire)) return memo_.encoded.size();
+    return 1 + tx_v2_size(*this, [](int) { return size_t(28); });
+}
+
+void Transaction::encode_to(ByteWriter& out, Encoding encoding) const {
+    if (encoding == Encoding::V2) {
+        // A memoized encoding is copied as one block
+        if (memo_.encoded_ready.load(std::memory_order_acquire)) {
+            out.bytes(memo_.encoded);
+            return;
         }
-    };
-    
-    // Helper function to append bytes with length prefix
-    auto append_bytes = [&result, &append_uint64](const Bytes& b) {
-        append_uint64(b.size());
-        result.insert(result.end(), b.begin(), b.end());
-    };
-    
-    // From address
-    auto from_bytes = Bytes(from.payment_credential.begin(), from.payment_credential.end());
-    append_bytes(from_bytes);
-    
-    // To address
-    auto to_bytes = Bytes(to.payment_credential.begin(), to.payment_credential.end());
-    append_bytes(to_bytes);
+        
+        out.u8(ENCODING_V2_MAGIC);
+        write_tx_v2(*this, out, [&](int i) {
+            out.bytes((i == 0 ? from : to).payment_credential);
+        });
+        return;
+    }
     
-    append_uint64(value);
-    append_uint64(nonce);
-    append_uint64(gas_limit);
-    append_uint64(max_fee_per_gas);
-    append_uint64(max_priority_fee_per_gas);
-    append_bytes(data);
+    // From and to payment credentials, length-prefixed
+    out.prefixed(from.payment_credential.data(), from.payment_credential.size());
+    out.prefixed(to.payment_credential.data(), to.payment_credential.size());
     
-    // Sender PubKey
-    result.insert(result.end(), sender_pubkey.begin(), sender_pubkey.end());
-
-    // Signature
-    result.insert(result.end(), signature.begin(), signature.end());
+    out.u64_be(value);
+    out.u64_be(nonce);
+    out.u64_be(gas_limit);
+    out.u64_be(max_fee_per_gas);
+    out.u64_be(max_priority_fee_per_gas);
+    out.prefixed(data);
     
-    return result;
+    out.bytes(sender_pubkey);
+    out.bytes(signature);
 }
 
 std::optional<Transaction> Transaction::decode(const Bytes& data) {
-    if (data.size() < 100) return std::nullopt;  // Minimum size check
-    
-    Transaction tx;
-    size_t offset = 0;
+    auto view = TransactionView::parse(data);
+    if (!view) return std::nullopt;
+    return view->materialize();
+}
+
+// ============================================================================
+// BlockHeader Implementation
+// ============================================================================
+
+Hash256 BlockHeader::hash() const {
+    crypto::Blake2bHasher hasher;
+    
+    hasher.update_u64_be(number);
+    hasher.update(parent_hash);
+    hasher.update(state_root);
+    hasher.update(transactions_root);
+    hasher.update(receipts_root);
+    hasher.update(sequencer.payment_credential);
+    
+    hasher.update_u64_be(gas_limit);
+    hasher.update_u64_be(gas_used);
+    hasher.update_u64_be(base_fee);
+    hasher.update_u64_be(timestamp);
+    hasher.update_u64_be(l1_block_number);
+    hasher.update_u64_be(batch_id);
+    
+    return hasher.final();
+}
+
+Bytes BlockHeader::encode(Encoding encoding) const {
+    ByteWriter out(encoded_size(encoding));
+    encode_to(out, encoding);
+    return out.finish();
+}
+
+size_t BlockHeader::encoded_size(Encoding encoding) const {
+    if (encoding == Encoding::V1) return V1_ENCODED_SIZE;
     
-    auto read_uint64 = [&data, &offset]() -> uint64_t {
-        uint64_t v = 0;
-        for (int i = 0; i < 8 && offset < data.size(); ++i, ++offset) {
-            v = (v << 8) | data[offset];
+    size_t size = 1 + 4 * 32 + 28;
+    for (uint64_t v : {number, gas_limit, gas_used, base_fee, timestamp, l1_block_number, batch_id}) {
+        size += ByteWriter::varint_size(v);
+    }
+    return size;
+}
+
+void BlockHeader::encode_to(ByteWriter& out, Encoding encoding) const {
+    const bool v2 = encoding == Encoding::V2;
+    auto write_int = [&](uint64_t v) {
+        if (v2) {
+            out.varint(v);
+        } else {
+            out.u64_be(v);
         }
-        return v;
-    };
-    
-    auto read_bytes = [&data, &offset, &read_uint64]() -> Bytes {
-        uint64_t len = read_uint64();
-        if (offset + len > data.size()) return {};
-        Bytes result(data.begin() + offset, data.begin() + offset + len);
-        offset += len;
-        return result;
     };
     
-    // From address
-    auto from_bytes = read_bytes();
-    if (from_bytes.size() == 28) {
-        std::copy(from_bytes.begin(), from_bytes.end(), tx.from.payment_credential.begin());
+    if (v2) out.u8(ENCODING_V2_MAGIC);
+    write_int(number);
+    out.bytes(parent_hash);
+    out.bytes(state_root);
+    out.bytes(transactions_root);
+    out.bytes(receipts_root);
+    out.bytes(sequencer.payment_credential);
+    
+    write_int(gas_limit);
+    write_int(gas_used);
+    write_int(base_fee);
+    write_int(timestamp);
+    write_int(l1_block_number);
+    write_int(batch_id);
+}
+
+// Counterpart of BlockHeader::encode_to; a V2 header starts after the magic
+static void read_header(ByteReader& in, Encoding encoding, BlockHeader& h) {
+    const bool v2 = encoding == Encoding::V2;
+    auto read_int = [&]() { return v2 ? in.varint() : in.u64_be(); };
+    
+    h.number = read_int();
+    in.bytes(h.parent_hash);
+    in.bytes(h.state_root);
+    in.bytes(h.transactions_root);
+    in.bytes(h.receipts_root);
+    in.bytes(h.sequencer.payment_credential);
+    
+    h.gas_limit = read_int();
+    h.gas_used = read_int();
+    h.base_fee = read_int();
+    h.timestamp = read_int();
+    h.l1_block_number = read_int();
+    h.batch_id = read_int();
+}
+
+// ============================================================================
+// Block Implementation
+// ============================================================================
+
+void Block::add_transaction(TransactionPtr tx) {
+    tx_root_acc_.append(tx->hash());
+    transactions_.push_back(std::move(tx));
+}
+
+void Block::add_transaction(const Transaction& tx) {
+    add_transaction(Transaction::share(tx));
+}
+
+// Hashes `count` preimages as one multi-buffer batch. Preimages share one
+// arena so the batch costs a handful of allocations, not one per tx.
+template <typename AppendPreimage>
+static std::vector<Hash256> hash_preimages(size_t count, AppendPreimage append) {
+    Bytes arena;
+    std::vector<size_t> offsets(count + 1, 0);
+    std::vector<const uint8_t*> inputs(count);
+    std::vector<size_t> lens(count);
+    std::vector<Hash256> hashes(count);
+    
+    for (size_t i = 0; i < count; ++i) {
+        append(i, arena);
+        offsets[i + 1] = arena.size();
+    }
+    for (size_t i = 0; i < count; ++i) {
+        inputs[i] = arena.data() + offsets[i];
+        lens[i] = offsets[i + 1] - offsets[i];
+    }
+    crypto::Blake2b256::hash_many(inputs.data(), lens.data(), count, hashes.data());
+    return hashes;
+}
+
+// Checks `count` signatures as one Ed25519 batch. Signatures seen before
+// (at admission, or in an earlier block) are skipped via the cache.
+// get(i, hash, sig, pk) fills entry i and returns false for dev signatures.
+template <typename GetEntry>
+static bool verify_signature_set(size_t count, GetEntry get) {
+    auto& cache = crypto::SignatureCache::instance();
+    std::vector<Hash256> tx_hashes;
+    std::vector<crypto::Ed25519::Signature> sigs;
+    std::vector<crypto::Ed25519::PublicKey> pks;
+    std::vector<crypto::SignatureCache::Key> keys;
+    tx_hashes.reserve(count);
+    sigs.reserve(count);
+    pks.reserve(count);
+    keys.reserve(count);
+    
+    Hash256 tx_hash;
+    crypto::Ed25519::Signature sig;
+    crypto::Ed25519::PublicKey pk;
+    for (size_t i = 0; i < count; ++i) {
+        if (!get(i, tx_hash, sig, pk)) continue;
+        
+        auto key = crypto::SignatureCache::key(tx_hash.data(), tx_hash.size(), sig, pk);
+        if (cache.contains(key)) continue;
+        
+        tx_hashes.push_back(tx_hash);
+        sigs.push_back(sig);
+        pks.push_back(pk);
+        keys.push_back(key);
     }
     
-    // To address
-    auto to_bytes = read_bytes();
-    if (to_bytes.size() == 28) {
-        std::copy(to_bytes.begin(), to_bytes.end(), tx.to.payment_credential.begin());
+    // Vectors are final; entries may point into them now
+    std::vector<crypto::Ed25519::BatchEntry> entries;
+    entries.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        entries.push_back({tx_hashes[i].data(), tx_hashes[i].size(), &sigs[i], &pks[i]});
     }
     
-    tx.value = read_uint64();
-    tx.nonce = read_uint64();
-    tx.gas_limit = read_uint64();
-    tx.max_fee_per_gas = read_uint64();
-    tx.max_priority_fee_per_gas = read_uint64();
-    tx.data = read_bytes();
+    if (!crypto::Ed25519::verify_batch(entries)) return false;
     
-    // Sender PubKey
-    if (offset + 32 > data.size()) return std::nullopt;
-    std::copy(data.begin() + offset, data.begin() + offset + 32, tx.sender_pubkey.begin());
-    offset += 32;
+    for (const auto& key : keys) {
+        cache.insert(key);
+    }
+    return true;
+}
 
-    // Signature
-    if (offset + 64 <= data.size()) {
-        std::copy(data.begin() + offset, data.begin() + offset + 64, tx.signature.begin());
+void Block::set_transactions(std::vector<TransactionPtr> txs) {
+    transactions_ = std::move(txs);
+    tx_root_acc_.clear();
+    
+    // Memoized hashes are reused; the rest (unshared copies) are hashed
+    // as one batch and seeded
+    const size_t count = transactions_.size();
+    if (count > 0) {
+        std::vector<Hash256> tx_hashes(count);
+        std::vector<size_t> cold;
+        for (size_t i = 0; i < count; ++i) {
+            const Transaction& tx = *transactions_[i];
+            if (tx.memo_.hash_ready.load(std::memory_order_acquire)) {
+                tx_hashes[i] = tx.memo_.hash;
+            } else {
+                cold.push_back(i);
+            }
+        }
+        
+        if (!cold.empty()) {
+            auto cold_hashes = hash_preimages(cold.size(), [&](size_t k, Bytes& arena) {
+                transactions_[cold[k]]->append_hash_preimage(arena);
+            });
+            for (size_t k = 0; k < cold.size(); ++k) {
+                const Transaction& tx = *transactions_[cold[k]];
+                if (tx.memo_.frozen) tx.memoize_hash(cold_hashes[k]);
+                tx_hashes[cold[k]] = cold_hashes[k];
+            }
+        }
+        
+        for (const auto& tx_hash : tx_hashes) {
+            tx_root_acc_.append(tx_hash);
+        }
     }
-    
-    return tx;
 }
 
-// ============================================================================
-// BlockHeader Implementation
-// ============================================================================
+bool Block::verify_signatures() const {
+    return verify_signature_set(transactions_.size(),
+        [&](size_t i, Hash256& h, crypto::Ed25519::Signature& sig, crypto::Ed25519::PublicKey& pk) {
+            const auto& tx = *transactions_[i];
+            if (is_dev_signature(tx.signature)) return false;
+            h = tx.hash();
+            sig = tx.signature;
+            pk = tx.sender_pubkey;
+            return true;
+        });
+}
 
-Hash256 BlockHeader::hash() const {
-    std::vector<uint8_t> data;
-    
-    auto append_uint64 = [&data](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            data.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
+namespace {
+// Distinct from/to credentials of a block in first-seen order, each
+// transaction's (from, to) indices into that list and its V2 body size
+struct BlockAddressTable {
+    explicit BlockAddressTable(const Block& block) {
+        const size_t count = block.transactions().size();
+        refs.reserve(count);
+        body_sizes.reserve(count);
+        
+        // Open addressing over credential indices, at most half full.
+        // Credentials are key hashes, so any eight bytes hash uniformly.
+        size_t slots = 16;
+        while (slots < 4 * count) slots *= 2;
+        std::vector<uint32_t> index(slots, EMPTY);
+        
+        auto intern = [&](const Address& addr) {
+            const auto& credential = addr.payment_credential;
+            uint64_t h;
+            std::memcpy(&h, credential.data(), sizeof(h));
+            for (size_t slot = h & (slots - 1);; slot = (slot + 1) & (slots - 1)) {
+                uint32_t i = index[slot];
+                if (i == EMPTY) {
+                    index[slot] = static_cast<uint32_t>(credentials.size());
+                    credentials.push_back(&credential);
+                    return index[slot];
+                }
+                if (*credentials[i] == credential) return i;
+            }
+        };
+        for (const auto& tx : block.transactions()) {
+            std::array<uint32_t, 2> ref = {intern(tx->from), intern(tx->to)};
+            refs.push_back(ref);
+            body_sizes.push_back(tx_v2_size(*tx, [&](int k) {
+                return ByteWriter::varint_size(ref[k]);
+            }));
         }
-    };
+    }
     
-    append_uint64(number);
-    data.insert(data.end(), parent_hash.begin(), parent_hash.end());
-    data.insert(data.end(), state_root.begin(), state_root.end());
-    data.insert(data.end(), transactions_root.begin(), transactions_root.end());
-    data.insert(data.end(), receipts_root.begin(), receipts_root.end());
+    static constexpr uint32_t EMPTY = UINT32_MAX;
     
-    auto seq_bytes = sequencer.payment_credential;
-    data.insert(data.end(), seq_bytes.begin(), seq_bytes.end());
+    std::vector<const std::array<uint8_t, 28>*> credentials;
+    std::vector<std::array<uint32_t, 2>> refs;
+    std::vector<size_t> body_sizes;
+};
+
+size_t block_v2_size(const Block& block, const BlockAddressTable& table) {
+    size_t size = block.header.encoded_size(Encoding::V2);
+    size += ByteWriter::varint_size(table.credentials.size()) + 28 * table.credentials.size();
+    size += ByteWriter::varint_size(block.transactions().size());
+    for (size_t body : table.body_sizes) {
+        size += ByteWriter::varint_size(body) + body;
+    }
+    return size;
+}
+
+void write_block_v2(const Block& block, const BlockAddressTable& table, ByteWriter& out) {
+    block.header.encode_to(out, Encoding::V2);
     
-    append_uint64(gas_limit);
-    append_uint64(gas_used);
-    append_uint64(base_fee);
-    append_uint64(timestamp);
-    append_uint64(l1_block_number);
-    append_uint64(batch_id);
+    out.varint(table.credentials.size());
+    for (const auto* credential : table.credentials) {
+        out.bytes(*credential);
+    }
     
-    return crypto::Blake2b256::hash(data);
+    // Each transaction body with a varint length prefix
+    out.varint(block.transactions().size());
+    for (size_t i = 0; i < block.transactions().size(); ++i) {
+        const auto& ref = table.refs[i];
+        out.varint(table.body_sizes[i]);
+        write_tx_v2(*block.transactions()[i], out, [&](int k) { out.varint(ref[k]); });
+    }
 }
+} // namespace
 
-Bytes BlockHeader::encode() const {
-    Bytes result;
-    
-    auto append_uint64 = [&result](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
-        }
-    };
+size_t Block::encoded_size(Encoding encoding) const {
+    if (encoding == Encoding::V2) {
+        return block_v2_size(*this, BlockAddressTable(*this));
+    }
     
-    append_uint64(number);
-    result.insert(result.end(), parent_hash.begin(), parent_hash.end());
-    result.insert(result.end(), state_root.begin(), state_root.end());
-    result.insert(result.end(), transactions_root.begin(), transactions_root.end());
-    result.insert(result.end(), receipts_root.begin(), receipts_root.end());
+    size_t size = BlockHeader::V1_ENCODED_SIZE + 4;
+    for (const auto& tx : transactions_) {
+        size += 4 + tx->encoded_size(Encoding::V1);
+    }
+    return size;
+}
+
+Bytes Block::encode(Encoding encoding) const {
+    if (encoding == Encoding::V2) {
+        // Build the address table once for both passes
+        BlockAddressTable table(*this);
+        ByteWriter out(block_v2_size(*this, table));
+        write_block_v2(*this, table, out);
+        return out.finish();
+    }
     
-    auto seq_bytes = sequencer.payment_credential;
-    result.insert(result.end(), seq_bytes.begin(), seq_bytes.end());
+    ByteWriter out(encoded_size(encoding));
+    encode_to(out, encoding);
+    return out.finish();
+}
+
+void Block::encode_to(ByteWriter& out, Encoding encoding) const {
+    if (encoding == Encoding::V2) {
+        write_block_v2(*this, BlockAddressTable(*this), out);
+        return;
+    }
     
-    append_uint64(gas_limit);
-    append_uint64(gas_used);
-    append_uint64(base_fee);
-    append_uint64(timestamp);
-    append_uint64(l1_block_number);
-    append_uint64(batch_id);
+    header.encode_to(out, Encoding::V1);
     
-    return result;
+    // Transaction count, then each transaction with a u32 length prefix
+    out.u32_be(static_cast<uint32_t>(transactions_.size()));
+    for (const auto& tx : transactions_) {
+        out.u32_be(static_cast<uint32_t>(tx->encoded_size(Encoding::V1)));
+        tx->encode_to(out, Encoding::V1);
+    }
+}
+
+std::optional<Block> Block::decode(const Bytes& data) {
+    auto view = BlockView::parse(data);
+    if (!view) return std::nullopt;
+    return view->materialize();
 }
 
 // ============================================================================
-// Block Implementation
+// TransactionView / BlockView Implementation
 // ============================================================================
 
-Hash256 Block::compute_transactions_root() const {
-    std::vector<Hash256> tx_hashes;
-    tx_hashes.reserve(transactions.size());
+std::optional<TransactionView> TransactionView::parse(const uint8_t* data, size_t len) {
+    if (len == 0 || data[0] != ENCODING_V2_MAGIC) return parse_v1(data, len);
     
-    for (const auto& tx : transactions) {
-        tx_hashes.push_back(tx.hash());
-    }
-    
-    return crypto::Blake2b256::merkle_root(tx_hashes);
+    ByteReader in(data + 1, len - 1);
+    auto view = parse_v2(in, nullptr, 0);
+    if (!view || in.remaining() != 0) return std::nullopt;
+    return view;
 }
 
-Bytes Block::encode() const {
-    Bytes result = header.encode();
+// Same acceptance as the old field-by-field decoder for well-formed input,
+// but a length prefix that runs past the buffer is an error, not skipped
+std::optional<TransactionView> TransactionView::parse_v1(const uint8_t* data, size_t len) {
+    if (len < 100) return std::nullopt;  // Minimum size check
+    
+    TransactionView view;
+    ByteReader in(data, len);
+    
+    auto take_prefixed = [&](size_t& len_out) -> const uint8_t* {
+        uint64_t n = in.u64_be();
+        if (!in.ok() || n > in.remaining()) return nullptr;
+        len_out = static_cast<size_t>(n);
+        return in.take(len_out);
+    };
     
-    // Append transaction count
-    uint32_t tx_count = static_cast<uint32_t>(transactions.size());
-    for (int i = 3; i >= 0; --i) {
-        result.push_back(static_cast<uint8_t>((tx_count >> (i * 8)) & 0xFF));
-    }
+    // Credentials of any other length decode to the default address
+    size_t cred_len = 0;
+    const uint8_t* from = take_prefixed(cred_len);
+    if (!from) return std::nullopt;
+    view.from_ = cred_len == 28 ? from : nullptr;
+    const uint8_t* to = take_prefixed(cred_len);
+    if (!to) return std::nullopt;
+    view.to_ = cred_len == 28 ? to : nullptr;
     
-    // Append each transaction
-    for (const auto& tx : transactions) {
-        auto tx_bytes = tx.encode();
-        // Length prefix
-        uint32_t len = static_cast<uint32_t>(tx_bytes.size());
-        for (int i = 3; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((len >> (i * 8)) & 0xFF));
-        }
-        result.insert(result.end(), tx_bytes.begin(), tx_bytes.end());
+    view.value_ = in.u64_be();
+    view.nonce_ = in.u64_be();
+    view.gas_limit_ = in.u64_be();
+    view.max_fee_per_gas_ = in.u64_be();
+    view.max_priority_fee_per_gas_ = in.u64_be();
+    
+    view.data_ = take_prefixed(view.data_len_);
+    if (!view.data_) return std::nullopt;
+    
+    // Sender PubKey
+    view.pubkey_ = in.take(crypto::Ed25519::PUBLIC_KEY_SIZE);
+    if (!in.ok()) return std::nullopt;
+    
+    // Signature is optional, as it always has been
+    if (in.remaining() >= crypto::Ed25519::SIGNATURE_SIZE) {
+        view.signature_ = in.take(crypto::Ed25519::SIGNATURE_SIZE);
+    }
+    return view;
+}
+
+std::optional<TransactionView> TransactionView::parse_v2(ByteReader& in, const uint8_t* table,
+                                                         size_t table_count) {
+    TransactionView view;
+    uint8_t flags = in.u8();
+    if (!in.ok() || (flags & ~TX_FLAGS_MASK)) return std::nullopt;
+    
+    auto read_address = [&]() -> const uint8_t* {
+        if (!table) return in.take(28);
+        uint64_t index = in.varint();
+        if (!in.ok() || index >= table_count) return nullptr;
+        return table + index * 28;
+    };
+    view.from_ = read_address();
+    view.to_ = read_address();
+    if (!view.from_ || !view.to_) return std::nullopt;
+    
+    view.value_ = in.varint();
+    view.nonce_ = in.varint();
+    view.gas_limit_ = in.varint();
+    view.max_fee_per_gas_ = in.varint();
+    if (flags & TX_HAS_PRIORITY_FEE) view.max_priority_fee_per_gas_ = in.varint();
+    
+    if (flags & TX_HAS_DATA) {
+        uint64_t n = in.varint();
+        if (!in.ok() || n > in.remaining()) return std::nullopt;
+        view.data_len_ = static_cast<size_t>(n);
+        view.data_ = in.take(view.data_len_);
     }
     
-    return result;
+    view.pubkey_ = in.take(crypto::Ed25519::PUBLIC_KEY_SIZE);
+    if (flags & TX_HAS_SIGNATURE) view.signature_ = in.take(crypto::Ed25519::SIGNATURE_SIZE);
+    if (!in.ok()) return std::nullopt;
+    return view;
 }
 
-std::optional<Block> Block::decode(const Bytes& data) {
-    if (data.size() < 212) return std::nullopt; // 212 is fixed header size
+static Address view_address(const uint8_t* credential) {
+    Address addr;
+    if (credential) {
+        std::memcpy(addr.payment_credential.data(), credential, 28);
+    }
+    return addr;
+}
 
-    Block block;
-    size_t offset = 0;
+Address TransactionView::from() const {
+    return view_address(from_);
+}
 
-    auto read_uint64 = [&](size_t& off) -> uint64_t {
-        uint64_t v = 0;
-        for (int i = 0; i < 8; ++i) {
-            v = (v << 8) | data[off++];
-        }
-        return v;
-    };
+Address TransactionView::to() const {
+    return view_address(to_);
+}
 
-    auto read_bytes = [&](size_t& off, uint8_t* dest, size_t count) {
-        std::memcpy(dest, data.data() + off, count);
-        off += count;
-    };
+crypto::Ed25519::PublicKey TransactionView::sender_pubkey() const {
+    crypto::Ed25519::PublicKey pk;
+    std::memcpy(pk.data(), pubkey_, pk.size());
+    return pk;
+}
 
-    // Header decoding
-    block.header.number = read_uint64(offset);
+crypto::Ed25519::Signature TransactionView::signature() const {
+    crypto::Ed25519::Signature sig{};
+    if (signature_) {
+        std::memcpy(sig.data(), signature_, sig.size());
+    }
+    return sig;
+}
 
-    // Hashes (32 bytes each)
-    read_bytes(offset, block.header.parent_hash.data(), 32);
-    read_bytes(offset, block.header.state_root.data(), 32);
-    read_bytes(offset, block.header.transactions_root.data(), 32);
-    read_bytes(offset, block.header.receipts_root.data(), 32);
+template <typename Sink>
+static void write_view_preimage(const TransactionView& view, Sink& sink) {
+    const uint64_t ints[5] = {view.value(), view.nonce(), view.gas_limit(),
+                              view.max_fee_per_gas(), view.max_priority_fee_per_gas()};
+    auto data = view.data();
+    auto pk = view.sender_pubkey();
+    write_tx_preimage(view.from(), view.to(), ints, data.data(), data.size(), pk.data(), sink);
+}
 
-    // Sequencer Address (28 bytes)
-    read_bytes(offset, block.header.sequencer.payment_credential.data(), 28);
+Hash256 TransactionView::hash() const {
+    crypto::Blake2bHasher hasher;
+    write_view_preimage(*this, hasher);
+    return hasher.final();
+}
 
-    // Remaining Header fields
-    block.header.gas_limit = read_uint64(offset);
-    block.header.gas_used = read_uint64(offset);
-    block.header.base_fee = read_uint64(offset);
-    block.header.timestamp = read_uint64(offset);
-    block.header.l1_block_number = read_uint64(offset);
-    block.header.batch_id = read_uint64(offset);
+void TransactionView::append_hash_preimage(Bytes& out) const {
+    AppendSink sink{out};
+    write_view_preimage(*this, sink);
+}
 
-    // Parse Transactions
-    if (offset + 4 > data.size()) return std::nullopt;
+Transaction TransactionView::materialize() const {
+    Transaction tx;
+    tx.from = from();
+    tx.to = to();
+    tx.value = value();
+    tx.nonce = nonce();
+    tx.gas_limit = gas_limit();
+    tx.max_fee_per_gas = max_fee_per_gas();
+    tx.max_priority_fee_per_gas = max_priority_fee_per_gas();
+    auto d = data();
+    tx.data.assign(d.begin(), d.end());
+    tx.sender_pubkey = sender_pubkey();
+    tx.signature = signature();
+    return tx;
+}
 
-    uint32_t tx_count = 0;
-    for (int i = 0; i < 4; ++i) {
-        tx_count = (tx_count << 8) | data[offset++];
+std::optional<BlockView> BlockView::parse(const uint8_t* data, size_t len) {
+    BlockView view;
+    view.buf_ = data;
+    view.len_ = len;
+    
+    if (len > 0 && data[0] == ENCODING_V2_MAGIC) {
+        view.encoding_ = Encoding::V2;
+        ByteReader in(data + 1, len - 1);
+        read_header(in, Encoding::V2, view.header_);
+        
+        uint64_t table_count = in.varint();
+        if (!in.ok() || table_count > in.remaining() / 28) return std::nullopt;
+        const uint8_t* table = in.take(table_count * 28);
+        
+        // Every tx needs at least a length prefix and a flags byte
+        uint64_t tx_count = in.varint();
+        if (!in.ok() || tx_count > in.remaining() / 2) return std::nullopt;
+        view.txs_.reserve(tx_count);
+        
+        for (uint64_t i = 0; i < tx_count; ++i) {
+            uint64_t body_len = in.varint();
+            if (!in.ok() || body_len > in.remaining()) return std::nullopt;
+            ByteReader body(in.take(body_len), body_len);
+            
+            auto tx = TransactionView::parse_v2(body, table, table_count);
+            if (!tx || body.remaining() != 0) return std::nullopt;
+            view.txs_.push_back(*tx);
+        }
+        
+        if (in.remaining() != 0) return std::nullopt;
+        return view;
     }
-
+    
+    ByteReader in(data, len);
+    read_header(in, Encoding::V1, view.header_);
+    uint32_t tx_count = in.u32_be();
+    if (!in.ok()) return std::nullopt;
+    
+    // Every tx needs at least its length prefix; bounds the reserve
+    if (tx_count > in.remaining() / 4) return std::nullopt;
+    view.txs_.reserve(tx_count);
+    
     for (uint32_t i = 0; i < tx_count; ++i) {
-        if (offset + 4 > data.size()) return std::nullopt;
-        uint32_t len = 0;
-        for (int k = 0; k < 4; ++k) {
-            len = (len << 8) | data[offset++];
-        }
-
-        if (offset + len > data.size()) return std::nullopt;
+        uint32_t tx_len = in.u32_be();
+        const uint8_t* tx_data = in.take(tx_len);
+        if (!tx_data) return std::nullopt;
         
-        Bytes tx_bytes(data.begin() + offset, data.begin() + offset + len);
-        auto tx = Transaction::decode(tx_bytes);
+        auto tx = TransactionView::parse_v1(tx_data, tx_len);
         if (!tx) return std::nullopt;
-        
-        block.transactions.push_back(*tx);
-        offset += len;
+        view.txs_.push_back(*tx);
     }
+    
+    return view;
+}
+
+std::vector<Hash256> BlockView::transaction_hashes() const {
+    return hash_preimages(txs_.size(), [&](size_t i, Bytes& arena) {
+        txs_[i].append_hash_preimage(arena);
+    });
+}
+
+Hash256 BlockView::compute_transactions_root() const {
+    crypto::MerkleAccumulator acc;
+    for (const auto& tx_hash : transaction_hashes()) {
+        acc.append(tx_hash);
+    }
+    return acc.root();
+}
+
+bool BlockView::verify_signatures() const {
+    return verify_signatures(transaction_hashes());
+}
 
+bool BlockView::verify_signatures(const std::vector<Hash256>& tx_hashes) const {
+    return verify_signature_set(txs_.size(),
+        [&](size_t i, Hash256& h, crypto::Ed25519::Signature& sig, crypto::Ed25519::PublicKey& pk) {
+            sig = txs_[i].signature();
+            if (is_dev_signature(sig)) return false;
+            h = tx_hashes[i];
+            pk = txs_[i].sender_pubkey();
+            return true;
+        });
+}
+
+Block BlockView::materialize() const {
+    Block block;
+    block.header = header_;
+    std::vector<TransactionPtr> txs;
+    txs.reserve(txs_.size());
+    for (const auto& tx : txs_) {
+        txs.push_back(Transaction::share(tx.materialize()));
+    }
+    block.set_transactions(std::move(txs));
     return block;
 }
 
@@ -432,35 +945,202 @@ std::optional<Block> Block::decode(const Bytes& data) {
 // ============================================================================
 
 Hash256 TransactionReceipt::hash() const {
-    std::vector<uint8_t> data;
-    data.insert(data.end(), transaction_hash.begin(), transaction_hash.end());
+    crypto::Blake2bHasher hasher;
+    hasher.update(transaction_hash);
+    hasher.update_u64_be(block_number);
+    
+    const uint8_t success_byte = success ? 1 : 0;
+    hasher.update(&success_byte, 1);
+    hasher.update_u64_be(cumulative_gas_used);
+
+    // Logs
+    for (const auto& log : logs) {
+        hasher.update(log.address.payment_credential);
+        for (const auto& topic : log.topics) {
+            hasher.update(topic);
+        }
+        hasher.update(log.data.data(), log.data.size());
+    }
+
+    if (contract_address) {
+        hasher.update(contract_address->payment_credential);
+    }
+    
+    return hasher.final();
+}
+
+// V2 flag bits for a receipt
+namespace {
+constexpr uint8_t RECEIPT_SUCCESS = 0x01;
+constexpr uint8_t RECEIPT_HAS_CONTRACT = 0x02;
+constexpr uint8_t RECEIPT_FLAGS_MASK = 0x03;
+} // namespace
+
+size_t TransactionReceipt::encoded_size(Encoding encoding) const {
+    if (encoding == Encoding::V1) {
+        size_t size = 1 + 4 * 8 + 2 * 28 + 1 + (contract_address ? 28 : 0) + 4;
+        for (const auto& log : logs) {
+            size += 28 + 1 + 32 * log.topics.size() + 4 + log.data.size();
+        }
+        return size;
+    }
     
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((block_number >> (i * 8)) & 0xFF));
+    size_t size = 2 + 2 * 28 + (contract_address ? 28 : 0);
+    for (uint64_t v : {gas_used, block_number, transaction_index, cumulative_gas_used}) {
+        size += ByteWriter::varint_size(v);
+    }
+    size += ByteWriter::varint_size(logs.size());
+    for (const auto& log : logs) {
+        size += 28 + ByteWriter::varint_size(log.topics.size()) + 32 * log.topics.size();
+        size += ByteWriter::varint_size(log.data.size()) + log.data.size();
+    }
+    return size;
+}
+
+Bytes TransactionReceipt::encode(Encoding encoding) const {
+    ByteWriter out(encoded_size(encoding));
+    
+    if (encoding == Encoding::V2) {
+        uint8_t flags = (success ? RECEIPT_SUCCESS : 0) | (contract_address ? RECEIPT_HAS_CONTRACT : 0);
+        out.u8(ENCODING_V2_MAGIC);
+        out.u8(flags);
+        out.varint(gas_used);
+        out.varint(block_number);
+        out.varint(transaction_index);
+        out.varint(cumulative_gas_used);
+        out.bytes(from.payment_credential);
+        out.bytes(to.payment_credential);
+        if (contract_address) out.bytes(contract_address->payment_credential);
+        
+        out.varint(logs.size());
+        for (const auto& log : logs) {
+            out.bytes(log.address.payment_credential);
+            out.varint(log.topics.size());
+            for (const auto& topic : log.topics) {
+                out.bytes(topic);
+            }
+            out.varint(log.data.size());
+            out.bytes(log.data);
+        }
+        return out.finish();
     }
     
-    data.push_back(success ? 1 : 0);
+    out.u8(success ? 1 : 0);
+    out.u64_be(gas_used);
+    out.u64_be(block_number);
+    out.u64_be(transaction_index);
+    out.u64_be(cumulative_gas_used);
+    out.bytes(from.payment_credential);
+    out.bytes(to.payment_credential);
     
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((cumulative_gas_used >> (i * 8)) & 0xFF));
+    // Contract address: flag byte, then 28 bytes if present
+    if (contract_address) {
+        out.u8(1);
+        out.bytes(contract_address->payment_credential);
+    } else {
+        out.u8(0);
     }
 
-    // Logs
+    out.u32_be(static_cast<uint32_t>(logs.size()));
     for (const auto& log : logs) {
-        data.insert(data.end(), log.address.payment_credential.begin(), 
-                    log.address.payment_credential.end());
+        out.bytes(log.address.payment_credential);
+        out.u8(static_cast<uint8_t>(log.topics.size()));
         for (const auto& topic : log.topics) {
-            data.insert(data.end(), topic.begin(), topic.end());
+            out.bytes(topic);
         }
-        data.insert(data.end(), log.data.begin(), log.data.end());
+        out.u32_be(static_cast<uint32_t>(log.data.size()));
+        out.bytes(log.data);
     }
+    
+    return out.finish();
+}
 
-    if (contract_address) {
-        data.insert(data.end(), contract_address->payment_credential.begin(),
-                    contract_address->payment_credential.end());
+std::optional<TransactionReceipt> TransactionReceipt::decode(const Hash256& tx_hash,
+                                                            const Bytes& data) {
+    ByteReader in(data);
+    TransactionReceipt receipt;
+    receipt.transaction_hash = tx_hash;
+    
+    if (!data.empty() && data[0] == ENCODING_V2_MAGIC) {
+        in.u8();
+        uint8_t flags = in.u8();
+        if (flags & ~RECEIPT_FLAGS_MASK) return std::nullopt;
+        
+        receipt.success = (flags & RECEIPT_SUCCESS) != 0;
+        receipt.status = receipt.success ? 1 : 0;
+        receipt.gas_used = in.varint();
+        receipt.block_number = in.varint();
+        receipt.transaction_index = in.varint();
+        receipt.cumulative_gas_used = in.varint();
+        in.bytes(receipt.from.payment_credential);
+        in.bytes(receipt.to.payment_credential);
+        if (flags & RECEIPT_HAS_CONTRACT) {
+            Address addr;
+            in.bytes(addr.payment_credential);
+            receipt.contract_address = addr;
+        }
+        
+        uint64_t log_count = in.varint();
+        if (!in.ok()) return std::nullopt;
+        
+        // Each log is at least address + topic count + data length
+        if (log_count > in.remaining() / 30) return std::nullopt;
+        receipt.logs.resize(log_count);
+        for (auto& log : receipt.logs) {
+            in.bytes(log.address.payment_credential);
+            uint64_t topic_count = in.varint();
+            if (!in.ok() || topic_count > in.remaining() / 32) return std::nullopt;
+            log.topics.resize(topic_count);
+            for (auto& topic : log.topics) {
+                in.bytes(topic);
+            }
+            
+            uint64_t data_len = in.varint();
+            if (!in.ok() || data_len > in.remaining()) return std::nullopt;
+            const uint8_t* p = in.take(data_len);
+            log.data.assign(p, p + data_len);
+        }
+        
+        if (!in.ok() || in.remaining() != 0) return std::nullopt;
+        return receipt;
     }
     
-    return crypto::Blake2b256::hash(data);
+    receipt.success = in.u8() != 0;
+    receipt.status = receipt.success ? 1 : 0;
+    receipt.gas_used = in.u64_be();
+    receipt.block_number = in.u64_be();
+    receipt.transaction_index = in.u64_be();
+    receipt.cumulative_gas_used = in.u64_be();
+    in.bytes(receipt.from.payment_credential);
+    in.bytes(receipt.to.payment_credential);
+    
+    if (in.u8()) {
+        Address addr;
+        in.bytes(addr.payment_credential);
+        receipt.contract_address = addr;
+    }
+    
+    uint32_t log_count = in.u32_be();
+    if (!in.ok()) return std::nullopt;
+    
+    // Each log is at least address + topic count + data length
+    if (log_count > in.remaining() / 33) return std::nullopt;
+    receipt.logs.resize(log_count);
+    for (auto& log : receipt.logs) {
+        in.bytes(log.address.payment_credential);
+        log.topics.resize(in.u8());
+        for (auto& topic : log.topics) {
+            in.bytes(topic);
+        }
+        
+        uint32_t data_len = in.u32_be();
+        if (const uint8_t* p = in.take(data_len)) {
+            log.data.assign(p, p + data_len);
+        }
+        if (!in.ok()) return std::nullopt;
+    }
+    
+    return receipt;
 }
 
 // ============================================================================
@@ -474,48 +1154,23 @@ bool AccountState::is_contract() const {
 }
 
 Bytes AccountState::encode() const {
-    Bytes result;
-    
-    auto append_uint64 = [&result](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
-        }
-    };
-    
-    append_uint64(nonce);
-    append_uint64(balance);
-    result.insert(result.end(), storage_root.begin(), storage_root.end());
-    result.insert(result.end(), code_hash.begin(), code_hash.end());
-    
-    return result;
+    ByteWriter out(ENCODED_SIZE);
+    out.u64_be(nonce);
+    out.u64_be(balance);
+    out.bytes(storage_root);
+    out.bytes(code_hash);
+    return out.finish();
 }
 
 AccountState AccountState::decode(const Bytes& data) {
     AccountState state;
-    if (data.size() < 80) return state;
-    
-    size_t offset = 0;
-    
-    auto read_uint64 = [&data, &offset]() -> uint64_t {
-        uint64_t v = 0;
-        for (int i = 0; i < 8 && offset < data.size(); ++i, ++offset) {
-            v = (v << 8) | data[offset];
-        }
-        return v;
-    };
-    
-    state.nonce = read_uint64();
-    state.balance = read_uint64();
-    
-    if (offset + 32 <= data.size()) {
-        std::copy(data.begin() + offset, data.begin() + offset + 32, state.storage_root.begin());
-        offset += 32;
-    }
-    
-    if (offset + 32 <= data.size()) {
-        std::copy(data.begin() + offset, data.begin() + offset + 32, state.code_hash.begin());
-    }
+    if (data.size() < ENCODED_SIZE) return state;
     
+    ByteReader in(data);
+    state.nonce = in.u64_be();
+    state.balance = in.u64_be();
+    in.bytes(state.storage_root);
+    in.bytes(state.code_hash);
     return state;
 }
 
@@ -523,38 +1178,33 @@ AccountState AccountState::decode(const Bytes& data) {
 // SettlementBatch Implementation
 // ============================================================================
 
+size_t SettlementBatch::encoded_size() const {
+    return 3 * 8 + 3 * 32 + 8 + compressed_data.size() + 8 + 32 * state_proof.size() + 1;
+}
+
 Bytes SettlementBatch::encode() const {
-    Bytes result;
-    
-    auto append_uint64 = [&result](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
-        }
-    };
+    ByteWriter out(encoded_size());
     
-    append_uint64(batch_id);
-    append_uint64(start_block);
-    append_uint64(end_block);
+    out.u64_be(batch_id);
+    out.u64_be(start_block);
+    out.u64_be(end_block);
     
-    result.insert(result.end(), pre_state_root.begin(), pre_state_root.end());
-    result.insert(result.end(), post_state_root.begin(), post_state_root.end());
-    result.insert(result.end(), transactions_root.begin(), transactions_root.end());
+    out.bytes(pre_state_root);
+    out.bytes(post_state_root);
+    out.bytes(transactions_root);
     
     // Compressed data with length prefix
-    append_uint64(compressed_data.size());
-    result.insert(result.end(), compressed_data.begin(), compressed_data.end());
+    out.prefixed(compressed_data);
     
     // State proof count and proofs
-    append_uint64(state_proof.size());
+    out.u64_be(state_proof.size());
     for (const auto& proof : state_proof) {
-        result.insert(result.end(), proof.begin(), proof.end());
+        out.bytes(proof);
     }
     
-    result.push_back(static_cast<uint8_t>(status));
+    out.u8(static_cast<uint8_t>(status));
     
-    return result;
+    return out.finish();
 }
 
-
-
 } // namespace nonagon
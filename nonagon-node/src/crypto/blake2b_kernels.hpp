@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+// Internal to nonagon_crypto: Blake2b compression kernels and CPU detection
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define NONAGON_BLAKE2B_X86 1
+#endif
+
+namespace nonagon {
+namespace crypto {
+namespace detail {
+
+extern const uint64_t blake2b_IV[8];
+extern const uint8_t blake2b_sigma[12][16];
+
+using Blake2bCompressFn = void (*)(uint64_t h[8], const uint8_t block[128],
+                                   uint64_t t0, uint64_t t1, bool is_last);
+
+// Reference implementation; every other kernel must match it bit for bit
+void blake2b_compress_scalar(uint64_t h[8], const uint8_t block[128],
+                             uint64_t t0, uint64_t t1, bool is_last);
+
+#ifdef NONAGON_BLAKE2B_X86
+void blake2b_compress_sse41(uint64_t h[8], const uint8_t block[128],
+                            uint64_t t0, uint64_t t1, bool is_last);
+void blake2b_compress_avx2(uint64_t h[8], const uint8_t block[128],
+                           uint64_t t0, uint64_t t1, bool is_last);
+
+// Multi-buffer: lane l of every state word is an independent message.
+// h is [8][lanes] row-major; all lanes finish on the same block.
+void blake2b_compress_x4_avx2(uint64_t h[8 * 4], const uint8_t* const blocks[4],
+                              const uint64_t t0[4], bool is_last);
+void blake2b_compress_x8_avx512(uint64_t h[8 * 8], const uint8_t* const blocks[8],
+                                const uint64_t t0[8], bool is_last);
+
+bool cpu_has_sse41();
+bool cpu_has_avx2();
+bool cpu_has_avx512();
+#endif
+
+} // namespace detail
+} // namespace crypto
+} // namespace nonagon
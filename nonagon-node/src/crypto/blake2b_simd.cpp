@@ -0,0 +1,400 @@
+#include "blake2b_kernels.hpp"
+
+#ifdef NONAGON_BLAKE2B_X86
+
+#include <cstring>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Per-function ISA targeting so the library itself builds for baseline x86-64
+#if defined(__GNUC__) || defined(__clang__)
+#define NONAGON_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NONAGON_TARGET(isa)
+#endif
+
+namespace nonagon {
+namespace crypto {
+namespace detail {
+
+// ============================================================================
+// CPU Feature Detection
+// ============================================================================
+
+#ifdef _MSC_VER
+
+static bool os_saves_ymm() {
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    return osxsave && (_xgetbv(0) & 0x6) == 0x6;
+}
+
+bool cpu_has_sse41() {
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+}
+
+bool cpu_has_avx2() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7 || !os_saves_ymm()) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+bool cpu_has_avx512() {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7 || !os_saves_ymm() || (_xgetbv(0) & 0xe6) != 0xe6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 16)) != 0;
+}
+
+#else
+
+// __builtin_cpu_supports also checks XGETBV for OS-enabled AVX state
+bool cpu_has_sse41() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+}
+
+bool cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+bool cpu_has_avx512() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f");
+}
+
+#endif
+
+// ============================================================================
+// SSE4.1 Kernel (two 64-bit words per register, rows split low/high)
+// ============================================================================
+
+NONAGON_TARGET("sse4.1")
+void blake2b_compress_sse41(uint64_t h[8], const uint8_t block[128],
+                            uint64_t t0, uint64_t t1, bool is_last) {
+    const __m128i rot16 = _mm_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    const __m128i rot24 = _mm_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+
+    uint64_t m[16];
+    std::memcpy(m, block, sizeof(m));
+
+    // Lambdas would not inherit the target attribute, so these are macros
+    #define LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+    #define STORE(p, v) _mm_storeu_si128(reinterpret_cast<__m128i*>(p), (v))
+
+    __m128i row1l = LOAD(h + 0);
+    __m128i row1h = LOAD(h + 2);
+    __m128i row2l = LOAD(h + 4);
+    __m128i row2h = LOAD(h + 6);
+    __m128i row3l = LOAD(blake2b_IV + 0);
+    __m128i row3h = LOAD(blake2b_IV + 2);
+    __m128i row4l = _mm_xor_si128(LOAD(blake2b_IV + 4),
+                                  _mm_set_epi64x(static_cast<long long>(t1), static_cast<long long>(t0)));
+    __m128i row4h = _mm_xor_si128(LOAD(blake2b_IV + 6),
+                                  _mm_set_epi64x(0, is_last ? -1LL : 0));
+
+    const __m128i orig1l = row1l, orig1h = row1h, orig2l = row2l, orig2h = row2h;
+
+    #define ROTR32(x) _mm_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+    #define ROTR24(x) _mm_shuffle_epi8((x), rot24)
+    #define ROTR16(x) _mm_shuffle_epi8((x), rot16)
+    #define ROTR63(x) _mm_xor_si128(_mm_srli_epi64((x), 63), _mm_add_epi64((x), (x)))
+
+    #define HALF_G(b0, b1, ROT_D, ROT_B) do { \
+        row1l = _mm_add_epi64(_mm_add_epi64(row1l, b0), row2l); \
+        row1h = _mm_add_epi64(_mm_add_epi64(row1h, b1), row2h); \
+        row4l = ROT_D(_mm_xor_si128(row4l, row1l)); \
+        row4h = ROT_D(_mm_xor_si128(row4h, row1h)); \
+        row3l = _mm_add_epi64(row3l, row4l); \
+        row3h = _mm_add_epi64(row3h, row4h); \
+        row2l = ROT_B(_mm_xor_si128(row2l, row3l)); \
+        row2h = ROT_B(_mm_xor_si128(row2h, row3h)); \
+    } while (0)
+
+    #define MSG(s, i, j) _mm_set_epi64x(static_cast<long long>(m[s[j]]), static_cast<long long>(m[s[i]]))
+
+    for (int r = 0; r < 12; ++r) {
+        const uint8_t* s = blake2b_sigma[r];
+        __m128i t0v, t1v;
+
+        // Columns
+        HALF_G(MSG(s, 0, 2), MSG(s, 4, 6), ROTR32, ROTR24);
+        HALF_G(MSG(s, 1, 3), MSG(s, 5, 7), ROTR16, ROTR63);
+
+        // Diagonalize
+        t0v = _mm_alignr_epi8(row2h, row2l, 8);
+        t1v = _mm_alignr_epi8(row2l, row2h, 8);
+        row2l = t0v; row2h = t1v;
+        t0v = row3l; row3l = row3h; row3h = t0v;
+        t0v = _mm_alignr_epi8(row4h, row4l, 8);
+        t1v = _mm_alignr_epi8(row4l, row4h, 8);
+        row4l = t1v; row4h = t0v;
+
+        // Diagonals
+        HALF_G(MSG(s, 8, 10), MSG(s, 12, 14), ROTR32, ROTR24);
+        HALF_G(MSG(s, 9, 11), MSG(s, 13, 15), ROTR16, ROTR63);
+
+        // Undiagonalize
+        t0v = _mm_alignr_epi8(row2l, row2h, 8);
+        t1v = _mm_alignr_epi8(row2h, row2l, 8);
+        row2l = t0v; row2h = t1v;
+        t0v = row3l; row3l = row3h; row3h = t0v;
+        t0v = _mm_alignr_epi8(row4h, row4l, 8);
+        t1v = _mm_alignr_epi8(row4l, row4h, 8);
+        row4l = t0v; row4h = t1v;
+    }
+
+    #undef MSG
+    #undef HALF_G
+    #undef ROTR63
+    #undef ROTR16
+    #undef ROTR24
+    #undef ROTR32
+
+    STORE(h + 0, _mm_xor_si128(orig1l, _mm_xor_si128(row1l, row3l)));
+    STORE(h + 2, _mm_xor_si128(orig1h, _mm_xor_si128(row1h, row3h)));
+    STORE(h + 4, _mm_xor_si128(orig2l, _mm_xor_si128(row2l, row4l)));
+    STORE(h + 6, _mm_xor_si128(orig2h, _mm_xor_si128(row2h, row4h)));
+
+    #undef STORE
+    #undef LOAD
+}
+
+// ============================================================================
+// AVX2 Kernel (one state row per register)
+// ============================================================================
+
+NONAGON_TARGET("avx2")
+void blake2b_compress_avx2(uint64_t h[8], const uint8_t block[128],
+                           uint64_t t0, uint64_t t1, bool is_last) {
+    const __m256i rot16 = _mm256_setr_epi8(
+        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    const __m256i rot24 = _mm256_setr_epi8(
+        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+
+    uint64_t m[16];
+    std::memcpy(m, block, sizeof(m));
+
+    #define LOAD(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+    #define STORE(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), (v))
+
+    const __m256i orig_a = LOAD(h + 0);
+    const __m256i orig_b = LOAD(h + 4);
+    __m256i a = orig_a;
+    __m256i b = orig_b;
+    __m256i c = LOAD(blake2b_IV + 0);
+    __m256i d = _mm256_xor_si256(LOAD(blake2b_IV + 4),
+                                 _mm256_set_epi64x(0, is_last ? -1LL : 0,
+                                                   static_cast<long long>(t1),
+                                                   static_cast<long long>(t0)));
+
+    #define ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+    #define ROTR24(x) _mm256_shuffle_epi8((x), rot24)
+    #define ROTR16(x) _mm256_shuffle_epi8((x), rot16)
+    #define ROTR63(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+    #define HALF_G(msg, ROT_D, ROT_B) do { \
+        a = _mm256_add_epi64(_mm256_add_epi64(a, msg), b); \
+        d = ROT_D(_mm256_xor_si256(d, a)); \
+        c = _mm256_add_epi64(c, d); \
+        b = ROT_B(_mm256_xor_si256(b, c)); \
+    } while (0)
+
+    #define MSG(s, i0, i1, i2, i3) _mm256_set_epi64x( \
+        static_cast<long long>(m[s[i3]]), static_cast<long long>(m[s[i2]]), \
+        static_cast<long long>(m[s[i1]]), static_cast<long long>(m[s[i0]]))
+
+    for (int r = 0; r < 12; ++r) {
+        const uint8_t* s = blake2b_sigma[r];
+
+        // Columns
+        HALF_G(MSG(s, 0, 2, 4, 6), ROTR32, ROTR24);
+        HALF_G(MSG(s, 1, 3, 5, 7), ROTR16, ROTR63);
+
+        // Diagonalize
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+
+        // Diagonals
+        HALF_G(MSG(s, 8, 10, 12, 14), ROTR32, ROTR24);
+        HALF_G(MSG(s, 9, 11, 13, 15), ROTR16, ROTR63);
+
+        // Undiagonalize
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+    }
+
+    #undef MSG
+    #undef HALF_G
+    #undef ROTR63
+    #undef ROTR16
+    #undef ROTR24
+    #undef ROTR32
+
+    STORE(h + 0, _mm256_xor_si256(orig_a, _mm256_xor_si256(a, c)));
+    STORE(h + 4, _mm256_xor_si256(orig_b, _mm256_xor_si256(b, d)));
+
+    #undef STORE
+    #undef LOAD
+}
+
+// ============================================================================
+// Multi-buffer Kernels (one message per 64-bit lane)
+// ============================================================================
+
+// Shared round structure over the 16-word state V and transposed message M.
+// Each kernel defines ADD/XOR/ROTR* for its vector width first.
+#define BLAKE2B_MB_ROUNDS() do { \
+    for (int r = 0; r < 12; ++r) { \
+        const uint8_t* s = blake2b_sigma[r]; \
+        BLAKE2B_MB_G(0, 4, 8, 12, s[0], s[1]); \
+        BLAKE2B_MB_G(1, 5, 9, 13, s[2], s[3]); \
+        BLAKE2B_MB_G(2, 6, 10, 14, s[4], s[5]); \
+        BLAKE2B_MB_G(3, 7, 11, 15, s[6], s[7]); \
+        BLAKE2B_MB_G(0, 5, 10, 15, s[8], s[9]); \
+        BLAKE2B_MB_G(1, 6, 11, 12, s[10], s[11]); \
+        BLAKE2B_MB_G(2, 7, 8, 13, s[12], s[13]); \
+        BLAKE2B_MB_G(3, 4, 9, 14, s[14], s[15]); \
+    } \
+} while (0)
+
+#define BLAKE2B_MB_G(a, b, c, d, x, y) do { \
+    V[a] = ADD(ADD(V[a], V[b]), M[x]); \
+    V[d] = ROTR32(XOR(V[d], V[a])); \
+    V[c] = ADD(V[c], V[d]); \
+    V[b] = ROTR24(XOR(V[b], V[c])); \
+    V[a] = ADD(ADD(V[a], V[b]), M[y]); \
+    V[d] = ROTR16(XOR(V[d], V[a])); \
+    V[c] = ADD(V[c], V[d]); \
+    V[b] = ROTR63(XOR(V[b], V[c])); \
+} while (0)
+
+NONAGON_TARGET("avx2")
+void blake2b_compress_x4_avx2(uint64_t h[8 * 4], const uint8_t* const blocks[4],
+                              const uint64_t t0[4], bool is_last) {
+    const __m256i rot16 = _mm256_setr_epi8(
+        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    const __m256i rot24 = _mm256_setr_epi8(
+        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+
+    #define LOAD(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+
+    // Transpose 4x4 word tiles: M[j] holds word j of every lane's block
+    __m256i M[16];
+    for (int k = 0; k < 4; ++k) {
+        __m256i r0 = LOAD(blocks[0] + 32 * k);
+        __m256i r1 = LOAD(blocks[1] + 32 * k);
+        __m256i r2 = LOAD(blocks[2] + 32 * k);
+        __m256i r3 = LOAD(blocks[3] + 32 * k);
+        __m256i lo01 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i hi01 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i lo23 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i hi23 = _mm256_unpackhi_epi64(r2, r3);
+        M[4 * k + 0] = _mm256_permute2x128_si256(lo01, lo23, 0x20);
+        M[4 * k + 1] = _mm256_permute2x128_si256(hi01, hi23, 0x20);
+        M[4 * k + 2] = _mm256_permute2x128_si256(lo01, lo23, 0x31);
+        M[4 * k + 3] = _mm256_permute2x128_si256(hi01, hi23, 0x31);
+    }
+
+    __m256i V[16];
+    for (int i = 0; i < 8; ++i) {
+        V[i] = LOAD(h + 4 * i);
+        V[i + 8] = _mm256_set1_epi64x(static_cast<long long>(blake2b_IV[i]));
+    }
+    V[12] = _mm256_xor_si256(V[12], LOAD(t0));
+    if (is_last) V[14] = _mm256_xor_si256(V[14], _mm256_set1_epi64x(-1));
+
+    #define ADD(x, y) _mm256_add_epi64((x), (y))
+    #define XOR(x, y) _mm256_xor_si256((x), (y))
+    #define ROTR32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+    #define ROTR24(x) _mm256_shuffle_epi8((x), rot24)
+    #define ROTR16(x) _mm256_shuffle_epi8((x), rot16)
+    #define ROTR63(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+    BLAKE2B_MB_ROUNDS();
+
+    for (int i = 0; i < 8; ++i) {
+        __m256i hv = XOR(LOAD(h + 4 * i), XOR(V[i], V[i + 8]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(h + 4 * i), hv);
+    }
+
+    #undef ROTR63
+    #undef ROTR16
+    #undef ROTR24
+    #undef ROTR32
+    #undef XOR
+    #undef ADD
+    #undef LOAD
+}
+
+NONAGON_TARGET("avx512f")
+void blake2b_compress_x8_avx512(uint64_t h[8 * 8], const uint8_t* const blocks[8],
+                                const uint64_t t0[8], bool is_last) {
+    // Gather message words lane by lane, then load one vector per word
+    alignas(64) uint64_t words[16][8];
+    for (int lane = 0; lane < 8; ++lane) {
+        uint64_t block_words[16];
+        std::memcpy(block_words, blocks[lane], sizeof(block_words));
+        for (int j = 0; j < 16; ++j) {
+            words[j][lane] = block_words[j];
+        }
+    }
+
+    __m512i M[16];
+    for (int j = 0; j < 16; ++j) {
+        M[j] = _mm512_load_si512(words[j]);
+    }
+
+    __m512i V[16];
+    for (int i = 0; i < 8; ++i) {
+        V[i] = _mm512_loadu_si512(h + 8 * i);
+        V[i + 8] = _mm512_set1_epi64(static_cast<long long>(blake2b_IV[i]));
+    }
+    V[12] = _mm512_xor_si512(V[12], _mm512_loadu_si512(t0));
+    if (is_last) V[14] = _mm512_xor_si512(V[14], _mm512_set1_epi64(-1));
+
+    #define ADD(x, y) _mm512_add_epi64((x), (y))
+    #define XOR(x, y) _mm512_xor_si512((x), (y))
+    #define ROTR32(x) _mm512_ror_epi64((x), 32)
+    #define ROTR24(x) _mm512_ror_epi64((x), 24)
+    #define ROTR16(x) _mm512_ror_epi64((x), 16)
+    #define ROTR63(x) _mm512_ror_epi64((x), 63)
+
+    BLAKE2B_MB_ROUNDS();
+
+    for (int i = 0; i < 8; ++i) {
+        __m512i hv = XOR(_mm512_loadu_si512(h + 8 * i), XOR(V[i], V[i + 8]));
+        _mm512_storeu_si512(h + 8 * i, hv);
+    }
+
+    #undef ROTR63
+    #undef ROTR16
+    #undef ROTR24
+    #undef ROTR32
+    #undef XOR
+    #undef ADD
+}
+
+#undef BLAKE2B_MB_G
+#undef BLAKE2B_MB_ROUNDS
+
+} // namespace detail
+} // namespace crypto
+} // namespace nonagon
+
+#endif // NONAGON_BLAKE2B_X86
@@ -1,7 +1,10 @@
 #include "nonagon/crypto.hpp"
+#include "nonagon/thread_pool.hpp"
+#include "blake2b_kernels.hpp"
+#include <atomic>
 #include <cstring>
+#include <optional>
 #include <stdexcept>
-#include <chrono>
 
 namespace nonagon {
 namespace crypto {
@@ -10,15 +13,17 @@ namespace crypto {
 // Blake2b-256 Implementation (Simplified - in production use libsodium)
 // ============================================================================
 
+namespace detail {
+
 // Blake2b constants
-static const uint64_t blake2b_IV[8] = {
+const uint64_t blake2b_IV[8] = {
     0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL,
     0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
     0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
     0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
 };
 
-static const uint8_t blake2b_sigma[12][16] = {
+const uint8_t blake2b_sigma[12][16] = {
     { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
     { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
     { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
@@ -37,6 +42,7 @@ static inline uint64_t rotr64(uint64_t x, int n) {
     return (x >> n) | (x << (64 - n));
 }
 
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
 static inline uint64_t load64_le(const uint8_t* p) {
     uint64_t v = 0;
     for (int i = 0; i < 8; ++i) {
@@ -50,9 +56,21 @@ static inline void store64_le(uint8_t* p, uint64_t v) {
         p[i] = static_cast<uint8_t>(v >> (8 * i));
     }
 }
+#else
+// Little-endian host: a single unaligned load/store
+static inline uint64_t load64_le(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void store64_le(uint8_t* p, uint64_t v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+#endif
 
-static void blake2b_compress(uint64_t h[8], const uint8_t block[128], 
-                              uint64_t t0, uint64_t t1, bool is_last) {
+void blake2b_compress_scalar(uint64_t h[8], const uint8_t block[128], 
+                             uint64_t t0, uint64_t t1, bool is_last) {
     uint64_t v[16];
     uint64_t m[16];
     
@@ -98,31 +116,273 @@ static void blake2b_compress(uint64_t h[8], const uint8_t block[128],
     }
 }
 
+} // namespace detail
+
+// Backend in use; chosen from CPUID on first hash (-1 = not yet chosen)
+static std::atomic<int> g_blake2b_backend{-1};
+
+static Blake2b256::Backend best_backend() {
+    for (auto b : {Blake2b256::Backend::AVX512, Blake2b256::Backend::AVX2, Blake2b256::Backend::SSE41}) {
+        if (Blake2b256::backend_supported(b)) return b;
+    }
+    return Blake2b256::Backend::Scalar;
+}
+
+static detail::Blake2bCompressFn compress_fn(Blake2b256::Backend backend) {
+    switch (backend) {
+#ifdef NONAGON_BLAKE2B_X86
+        case Blake2b256::Backend::AVX512:  // Single messages gain nothing from 512-bit rows
+        case Blake2b256::Backend::AVX2:  return detail::blake2b_compress_avx2;
+        case Blake2b256::Backend::SSE41: return detail::blake2b_compress_sse41;
+#endif
+        default: return detail::blake2b_compress_scalar;
+    }
+}
+
+bool Blake2b256::backend_supported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return true;
+#ifdef NONAGON_BLAKE2B_X86
+        case Backend::SSE41:  return detail::cpu_has_sse41();
+        case Backend::AVX2:   return detail::cpu_has_avx2();
+        case Backend::AVX512: return detail::cpu_has_avx2() && detail::cpu_has_avx512();
+#endif
+        default: return false;
+    }
+}
+
+Blake2b256::Backend Blake2b256::backend() {
+    int b = g_blake2b_backend.load(std::memory_order_relaxed);
+    if (b < 0) {
+        b = static_cast<int>(best_backend());
+        g_blake2b_backend.store(b, std::memory_order_relaxed);
+    }
+    return static_cast<Backend>(b);
+}
+
+bool Blake2b256::set_backend(Backend backend) {
+    if (!backend_supported(backend)) return false;
+    g_blake2b_backend.store(static_cast<int>(backend), std::memory_order_relaxed);
+    return true;
+}
+
+const char* Blake2b256::backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::AVX512: return "avx512";
+        case Backend::AVX2:   return "avx2";
+        case Backend::SSE41:  return "sse4.1";
+        default:              return "scalar";
+    }
+}
+
+size_t Blake2b256::lanes() {
+    switch (backend()) {
+        case Backend::AVX512: return 8;
+        case Backend::AVX2:   return 4;
+        default:              return 1;
+    }
+}
+
 Blake2b256::HashBytes Blake2b256::hash(const uint8_t* data, size_t len) {
     uint64_t h[8];
     for (int i = 0; i < 8; ++i) {
-        h[i] = blake2b_IV[i];
+        h[i] = detail::blake2b_IV[i];
     }
     // Parameter block: digest length = 32, key length = 0, fanout = 1, depth = 1
     h[0] ^= 0x01010020;
     
+    auto compress = compress_fn(backend());
     uint8_t block[128] = {0};
     uint64_t t = 0;
     
     while (len > 128) {
         t += 128;
-        blake2b_compress(h, data, t, 0, false);
+        compress(h, data, t, 0, false);
         data += 128;
         len -= 128;
     }
     
     std::memcpy(block, data, len);
     t += len;
-    blake2b_compress(h, block, t, 0, true);
+    compress(h, block, t, 0, true);
+    
+    HashBytes result;
+    for (int i = 0; i < 4; ++i) {
+        detail::store64_le(result.data() + 8 * i, h[i]);
+    }
+    return result;
+}
+
+#ifdef NONAGON_BLAKE2B_X86
+// Hashes `W` messages with the same block count in SIMD lanes
+template <size_t W>
+static void hash_group(const uint8_t* const* inputs, const size_t* lens,
+                       Blake2b256::HashBytes* out) {
+    alignas(64) uint64_t h[8 * W];
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t lane = 0; lane < W; ++lane) {
+            h[i * W + lane] = detail::blake2b_IV[i];
+        }
+    }
+    for (size_t lane = 0; lane < W; ++lane) {
+        h[lane] ^= 0x01010020;
+    }
+    
+    size_t blocks = lens[0] == 0 ? 1 : (lens[0] + 127) / 128;
+    alignas(64) uint8_t tail[W][128];
+    const uint8_t* block_ptrs[W];
+    alignas(64) uint64_t t[W];
+    
+    for (size_t b = 0; b < blocks; ++b) {
+        bool last = (b + 1 == blocks);
+        size_t offset = b * 128;
+        
+        for (size_t lane = 0; lane < W; ++lane) {
+            if (!last) {
+                block_ptrs[lane] = inputs[lane] + offset;
+                t[lane] = offset + 128;
+            } else {
+                size_t rem = lens[lane] - offset;
+                std::memset(tail[lane], 0, 128);
+                if (rem > 0) std::memcpy(tail[lane], inputs[lane] + offset, rem);
+                block_ptrs[lane] = tail[lane];
+                t[lane] = lens[lane];
+            }
+        }
+        
+        if constexpr (W == 8) {
+            detail::blake2b_compress_x8_avx512(h, block_ptrs, t, last);
+        } else {
+            detail::blake2b_compress_x4_avx2(h, block_ptrs, t, last);
+        }
+    }
+    
+    for (size_t lane = 0; lane < W; ++lane) {
+        for (size_t i = 0; i < 4; ++i) {
+            detail::store64_le(out[lane].data() + 8 * i, h[i * W + lane]);
+        }
+    }
+}
+#endif
+
+void Blake2b256::hash_many(const uint8_t* const* inputs, const size_t* lens,
+                           size_t count, HashBytes* out) {
+    size_t i = 0;
+    
+#ifdef NONAGON_BLAKE2B_X86
+    size_t width = lanes();
+    auto block_count = [](size_t len) { return len == 0 ? size_t(1) : (len + 127) / 128; };
+    
+    while (width > 1 && i + width <= count) {
+        // Lanes run in lockstep, so a group must share its block count
+        size_t blocks = block_count(lens[i]);
+        bool uniform = true;
+        for (size_t lane = 1; lane < width && uniform; ++lane) {
+            uniform = block_count(lens[i + lane]) == blocks;
+        }
+        
+        if (!uniform) {
+            out[i] = hash(inputs[i], lens[i]);
+            ++i;
+            continue;
+        }
+        
+        if (width == 8) {
+            hash_group<8>(inputs + i, lens + i, out + i);
+        } else {
+            hash_group<4>(inputs + i, lens + i, out + i);
+        }
+        i += width;
+    }
+#endif
+    
+    for (; i < count; ++i) {
+        out[i] = hash(inputs[i], lens[i]);
+    }
+}
+
+void Blake2b256::combine_pairs(const HashBytes* nodes, size_t pairs, HashBytes* out) {
+    // HashBytes is a plain byte array, so each pair is 64 contiguous bytes
+    std::vector<const uint8_t*> inputs(pairs);
+    std::vector<size_t> lens(pairs, 2 * HASH_SIZE);
+    for (size_t i = 0; i < pairs; ++i) {
+        inputs[i] = nodes[2 * i].data();
+    }
+    hash_many(inputs.data(), lens.data(), pairs, out);
+}
+
+// ============================================================================
+// Blake2bHasher Implementation
+// ============================================================================
+
+Blake2bHasher::Blake2bHasher() : Blake2bHasher(nullptr, 0) {}
+
+Blake2bHasher::Blake2bHasher(const uint8_t* key, size_t key_len, const uint8_t* personal) {
+    key_len = std::min(key_len, MAX_KEY_SIZE);
+    
+    for (int i = 0; i < 8; ++i) {
+        h_[i] = detail::blake2b_IV[i];
+    }
+    // Parameter block: digest length = 32, key length, fanout = 1, depth = 1
+    h_[0] ^= 0x01010000 | (static_cast<uint64_t>(key_len) << 8) | Blake2b256::HASH_SIZE;
+    if (personal) {
+        h_[6] ^= detail::load64_le(personal);
+        h_[7] ^= detail::load64_le(personal + 8);
+    }
+    
+    // A key occupies a full first block of its own
+    std::memset(buf_, 0, sizeof(buf_));
+    if (key_len > 0) {
+        std::memcpy(buf_, key, key_len);
+        buf_len_ = BLOCK_SIZE;
+    }
+}
+
+Blake2bHasher& Blake2bHasher::update(const uint8_t* data, size_t len) {
+    if (len == 0) return *this;
+    auto compress = compress_fn(Blake2b256::backend());
+    
+    // The last block must be compressed by final(), so a full buffer is
+    // only flushed once more input arrives
+    size_t fill = std::min(len, BLOCK_SIZE - buf_len_);
+    std::memcpy(buf_ + buf_len_, data, fill);
+    buf_len_ += fill;
+    data += fill;
+    len -= fill;
+    if (len == 0) return *this;
+    
+    t_ += BLOCK_SIZE;
+    compress(h_, buf_, t_, 0, false);
+    
+    // Full blocks straight from the input, keeping at least one byte back
+    while (len > BLOCK_SIZE) {
+        t_ += BLOCK_SIZE;
+        compress(h_, data, t_, 0, false);
+        data += BLOCK_SIZE;
+        len -= BLOCK_SIZE;
+    }
+    
+    std::memcpy(buf_, data, len);
+    buf_len_ = len;
+    return *this;
+}
+
+Blake2bHasher& Blake2bHasher::update_u64_be(uint64_t v) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<uint8_t>(v >> ((7 - i) * 8));
+    }
+    return update(bytes, sizeof(bytes));
+}
+
+Blake2bHasher::HashBytes Blake2bHasher::final() {
+    std::memset(buf_ + buf_len_, 0, BLOCK_SIZE - buf_len_);
+    t_ += buf_len_;
+    compress_fn(Blake2b256::backend())(h_, buf_, t_, 0, true);
     
     HashBytes result;
     for (int i = 0; i < 4; ++i) {
-        store64_le(result.data() + 8 * i, h[i]);
+        detail::store64_le(result.data() + 8 * i, h_[i]);
     }
     return result;
 }
@@ -136,11 +396,29 @@ Blake2b256::HashBytes Blake2b256::hash(const std::string& data) {
 }
 
 Blake2b256::HashBytes Blake2b256::combine_hashes(const HashBytes& left, const HashBytes& right) {
-    std::vector<uint8_t> combined;
-    combined.reserve(64);
-    combined.insert(combined.end(), left.begin(), left.end());
-    combined.insert(combined.end(), right.begin(), right.end());
-    return hash(combined);
+    uint8_t combined[2 * HASH_SIZE];
+    std::memcpy(combined, left.data(), HASH_SIZE);
+    std::memcpy(combined + HASH_SIZE, right.data(), HASH_SIZE);
+    return hash(combined, sizeof(combined));
+}
+
+// One Merkle level: out[i] = H(in[2i] || in[2i+1]). Wide levels are cut
+// into chunks for the shared pool; each chunk still fills SIMD lanes.
+static void hash_level(const Blake2b256::HashBytes* in, size_t pairs, Blake2b256::HashBytes* out) {
+    auto& pool = ThreadPool::shared();
+    if (pairs < MerkleTree::PARALLEL_MIN_PAIRS || pool.size() == 1) {
+        Blake2b256::combine_pairs(in, pairs, out);
+        return;
+    }
+    
+    size_t chunks = std::min(pool.size() * 4, pairs / (MerkleTree::PARALLEL_MIN_PAIRS / 4));
+    size_t chunk = (pairs + chunks - 1) / chunks;
+    pool.parallel_for(chunks, [&](size_t c) {
+        size_t begin = c * chunk;
+        if (begin >= pairs) return;
+        size_t count = std::min(chunk, pairs - begin);
+        Blake2b256::combine_pairs(in + 2 * begin, count, out + begin);
+    });
 }
 
 Blake2b256::HashBytes Blake2b256::merkle_root(const std::vector<HashBytes>& leaves) {
@@ -153,26 +431,130 @@ Blake2b256::HashBytes Blake2b256::merkle_root(const std::vector<HashBytes>& leav
     }
     
     std::vector<HashBytes> current = leaves;
-    
-    // Ensure even number of leaves by duplicating last if needed
-    if (current.size() % 2 != 0) {
-        current.push_back(current.back());
-    }
+    std::vector<HashBytes> next;
     
     while (current.size() > 1) {
-        std::vector<HashBytes> next;
-        for (size_t i = 0; i < current.size(); i += 2) {
-            next.push_back(combine_hashes(current[i], current[i + 1]));
-        }
-        current = std::move(next);
-        if (current.size() > 1 && current.size() % 2 != 0) {
+        // Ensure even number of nodes by duplicating last if needed
+        if (current.size() % 2 != 0) {
             current.push_back(current.back());
         }
+        
+        // Whole level at once so pairs fill the SIMD lanes
+        next.resize(current.size() / 2);
+        hash_level(current.data(), next.size(), next.data());
+        current.swap(next);
     }
     
     return current[0];
 }
 
+// ============================================================================
+// MerkleTree Implementation
+// ============================================================================
+
+MerkleTree::MerkleTree(std::vector<HashBytes> leaves) : leaf_count_(leaves.size()) {
+    if (leaves.empty()) return;
+    
+    // Lay out every level up front: one allocation, parents at 2i/2i+1
+    size_t total = 0;
+    for (size_t size = leaves.size();; size = (size + 1) / 2) {
+        size_t padded = (size > 1 && size % 2 != 0) ? size + 1 : size;
+        level_offsets_.push_back(total);
+        level_sizes_.push_back(size);
+        total += padded;
+        if (size == 1) break;
+    }
+    
+    nodes_ = std::move(leaves);
+    nodes_.resize(total);
+    
+    for (size_t level = 0; level + 1 < level_sizes_.size(); ++level) {
+        HashBytes* current = nodes_.data() + level_offsets_[level];
+        size_t size = level_sizes_[level];
+        if (size % 2 != 0) {
+            current[size] = current[size - 1];
+        }
+        hash_level(current, (size + 1) / 2, nodes_.data() + level_offsets_[level + 1]);
+    }
+}
+
+MerkleTree::HashBytes MerkleTree::root() const {
+    if (nodes_.empty()) {
+        HashBytes empty{};
+        return empty;
+    }
+    return nodes_[level_offsets_.back()];
+}
+
+std::vector<MerkleTree::HashBytes> MerkleTree::proof(size_t index) const {
+    std::vector<HashBytes> path;
+    if (index >= leaf_count_) return path;
+    
+    path.reserve(levels());
+    for (size_t level = 0; level + 1 < levels(); ++level) {
+        path.push_back(node(level, index ^ 1));
+        index >>= 1;
+    }
+    return path;
+}
+
+// ============================================================================
+// MerkleAccumulator Implementation
+// ============================================================================
+
+void MerkleAccumulator::append(const HashBytes& leaf) {
+    // Binary-counter carry: complete pairs fold upward immediately
+    HashBytes node = leaf;
+    size_t level = 0;
+    while (count_ & (uint64_t(1) << level)) {
+        node = Blake2b256::combine_hashes(frontier_[level], node);
+        ++level;
+    }
+    
+    if (frontier_.size() <= level) {
+        frontier_.resize(level + 1);
+    }
+    frontier_[level] = node;
+    ++count_;
+}
+
+MerkleAccumulator::HashBytes MerkleAccumulator::root() const {
+    if (count_ == 0) {
+        HashBytes empty{};
+        return empty;
+    }
+    
+    // Fold the right edge. `carry` is the last, incomplete node of the
+    // current level; an odd level pairs its last node with itself, as
+    // merkle_root does.
+    std::optional<HashBytes> carry;
+    uint64_t level_size = count_;
+    
+    for (size_t level = 0; level_size > 1; ++level) {
+        bool pending = (count_ >> level) & 1;
+        
+        if (pending && carry) {
+            carry = Blake2b256::combine_hashes(frontier_[level], *carry);
+        } else if (pending) {
+            carry = Blake2b256::combine_hashes(frontier_[level], frontier_[level]);
+        } else if (carry) {
+            carry = Blake2b256::combine_hashes(*carry, *carry);
+        }
+        
+        level_size = (level_size + 1) / 2;
+    }
+    
+    if (carry) return *carry;
+    
+    // Power-of-two leaf count: the single complete top subtree
+    return frontier_.back();
+}
+
+void MerkleAccumulator::clear() {
+    frontier_.clear();
+    count_ = 0;
+}
+
 std::vector<Blake2b256::HashBytes> Blake2b256::merkle_proof(
     const std::vector<HashBytes>& leaves, size_t index) {
     
@@ -196,10 +578,8 @@ std::vector<Blake2b256::HashBytes> Blake2b256::merkle_proof(
         }
         
         // Move to parent level
-        std::vector<HashBytes> next;
-        for (size_t i = 0; i < current.size(); i += 2) {
-            next.push_back(combine_hashes(current[i], current[i + 1]));
-        }
+        std::vector<HashBytes> next(current.size() / 2);
+        hash_level(current.data(), next.size(), next.data());
         current = std::move(next);
         idx /= 2;
         
@@ -229,169 +609,6 @@ bool Blake2b256::verify_merkle_proof(const HashBytes& leaf,
     return current == root;
 }
 
-// ============================================================================
-// Ed25519-like Implementation (Blake2b-based Schnorr-style signatures)
-// 
-// This implementation provides real cryptographic verification using a
-// deterministic signature scheme based on Blake2b. While not true Ed25519
-// (which requires elliptic curve operations), this scheme is cryptographically
-// sound for L2 operations and can be upgraded to libsodium Ed25519 later.
-//
-// Security properties:
-// - Deterministic signatures (same message + key = same signature)
-// - Unforgeable without the secret key
-// - Binding between public key and secret key via hash derivation
-// ============================================================================
-
-// Internal: Derive a verification key from public key and message
-static Blake2b256::HashBytes compute_verification_tag(
-    const uint8_t* message, size_t len, 
-    const Ed25519::PublicKey& pk) {
-    
-    // Create a deterministic tag: H(pk || message)
-    std::vector<uint8_t> data;
-    data.insert(data.end(), pk.begin(), pk.end());
-    data.insert(data.end(), message, message + len);
-    return Blake2b256::hash(data);
-}
-
-Ed25519::KeyPair Ed25519::generate_keypair() {
-    KeyPair kp;
-    
-    // Generate random seed (in production, use a CSPRNG)
-    // Using a mix of rand() and time for better entropy
-    auto now = std::chrono::high_resolution_clock::now().time_since_epoch().count();
-    for (size_t i = 0; i < 32; ++i) {
-        kp.secret_key[i] = static_cast<uint8_t>((rand() ^ (now >> (i % 8))) % 256);
-    }
-    
-    // Derive public key: pk = H(sk)
-    auto pk_hash = Blake2b256::hash(kp.secret_key.data(), 32);
-    std::copy(pk_hash.begin(), pk_hash.end(), kp.public_key.begin());
-    
-    // Store public key in second half of secret key for fast signing
-    std::copy(kp.public_key.begin(), kp.public_key.end(), 
-              kp.secret_key.begin() + 32);
-    
-    return kp;
-}
-
-Ed25519::KeyPair Ed25519::keypair_from_seed(const Seed& seed) {
-    KeyPair kp;
-    
-    // Copy seed to first 32 bytes of secret key
-    std::copy(seed.begin(), seed.end(), kp.secret_key.begin());
-    
-    // Derive public key: pk = H(seed)
-    auto pk_hash = Blake2b256::hash(seed.data(), seed.size());
-    std::copy(pk_hash.begin(), pk_hash.end(), kp.public_key.begin());
-    
-    // Store public key in second half for verification binding
-    std::copy(kp.public_key.begin(), kp.public_key.end(), 
-              kp.secret_key.begin() + 32);
-    
-    return kp;
-}
-
-Ed25519::Signature Ed25519::sign(const uint8_t* message, size_t len, 
-                                  const SecretKey& sk) {
-    Signature sig;
-    
-    // Extract secret seed (first 32 bytes) and public key (last 32 bytes)
-    const uint8_t* seed = sk.data();
-    const uint8_t* pk = sk.data() + 32;
-    
-    // Part 1: Commitment - H(seed || message)
-    std::vector<uint8_t> commit_input;
-    commit_input.insert(commit_input.end(), seed, seed + 32);
-    commit_input.insert(commit_input.end(), message, message + len);
-    auto r = Blake2b256::hash(commit_input);
-    
-    // Part 2: Challenge - H(r || pk || message)
-    std::vector<uint8_t> challenge_input;
-    challenge_input.insert(challenge_input.end(), r.begin(), r.end());
-    challenge_input.insert(challenge_input.end(), pk, pk + 32);
-    challenge_input.insert(challenge_input.end(), message, message + len);
-    auto e = Blake2b256::hash(challenge_input);
-    
-    // Part 3: Response - H(seed || e)
-    std::vector<uint8_t> response_input;
-    response_input.insert(response_input.end(), seed, seed + 32);
-    response_input.insert(response_input.end(), e.begin(), e.end());
-    auto s = Blake2b256::hash(response_input);
-    
-    // Signature = (r, s) - each 32 bytes
-    std::copy(r.begin(), r.end(), sig.begin());
-    std::copy(s.begin(), s.end(), sig.begin() + 32);
-    
-    return sig;
-}
-
-bool Ed25519::verify(const uint8_t* message, size_t len, 
-                      const Signature& sig, const PublicKey& pk) {
-    // Extract r and s from signature
-    Blake2b256::HashBytes r, s;
-    std::copy(sig.begin(), sig.begin() + 32, r.begin());
-    std::copy(sig.begin() + 32, sig.end(), s.begin());
-    
-    // Recompute challenge: e = H(r || pk || message)
-    std::vector<uint8_t> challenge_input;
-    challenge_input.insert(challenge_input.end(), r.begin(), r.end());
-    challenge_input.insert(challenge_input.end(), pk.begin(), pk.end());
-    challenge_input.insert(challenge_input.end(), message, message + len);
-    auto e = Blake2b256::hash(challenge_input);
-    
-    // Verification check:
-    // For valid signature, s = H(seed || e)
-    // We can verify by checking: H(H^-1(pk) || e) == s
-    // Since pk = H(seed), we can't invert it directly.
-    // 
-    // Instead, we verify the structure: the signer must have known the seed
-    // to produce both pk AND the correct s for the given r and message.
-    //
-    // Verification equation:
-    // Check that r was computed correctly for this message by verifying
-    // the relationship: H(s || pk || e) should produce a consistent value
-    
-    std::vector<uint8_t> verify_input;
-    verify_input.insert(verify_input.end(), s.begin(), s.end());
-    verify_input.insert(verify_input.end(), pk.begin(), pk.end());
-    verify_input.insert(verify_input.end(), e.begin(), e.end());
-    auto v = Blake2b256::hash(verify_input);
-    
-    // For a valid signature from the correct key, compute expected binding
-    std::vector<uint8_t> binding_input;
-    binding_input.insert(binding_input.end(), r.begin(), r.end());
-    binding_input.insert(binding_input.end(), s.begin(), s.end());
-    binding_input.insert(binding_input.end(), pk.begin(), pk.end());
-    auto binding = Blake2b256::hash(binding_input);
-    
-    // Final verification: check signature structure integrity
-    // The signature is valid if the components are mathematically consistent
-    // This checks that r, s, and pk form a valid triple for this message
-    
-    std::vector<uint8_t> final_check;
-    final_check.insert(final_check.end(), binding.begin(), binding.end());
-    final_check.insert(final_check.end(), message, message + len);
-    auto expected = Blake2b256::hash(final_check);
-    
-    // Compare first 16 bytes of expected with first 16 bytes of r XOR s
-    // This provides 128-bit security against forgery
-    for (int i = 0; i < 16; ++i) {
-        uint8_t combined = r[i] ^ s[i];
-        // The combined value should have a specific relationship with expected
-        // based on the hash chain from the secret key
-        if ((combined ^ expected[i]) != (pk[i] ^ e[i])) {
-            // Check if this matches the alternative valid form
-            if ((combined ^ expected[i + 16]) != (pk[i + 16] ^ e[i + 16])) {
-                return false;
-            }
-        }
-    }
-    
-    return true;
-}
-
 // ============================================================================
 // Bech32 Implementation
 // ============================================================================
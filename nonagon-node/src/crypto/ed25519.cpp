@@ -0,0 +1,1055 @@
+#include "nonagon/crypto.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <random>
+
+// RFC 8032 Ed25519 over edwards25519.
+//
+// Field elements are five 51-bit limbs in uint64_t with unsigned __int128
+// products. Points use extended twisted Edwards coordinates (X:Y:Z:T).
+// Verification is cofactored ([8]([S]B - R - [k]A) == O) so that single
+// and batch verification accept exactly the same signatures.
+
+namespace nonagon {
+namespace crypto {
+
+namespace {
+
+using u128 = unsigned __int128;
+
+// ============================================================================
+// SHA-512 (FIPS 180-4), needed by the Ed25519 key schedule and challenge
+// ============================================================================
+
+const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+inline uint64_t rotr64(uint64_t x, int n) { return (x >> n) | (x << (64 - n)); }
+
+inline uint64_t load64_be(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline void store64_be(uint8_t* p, uint64_t v) {
+    for (int i = 7; i >= 0; --i) {
+        p[i] = static_cast<uint8_t>(v);
+        v >>= 8;
+    }
+}
+
+inline uint64_t load64_le(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline void store64_le(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(v);
+        v >>= 8;
+    }
+}
+
+class Sha512 {
+public:
+    Sha512() {
+        static const uint64_t IV[8] = {
+            0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+            0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+        };
+        std::memcpy(h_, IV, sizeof(h_));
+    }
+
+    Sha512& update(const uint8_t* data, size_t len) {
+        total_ += len;
+        if (buf_len_ > 0) {
+            size_t take = std::min(len, sizeof(buf_) - buf_len_);
+            std::memcpy(buf_ + buf_len_, data, take);
+            buf_len_ += take;
+            data += take;
+            len -= take;
+            if (buf_len_ < sizeof(buf_)) return *this;
+            compress(buf_);
+            buf_len_ = 0;
+        }
+        while (len >= sizeof(buf_)) {
+            compress(data);
+            data += sizeof(buf_);
+            len -= sizeof(buf_);
+        }
+        std::memcpy(buf_, data, len);
+        buf_len_ = len;
+        return *this;
+    }
+
+    void final(uint8_t out[64]) {
+        uint64_t bits = total_ * 8;
+        buf_[buf_len_++] = 0x80;
+        if (buf_len_ > 112) {
+            std::memset(buf_ + buf_len_, 0, sizeof(buf_) - buf_len_);
+            compress(buf_);
+            buf_len_ = 0;
+        }
+        std::memset(buf_ + buf_len_, 0, 120 - buf_len_);
+        store64_be(buf_ + 120, bits);
+        compress(buf_);
+
+        for (int i = 0; i < 8; ++i) store64_be(out + 8 * i, h_[i]);
+    }
+
+private:
+    void compress(const uint8_t block[128]) {
+        uint64_t w[80];
+        for (int i = 0; i < 16; ++i) w[i] = load64_be(block + 8 * i);
+        for (int i = 16; i < 80; ++i) {
+            uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+            uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint64_t a = h_[0], b = h_[1], c = h_[2], d = h_[3];
+        uint64_t e = h_[4], f = h_[5], g = h_[6], h = h_[7];
+        for (int i = 0; i < 80; ++i) {
+            uint64_t s1 = rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41);
+            uint64_t ch = (e & f) ^ (~e & g);
+            uint64_t t1 = h + s1 + ch + SHA512_K[i] + w[i];
+            uint64_t s0 = rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39);
+            uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint64_t t2 = s0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        h_[0] += a; h_[1] += b; h_[2] += c; h_[3] += d;
+        h_[4] += e; h_[5] += f; h_[6] += g; h_[7] += h;
+    }
+
+    uint64_t h_[8];
+    uint8_t buf_[128];
+    size_t buf_len_{0};
+    uint64_t total_{0};
+};
+
+// ============================================================================
+// Field arithmetic mod p = 2^255 - 19 (radix 2^51)
+// ============================================================================
+
+constexpr uint64_t MASK51 = (1ULL << 51) - 1;
+
+struct Fe {
+    uint64_t v[5];
+};
+
+const Fe FE_ZERO = {{0, 0, 0, 0, 0}};
+const Fe FE_ONE = {{1, 0, 0, 0, 0}};
+const Fe FE_D = {{0x34dca135978a3ULL, 0x1a8283b156ebdULL, 0x5e7a26001c029ULL,
+                  0x739c663a03cbbULL, 0x52036cee2b6ffULL}};
+const Fe FE_D2 = {{0x69b9426b2f159ULL, 0x35050762add7aULL, 0x3cf44c0038052ULL,
+                   0x6738cc7407977ULL, 0x2406d9dc56dffULL}};
+const Fe FE_SQRTM1 = {{0x61b274a0ea0b0ULL, 0x0d5a5fc8f189dULL, 0x7ef5e9cbd0c60ULL,
+                       0x78595a6804c9eULL, 0x2b8324804fc1dULL}};
+
+inline void fe_carry(Fe& r) {
+    uint64_t c;
+    c = r.v[0] >> 51; r.v[0] &= MASK51; r.v[1] += c;
+    c = r.v[1] >> 51; r.v[1] &= MASK51; r.v[2] += c;
+    c = r.v[2] >> 51; r.v[2] &= MASK51; r.v[3] += c;
+    c = r.v[3] >> 51; r.v[3] &= MASK51; r.v[4] += c;
+    c = r.v[4] >> 51; r.v[4] &= MASK51; r.v[0] += c * 19;
+}
+
+// Inputs below 2^53; the result is left uncarried
+inline Fe fe_add(const Fe& a, const Fe& b) {
+    Fe r;
+    for (int i = 0; i < 5; ++i) r.v[i] = a.v[i] + b.v[i];
+    return r;
+}
+
+// a + 4p - b, so b may be up to 2^53; the result is carried
+inline Fe fe_sub(const Fe& a, const Fe& b) {
+    Fe r;
+    r.v[0] = a.v[0] + 0x1FFFFFFFFFFFB4ULL - b.v[0];
+    r.v[1] = a.v[1] + 0x1FFFFFFFFFFFFCULL - b.v[1];
+    r.v[2] = a.v[2] + 0x1FFFFFFFFFFFFCULL - b.v[2];
+    r.v[3] = a.v[3] + 0x1FFFFFFFFFFFFCULL - b.v[3];
+    r.v[4] = a.v[4] + 0x1FFFFFFFFFFFFCULL - b.v[4];
+    fe_carry(r);
+    return r;
+}
+
+inline Fe fe_neg(const Fe& a) { return fe_sub(FE_ZERO, a); }
+
+inline Fe fe_reduce_wide(u128 t0, u128 t1, u128 t2, u128 t3, u128 t4) {
+    Fe r;
+    t1 += static_cast<uint64_t>(t0 >> 51); r.v[0] = static_cast<uint64_t>(t0) & MASK51;
+    t2 += static_cast<uint64_t>(t1 >> 51); r.v[1] = static_cast<uint64_t>(t1) & MASK51;
+    t3 += static_cast<uint64_t>(t2 >> 51); r.v[2] = static_cast<uint64_t>(t2) & MASK51;
+    t4 += static_cast<uint64_t>(t3 >> 51); r.v[3] = static_cast<uint64_t>(t3) & MASK51;
+    uint64_t c = static_cast<uint64_t>(t4 >> 51); r.v[4] = static_cast<uint64_t>(t4) & MASK51;
+    r.v[0] += c * 19;
+    r.v[1] += r.v[0] >> 51;
+    r.v[0] &= MASK51;
+    return r;
+}
+
+inline Fe fe_mul(const Fe& a, const Fe& b) {
+    uint64_t b1_19 = b.v[1] * 19, b2_19 = b.v[2] * 19, b3_19 = b.v[3] * 19, b4_19 = b.v[4] * 19;
+    u128 t0 = (u128)a.v[0] * b.v[0] + (u128)a.v[1] * b4_19 + (u128)a.v[2] * b3_19
+            + (u128)a.v[3] * b2_19 + (u128)a.v[4] * b1_19;
+    u128 t1 = (u128)a.v[0] * b.v[1] + (u128)a.v[1] * b.v[0] + (u128)a.v[2] * b4_19
+            + (u128)a.v[3] * b3_19 + (u128)a.v[4] * b2_19;
+    u128 t2 = (u128)a.v[0] * b.v[2] + (u128)a.v[1] * b.v[1] + (u128)a.v[2] * b.v[0]
+            + (u128)a.v[3] * b4_19 + (u128)a.v[4] * b3_19;
+    u128 t3 = (u128)a.v[0] * b.v[3] + (u128)a.v[1] * b.v[2] + (u128)a.v[2] * b.v[1]
+            + (u128)a.v[3] * b.v[0] + (u128)a.v[4] * b4_19;
+    u128 t4 = (u128)a.v[0] * b.v[4] + (u128)a.v[1] * b.v[3] + (u128)a.v[2] * b.v[2]
+            + (u128)a.v[3] * b.v[1] + (u128)a.v[4] * b.v[0];
+    return fe_reduce_wide(t0, t1, t2, t3, t4);
+}
+
+inline Fe fe_sq(const Fe& a) {
+    uint64_t d0 = 2 * a.v[0], d1 = 2 * a.v[1];
+    uint64_t a3_19 = 19 * a.v[3], a4_19 = 19 * a.v[4];
+    u128 t0 = (u128)a.v[0] * a.v[0] + (u128)d1 * a4_19 + (u128)(2 * a.v[2]) * a3_19;
+    u128 t1 = (u128)d0 * a.v[1] + (u128)(2 * a.v[2]) * a4_19 + (u128)a.v[3] * a3_19;
+    u128 t2 = (u128)d0 * a.v[2] + (u128)a.v[1] * a.v[1] + (u128)(2 * a.v[3]) * a4_19;
+    u128 t3 = (u128)d0 * a.v[3] + (u128)d1 * a.v[2] + (u128)a.v[4] * a4_19;
+    u128 t4 = (u128)d0 * a.v[4] + (u128)d1 * a.v[3] + (u128)a.v[2] * a.v[2];
+    return fe_reduce_wide(t0, t1, t2, t3, t4);
+}
+
+inline Fe fe_sqn(Fe a, int n) {
+    for (int i = 0; i < n; ++i) a = fe_sq(a);
+    return a;
+}
+
+void fe_tobytes(uint8_t out[32], const Fe& a) {
+    Fe t = a;
+    fe_carry(t);
+    fe_carry(t);
+
+    // t < 2^255 + small; subtract p once if t >= p
+    uint64_t q = (t.v[0] + 19) >> 51;
+    q = (t.v[1] + q) >> 51;
+    q = (t.v[2] + q) >> 51;
+    q = (t.v[3] + q) >> 51;
+    q = (t.v[4] + q) >> 51;
+
+    t.v[0] += 19 * q;
+    t.v[1] += t.v[0] >> 51; t.v[0] &= MASK51;
+    t.v[2] += t.v[1] >> 51; t.v[1] &= MASK51;
+    t.v[3] += t.v[2] >> 51; t.v[2] &= MASK51;
+    t.v[4] += t.v[3] >> 51; t.v[3] &= MASK51;
+    t.v[4] &= MASK51;
+
+    store64_le(out, t.v[0] | (t.v[1] << 51));
+    store64_le(out + 8, (t.v[1] >> 13) | (t.v[2] << 38));
+    store64_le(out + 16, (t.v[2] >> 26) | (t.v[3] << 25));
+    store64_le(out + 24, (t.v[3] >> 39) | (t.v[4] << 12));
+}
+
+// Ignores bit 255
+Fe fe_frombytes(const uint8_t in[32]) {
+    uint64_t w0 = load64_le(in), w1 = load64_le(in + 8);
+    uint64_t w2 = load64_le(in + 16), w3 = load64_le(in + 24);
+    Fe r;
+    r.v[0] = w0 & MASK51;
+    r.v[1] = ((w0 >> 51) | (w1 << 13)) & MASK51;
+    r.v[2] = ((w1 >> 38) | (w2 << 26)) & MASK51;
+    r.v[3] = ((w2 >> 25) | (w3 << 39)) & MASK51;
+    r.v[4] = (w3 >> 12) & MASK51;
+    return r;
+}
+
+bool fe_iszero(const Fe& a) {
+    uint8_t s[32];
+    fe_tobytes(s, a);
+    uint8_t acc = 0;
+    for (uint8_t b : s) acc |= b;
+    return acc == 0;
+}
+
+bool fe_equal(const Fe& a, const Fe& b) { return fe_iszero(fe_sub(a, b)); }
+
+int fe_isnegative(const Fe& a) {
+    uint8_t s[32];
+    fe_tobytes(s, a);
+    return s[0] & 1;
+}
+
+// z^(2^250 - 1), with z^11 on the side for the inversion tail
+Fe fe_pow2_250_1(const Fe& z, Fe& z11) {
+    Fe z2 = fe_sq(z);
+    Fe z9 = fe_mul(fe_sqn(z2, 2), z);
+    z11 = fe_mul(z9, z2);
+    Fe z_5_0 = fe_mul(fe_sq(z11), z9);                   // 2^5 - 1
+    Fe z_10_0 = fe_mul(fe_sqn(z_5_0, 5), z_5_0);         // 2^10 - 1
+    Fe z_20_0 = fe_mul(fe_sqn(z_10_0, 10), z_10_0);      // 2^20 - 1
+    Fe z_40_0 = fe_mul(fe_sqn(z_20_0, 20), z_20_0);      // 2^40 - 1
+    Fe z_50_0 = fe_mul(fe_sqn(z_40_0, 10), z_10_0);      // 2^50 - 1
+    Fe z_100_0 = fe_mul(fe_sqn(z_50_0, 50), z_50_0);     // 2^100 - 1
+    Fe z_200_0 = fe_mul(fe_sqn(z_100_0, 100), z_100_0);  // 2^200 - 1
+    return fe_mul(fe_sqn(z_200_0, 50), z_50_0);          // 2^250 - 1
+}
+
+// z^(p - 2)
+Fe fe_invert(const Fe& z) {
+    Fe z11;
+    Fe t = fe_pow2_250_1(z, z11);
+    return fe_mul(fe_sqn(t, 5), z11);
+}
+
+// z^((p - 5) / 8) = z^(2^252 - 3)
+Fe fe_pow22523(const Fe& z) {
+    Fe z11;
+    Fe t = fe_pow2_250_1(z, z11);
+    return fe_mul(fe_sqn(t, 2), z);
+}
+
+// ============================================================================
+// Group arithmetic (extended coordinates, a = -1)
+// ============================================================================
+
+struct GeP3 {
+    Fe X, Y, Z, T;
+};
+
+// Addend form: (Y+X, Y-X, Z, 2dT)
+struct GeCached {
+    Fe YplusX, YminusX, Z, T2d;
+};
+
+const GeP3 GE_IDENTITY = {FE_ZERO, FE_ONE, FE_ONE, FE_ZERO};
+
+const GeP3 GE_BASE = {
+    {{0x62d608f25d51aULL, 0x412a4b4f6592aULL, 0x75b7171a4b31dULL, 0x1ff60527118feULL, 0x216936d3cd6e5ULL}},
+    {{0x6666666666658ULL, 0x4ccccccccccccULL, 0x1999999999999ULL, 0x3333333333333ULL, 0x6666666666666ULL}},
+    {{1, 0, 0, 0, 0}},
+    {{0x68ab3a5b7dda3ULL, 0x00eea2a5eadbbULL, 0x2af8df483c27eULL, 0x332b375274732ULL, 0x67875f0fd78b7ULL}}
+};
+
+inline GeCached ge_to_cached(const GeP3& p) {
+    return {fe_add(p.X, p.Y), fe_sub(p.Y, p.X), p.Z, fe_mul(p.T, FE_D2)};
+}
+
+inline GeP3 ge_add(const GeP3& p, const GeCached& q) {
+    Fe a = fe_mul(fe_sub(p.Y, p.X), q.YminusX);
+    Fe b = fe_mul(fe_add(p.Y, p.X), q.YplusX);
+    Fe c = fe_mul(p.T, q.T2d);
+    Fe d = fe_mul(p.Z, q.Z);
+    d = fe_add(d, d);
+    Fe e = fe_sub(b, a), f = fe_sub(d, c), g = fe_add(d, c), h = fe_add(b, a);
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline GeP3 ge_sub(const GeP3& p, const GeCached& q) {
+    Fe a = fe_mul(fe_sub(p.Y, p.X), q.YplusX);
+    Fe b = fe_mul(fe_add(p.Y, p.X), q.YminusX);
+    Fe c = fe_mul(p.T, q.T2d);
+    Fe d = fe_mul(p.Z, q.Z);
+    d = fe_add(d, d);
+    Fe e = fe_sub(b, a), f = fe_add(d, c), g = fe_sub(d, c), h = fe_add(b, a);
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline GeP3 ge_dbl(const GeP3& p) {
+    Fe a = fe_sq(p.X);
+    Fe b = fe_sq(p.Y);
+    Fe c = fe_sq(p.Z);
+    c = fe_add(c, c);
+    Fe h = fe_add(a, b);
+    Fe e = fe_sub(h, fe_sq(fe_add(p.X, p.Y)));
+    Fe g = fe_sub(a, b);
+    Fe f = fe_add(c, g);
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+inline GeP3 ge_neg(const GeP3& p) { return {fe_neg(p.X), p.Y, p.Z, fe_neg(p.T)}; }
+
+bool ge_is_identity(const GeP3& p) { return fe_iszero(p.X) && fe_equal(p.Y, p.Z); }
+
+// Cofactor clearing: [8]P
+GeP3 ge_mul_cofactor(const GeP3& p) { return ge_dbl(ge_dbl(ge_dbl(p))); }
+
+void ge_tobytes(uint8_t out[32], const GeP3& p) {
+    Fe zinv = fe_invert(p.Z);
+    Fe x = fe_mul(p.X, zinv);
+    Fe y = fe_mul(p.Y, zinv);
+    fe_tobytes(out, y);
+    out[31] ^= static_cast<uint8_t>(fe_isnegative(x) << 7);
+}
+
+// RFC 8032 5.1.3; rejects non-canonical y and points not on the curve
+bool ge_frombytes(GeP3& p, const uint8_t in[32]) {
+    Fe y = fe_frombytes(in);
+
+    uint8_t check[32];
+    fe_tobytes(check, y);
+    check[31] |= in[31] & 0x80;
+    if (std::memcmp(check, in, 32) != 0) return false;
+
+    Fe y2 = fe_sq(y);
+    Fe u = fe_sub(y2, FE_ONE);
+    Fe v = fe_add(fe_mul(y2, FE_D), FE_ONE);
+
+    // x = u v^3 (u v^7)^((p-5)/8)
+    Fe v3 = fe_mul(fe_sq(v), v);
+    Fe v7 = fe_mul(fe_sq(v3), v);
+    Fe x = fe_mul(fe_mul(u, v3), fe_pow22523(fe_mul(u, v7)));
+
+    Fe vx2 = fe_mul(v, fe_sq(x));
+    if (!fe_equal(vx2, u)) {
+        if (!fe_equal(vx2, fe_neg(u))) return false;
+        x = fe_mul(x, FE_SQRTM1);
+    }
+
+    int sign = in[31] >> 7;
+    if (fe_iszero(x) && sign) return false;
+    if (fe_isnegative(x) != sign) x = fe_neg(x);
+
+    p.X = x;
+    p.Y = y;
+    p.Z = FE_ONE;
+    p.T = fe_mul(x, y);
+    return true;
+}
+
+// ============================================================================
+// Scalar arithmetic mod L = 2^252 + 27742317777372353535851937790883648493
+// ============================================================================
+
+struct Scalar {
+    uint64_t v[4];
+};
+
+const uint64_t SC_L[4] = {0x5812631a5cf5d3edULL, 0x14def9dea2f79cd6ULL, 0, 0x1000000000000000ULL};
+
+// floor(2^512 / L), for Barrett reduction with 64-bit digits
+const uint64_t SC_MU[5] = {0xed9ce5a30a2c131bULL, 0x2106215d086329a7ULL,
+                           0xffffffffffffffebULL, 0xffffffffffffffffULL, 0xf};
+
+Scalar sc_frombytes(const uint8_t in[32]) {
+    return {{load64_le(in), load64_le(in + 8), load64_le(in + 16), load64_le(in + 24)}};
+}
+
+void sc_tobytes(uint8_t out[32], const Scalar& s) {
+    for (int i = 0; i < 4; ++i) store64_le(out + 8 * i, s.v[i]);
+}
+
+bool sc_is_canonical(const Scalar& s) {
+    for (int i = 3; i >= 0; --i) {
+        if (s.v[i] < SC_L[i]) return true;
+        if (s.v[i] > SC_L[i]) return false;
+    }
+    return false;
+}
+
+// r -= L if r >= L, without branching on r
+inline void sc_sub_l_if_ge(uint64_t r[5]) {
+    uint64_t t[5];
+    uint64_t borrow = 0;
+    for (int i = 0; i < 5; ++i) {
+        uint64_t l = i < 4 ? SC_L[i] : 0;
+        u128 d = (u128)r[i] - l - borrow;
+        t[i] = static_cast<uint64_t>(d);
+        borrow = static_cast<uint64_t>(d >> 64) & 1;
+    }
+    uint64_t keep = 0 - borrow;  // all ones when r < L
+    for (int i = 0; i < 5; ++i) r[i] = (r[i] & keep) | (t[i] & ~keep);
+}
+
+// x mod L for a 512-bit x (eight little-endian digits)
+Scalar sc_reduce_wide(const uint64_t x[8]) {
+    // q3 = ((x >> 192) * mu) >> 320
+    uint64_t q2[10] = {};
+    for (int i = 0; i < 5; ++i) {
+        u128 carry = 0;
+        for (int j = 0; j < 5; ++j) {
+            u128 t = (u128)x[3 + i] * SC_MU[j] + q2[i + j] + carry;
+            q2[i + j] = static_cast<uint64_t>(t);
+            carry = t >> 64;
+        }
+        q2[i + 5] = static_cast<uint64_t>(carry);
+    }
+    const uint64_t* q3 = q2 + 5;
+
+    // r = (x - q3 * L) mod 2^320, which lands in [0, 3L)
+    uint64_t ql[5] = {};
+    for (int i = 0; i < 5; ++i) {
+        u128 carry = 0;
+        for (int j = 0; j < 4 && i + j < 5; ++j) {
+            u128 t = (u128)q3[i] * SC_L[j] + ql[i + j] + carry;
+            ql[i + j] = static_cast<uint64_t>(t);
+            carry = t >> 64;
+        }
+        if (i + 4 < 5) ql[i + 4] += static_cast<uint64_t>(carry);
+    }
+
+    uint64_t r[5];
+    uint64_t borrow = 0;
+    for (int i = 0; i < 5; ++i) {
+        u128 d = (u128)x[i] - ql[i] - borrow;
+        r[i] = static_cast<uint64_t>(d);
+        borrow = static_cast<uint64_t>(d >> 64) & 1;
+    }
+
+    sc_sub_l_if_ge(r);
+    sc_sub_l_if_ge(r);
+    return {{r[0], r[1], r[2], r[3]}};
+}
+
+Scalar sc_reduce64(const uint8_t in[64]) {
+    uint64_t x[8];
+    for (int i = 0; i < 8; ++i) x[i] = load64_le(in + 8 * i);
+    return sc_reduce_wide(x);
+}
+
+// (a * b + c) mod L. Runs on the secret scalar in sign(), so every carry
+// is propagated to the top digit whatever its value.
+Scalar sc_muladd(const Scalar& a, const Scalar& b, const Scalar& c) {
+    uint64_t x[8] = {c.v[0], c.v[1], c.v[2], c.v[3], 0, 0, 0, 0};
+    for (int i = 0; i < 4; ++i) {
+        u128 carry = 0;
+        for (int j = 0; j < 4; ++j) {
+            u128 t = (u128)a.v[i] * b.v[j] + x[i + j] + carry;
+            x[i + j] = static_cast<uint64_t>(t);
+            carry = t >> 64;
+        }
+        for (int k = i + 4; k < 8; ++k) {
+            u128 t = (u128)x[k] + carry;
+            x[k] = static_cast<uint64_t>(t);
+            carry = t >> 64;
+        }
+    }
+    return sc_reduce_wide(x);
+}
+
+const Scalar SC_ZERO = {{0, 0, 0, 0}};
+
+// ============================================================================
+// Variable-time multi-scalar multiplication
+// ============================================================================
+
+// Sliding-window NAF: odd digits in [-15, 15], at most one nonzero per 5 bits
+void sc_slide(int8_t r[256], const Scalar& s) {
+    for (int i = 0; i < 256; ++i) {
+        r[i] = static_cast<int8_t>((s.v[i >> 6] >> (i & 63)) & 1);
+    }
+
+    for (int i = 0; i < 256; ++i) {
+        if (!r[i]) continue;
+        for (int b = 1; b <= 6 && i + b < 256; ++b) {
+            if (!r[i + b]) continue;
+            if (r[i] + (r[i + b] << b) <= 15) {
+                r[i] += r[i + b] << b;
+                r[i + b] = 0;
+            } else if (r[i] - (r[i + b] << b) >= -15) {
+                r[i] -= r[i + b] << b;
+                for (int k = i + b; k < 256; ++k) {
+                    if (!r[k]) {
+                        r[k] = 1;
+                        break;
+                    }
+                    r[k] = 0;
+                }
+            } else {
+                break;
+            }
+        }
+    }
+}
+
+// P, 3P, 5P, ..., 15P
+void ge_odd_multiples(GeCached table[8], const GeP3& p) {
+    GeCached p2 = ge_to_cached(ge_dbl(p));
+    GeP3 acc = p;
+    table[0] = ge_to_cached(p);
+    for (int i = 1; i < 8; ++i) {
+        acc = ge_add(acc, p2);
+        table[i] = ge_to_cached(acc);
+    }
+}
+
+const GeCached* base_odd_multiples() {
+    static const auto table = [] {
+        std::array<GeCached, 8> t;
+        ge_odd_multiples(t.data(), GE_BASE);
+        return t;
+    }();
+    return table.data();
+}
+
+// Straus: one shared doubling chain, wNAF digits per point
+GeP3 msm_straus(const Scalar* scalars, const GeP3* points, size_t n) {
+    std::vector<GeCached> tables(8 * n);
+    std::vector<int8_t> digits(256 * n);
+    for (size_t i = 0; i < n; ++i) {
+        ge_odd_multiples(&tables[8 * i], points[i]);
+        sc_slide(&digits[256 * i], scalars[i]);
+    }
+
+    int top = 255;
+    while (top >= 0) {
+        bool any = false;
+        for (size_t i = 0; i < n && !any; ++i) any = digits[256 * i + top] != 0;
+        if (any) break;
+        --top;
+    }
+
+    GeP3 r = GE_IDENTITY;
+    for (int bit = top; bit >= 0; --bit) {
+        r = ge_dbl(r);
+        for (size_t i = 0; i < n; ++i) {
+            int8_t d = digits[256 * i + bit];
+            if (d > 0) {
+                r = ge_add(r, tables[8 * i + d / 2]);
+            } else if (d < 0) {
+                r = ge_sub(r, tables[8 * i + (-d) / 2]);
+            }
+        }
+    }
+    return r;
+}
+
+// Pippenger: signed radix-2^c digits, 2^(c-1) buckets per window
+GeP3 msm_pippenger(const Scalar* scalars, const GeP3* points, size_t n) {
+    size_t log_n = 0;
+    while ((size_t(1) << (log_n + 1)) <= n) ++log_n;
+    const int c = static_cast<int>(std::clamp<size_t>(log_n > 3 ? log_n - 3 : 1, 4, 15));
+    const int windows = (256 + c - 1) / c + 1;
+    const int64_t radix = int64_t(1) << c;
+
+    std::vector<int16_t> digits(static_cast<size_t>(windows) * n);
+    std::vector<GeCached> cached(n);
+    for (size_t i = 0; i < n; ++i) {
+        cached[i] = ge_to_cached(points[i]);
+        int64_t carry = 0;
+        for (int w = 0; w < windows; ++w) {
+            int bit = w * c;
+            int64_t window = 0;
+            if (bit < 256) {
+                int limb = bit >> 6, shift = bit & 63;
+                uint64_t bits = scalars[i].v[limb] >> shift;
+                if (shift + c > 64 && limb + 1 < 4) bits |= scalars[i].v[limb + 1] << (64 - shift);
+                window = static_cast<int64_t>(bits & (radix - 1));
+            }
+            window += carry;
+            carry = window >= radix / 2 ? 1 : 0;
+            digits[w * n + i] = static_cast<int16_t>(window - carry * radix);
+        }
+    }
+
+    std::vector<GeP3> buckets(static_cast<size_t>(radix / 2));
+    GeP3 r = GE_IDENTITY;
+    for (int w = windows - 1; w >= 0; --w) {
+        for (int k = 0; k < c; ++k) r = ge_dbl(r);
+
+        std::fill(buckets.begin(), buckets.end(), GE_IDENTITY);
+        bool any = false;
+        for (size_t i = 0; i < n; ++i) {
+            int16_t d = digits[w * n + i];
+            if (d > 0) {
+                buckets[d - 1] = ge_add(buckets[d - 1], cached[i]);
+                any = true;
+            } else if (d < 0) {
+                buckets[-d - 1] = ge_sub(buckets[-d - 1], cached[i]);
+                any = true;
+            }
+        }
+        if (!any) continue;
+
+        // sum_k k * bucket[k] as a running sum from the top bucket down
+        GeP3 running = GE_IDENTITY;
+        GeP3 sum = GE_IDENTITY;
+        for (size_t k = buckets.size(); k-- > 0;) {
+            running = ge_add(running, ge_to_cached(buckets[k]));
+            sum = ge_add(sum, ge_to_cached(running));
+        }
+        r = ge_add(r, ge_to_cached(sum));
+    }
+    return r;
+}
+
+// Below this many points Straus' shared doublings win over bucketing
+constexpr size_t PIPPENGER_MIN_POINTS = 190;
+
+GeP3 msm_vartime(const Scalar* scalars, const GeP3* points, size_t n) {
+    return n < PIPPENGER_MIN_POINTS ? msm_straus(scalars, points, n)
+                                    : msm_pippenger(scalars, points, n);
+}
+
+// [a]A + [b]B for the fixed base B
+GeP3 double_scalarmult_vartime(const Scalar& a, const GeP3& A, const Scalar& b) {
+    GeCached a_table[8];
+    ge_odd_multiples(a_table, A);
+    const GeCached* b_table = base_odd_multiples();
+
+    int8_t a_digits[256], b_digits[256];
+    sc_slide(a_digits, a);
+    sc_slide(b_digits, b);
+
+    int top = 255;
+    while (top >= 0 && !a_digits[top] && !b_digits[top]) --top;
+
+    GeP3 r = GE_IDENTITY;
+    for (int i = top; i >= 0; --i) {
+        r = ge_dbl(r);
+        if (a_digits[i] > 0) r = ge_add(r, a_table[a_digits[i] / 2]);
+        else if (a_digits[i] < 0) r = ge_sub(r, a_table[-a_digits[i] / 2]);
+        if (b_digits[i] > 0) r = ge_add(r, b_table[b_digits[i] / 2]);
+        else if (b_digits[i] < 0) r = ge_sub(r, b_table[-b_digits[i] / 2]);
+    }
+    return r;
+}
+
+// ============================================================================
+// Constant-time fixed-base multiplication (signing, key generation)
+// ============================================================================
+
+// Affine addend with Z = 1: (y+x, y-x, 2dxy)
+struct GePrecomp {
+    Fe yplusx, yminusx, xy2d;
+};
+
+// Fixed-base table: entry [i][j] = (j + 1) * 256^i * B
+using BaseTable = std::array<std::array<GePrecomp, 8>, 32>;
+
+inline GeP3 ge_madd(const GeP3& p, const GePrecomp& q) {
+    Fe a = fe_mul(fe_sub(p.Y, p.X), q.yminusx);
+    Fe b = fe_mul(fe_add(p.Y, p.X), q.yplusx);
+    Fe c = fe_mul(p.T, q.xy2d);
+    Fe d = fe_add(p.Z, p.Z);
+    Fe e = fe_sub(b, a), f = fe_sub(d, c), g = fe_add(d, c), h = fe_add(b, a);
+    return {fe_mul(e, f), fe_mul(g, h), fe_mul(f, g), fe_mul(e, h)};
+}
+
+GePrecomp ge_to_precomp(const GeP3& p) {
+    Fe zinv = fe_invert(p.Z);
+    Fe x = fe_mul(p.X, zinv);
+    Fe y = fe_mul(p.Y, zinv);
+    return {fe_add(y, x), fe_sub(y, x), fe_mul(fe_mul(x, y), FE_D2)};
+}
+
+// Built once on first use; a few hundred additions and inversions
+const BaseTable& base_table() {
+    static const BaseTable table = [] {
+        BaseTable t;
+        GeP3 row_base = GE_BASE;
+        for (auto& row : t) {
+            GeCached step = ge_to_cached(row_base);
+            GeP3 acc = row_base;
+            for (size_t j = 0; j < row.size(); ++j) {
+                row[j] = ge_to_precomp(acc);
+                acc = ge_add(acc, step);
+            }
+            for (int k = 0; k < 8; ++k) row_base = ge_dbl(row_base);
+        }
+        return t;
+    }();
+    return table;
+}
+
+// r = b ? a : r, without branching on b (b is 0 or 1)
+inline void fe_cmov(Fe& r, const Fe& a, uint64_t b) {
+    uint64_t mask = 0 - b;
+    for (int i = 0; i < 5; ++i) r.v[i] ^= mask & (r.v[i] ^ a.v[i]);
+}
+
+inline void precomp_cmov(GePrecomp& r, const GePrecomp& a, uint64_t b) {
+    fe_cmov(r.yplusx, a.yplusx, b);
+    fe_cmov(r.yminusx, a.yminusx, b);
+    fe_cmov(r.xy2d, a.xy2d, b);
+}
+
+inline uint64_t ct_equal(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(a ^ b) - 1) >> 63;
+}
+
+// digit * table[pos] for digit in [-8, 8]; reads all eight entries
+GePrecomp select_precomp(size_t pos, int8_t digit) {
+    const auto& row = base_table()[pos];
+    uint64_t negative = static_cast<uint64_t>(static_cast<int64_t>(digit)) >> 63;
+    uint32_t abs_digit = static_cast<uint32_t>(digit - ((-static_cast<int64_t>(negative) & digit) << 1));
+
+    GePrecomp t = {FE_ONE, FE_ONE, FE_ZERO};
+    for (uint32_t j = 0; j < 8; ++j) {
+        precomp_cmov(t, row[j], ct_equal(abs_digit, j + 1));
+    }
+
+    GePrecomp minus = {t.yminusx, t.yplusx, fe_neg(t.xy2d)};
+    precomp_cmov(t, minus, negative);
+    return t;
+}
+
+// [s]B with signed radix-16 digits: the odd digits first, then x16, then
+// the even digits. No branches or table indices depend on s.
+GeP3 scalarmult_base(const Scalar& s) {
+    uint8_t bytes[32];
+    sc_tobytes(bytes, s);
+
+    int8_t e[64];
+    for (int i = 0; i < 32; ++i) {
+        e[2 * i] = static_cast<int8_t>(bytes[i] & 15);
+        e[2 * i + 1] = static_cast<int8_t>(bytes[i] >> 4);
+    }
+    int8_t carry = 0;
+    for (int i = 0; i < 63; ++i) {
+        e[i] = static_cast<int8_t>(e[i] + carry);
+        carry = static_cast<int8_t>((e[i] + 8) >> 4);
+        e[i] = static_cast<int8_t>(e[i] - (carry << 4));
+    }
+    e[63] = static_cast<int8_t>(e[63] + carry);
+
+    GeP3 h = GE_IDENTITY;
+    for (int i = 1; i < 64; i += 2) {
+        h = ge_madd(h, select_precomp(i / 2, e[i]));
+    }
+    h = ge_dbl(ge_dbl(ge_dbl(ge_dbl(h))));
+    for (int i = 0; i < 64; i += 2) {
+        h = ge_madd(h, select_precomp(i / 2, e[i]));
+    }
+    return h;
+}
+
+// ============================================================================
+// Ed25519 helpers
+// ============================================================================
+
+// SHA-512(seed) -> clamped secret scalar a and nonce prefix
+void expand_seed(const uint8_t seed[32], Scalar& a, uint8_t prefix[32]) {
+    uint8_t h[64];
+    Sha512().update(seed, 32).final(h);
+    h[0] &= 248;
+    h[31] &= 127;
+    h[31] |= 64;
+    a = sc_frombytes(h);
+    std::memcpy(prefix, h + 32, 32);
+}
+
+// k = SHA-512(R || A || M) mod L
+Scalar challenge(const uint8_t R[32], const uint8_t A[32], const uint8_t* message, size_t len) {
+    uint8_t h[64];
+    Sha512().update(R, 32).update(A, 32).update(message, len).final(h);
+    return sc_reduce64(h);
+}
+
+// Per-process key for batch coefficients, so a forger cannot predict them
+const Blake2b256::HashBytes& batch_key() {
+    static const Blake2b256::HashBytes key = [] {
+        Blake2b256::HashBytes k;
+        std::random_device rd;
+        for (size_t i = 0; i < k.size(); i += 4) {
+            uint32_t word = rd();
+            std::memcpy(k.data() + i, &word, 4);
+        }
+        return k;
+    }();
+    return key;
+}
+
+} // namespace
+
+// ============================================================================
+// Ed25519
+// ============================================================================
+
+Ed25519::KeyPair Ed25519::generate_keypair() {
+    // std::random_device reads the OS CSPRNG on the supported platforms
+    std::random_device rd;
+    Seed seed;
+    for (size_t i = 0; i < seed.size(); i += 4) {
+        uint32_t word = rd();
+        std::memcpy(seed.data() + i, &word, 4);
+    }
+    return keypair_from_seed(seed);
+}
+
+Ed25519::KeyPair Ed25519::keypair_from_seed(const Seed& seed) {
+    KeyPair kp;
+
+    Scalar a;
+    uint8_t prefix[32];
+    expand_seed(seed.data(), a, prefix);
+    ge_tobytes(kp.public_key.data(), scalarmult_base(a));
+
+    // Secret key is seed || public key, as in RFC 8032 / libsodium
+    std::copy(seed.begin(), seed.end(), kp.secret_key.begin());
+    std::copy(kp.public_key.begin(), kp.public_key.end(), kp.secret_key.begin() + 32);
+
+    return kp;
+}
+
+Ed25519::Signature Ed25519::sign(const uint8_t* message, size_t len,
+                                  const SecretKey& sk) {
+    Signature sig;
+
+    Scalar a;
+    uint8_t prefix[32];
+    expand_seed(sk.data(), a, prefix);
+    const uint8_t* pk = sk.data() + 32;
+
+    // r = SHA-512(prefix || M) mod L, R = [r]B
+    uint8_t h[64];
+    Sha512().update(prefix, 32).update(message, len).final(h);
+    Scalar r = sc_reduce64(h);
+    ge_tobytes(sig.data(), scalarmult_base(r));
+
+    // S = r + k * a mod L
+    Scalar k = challenge(sig.data(), pk, message, len);
+    sc_tobytes(sig.data() + 32, sc_muladd(k, a, r));
+
+    return sig;
+}
+
+bool Ed25519::verify(const uint8_t* message, size_t len,
+                      const Signature& sig, const PublicKey& pk) {
+    Scalar s = sc_frombytes(sig.data() + 32);
+    if (!sc_is_canonical(s)) return false;
+
+    GeP3 A, R;
+    if (!ge_frombytes(A, pk.data()) || !ge_frombytes(R, sig.data())) return false;
+
+    Scalar k = challenge(sig.data(), pk.data(), message, len);
+
+    // [8]([S]B - [k]A - R) == O
+    GeP3 check = double_scalarmult_vartime(k, ge_neg(A), s);
+    check = ge_sub(check, ge_to_cached(R));
+    return ge_is_identity(ge_mul_cofactor(check));
+}
+
+bool Ed25519::verify_batch(const std::vector<BatchEntry>& entries) {
+    if (entries.empty()) return true;
+    if (entries.size() == 1) {
+        const auto& e = entries[0];
+        return verify(e.message, e.len, *e.signature, *e.public_key);
+    }
+
+    // sum(z_i S_i) B - sum(z_i) R_i - sum(z_i k_i) A_i == O, with random
+    // 128-bit z_i so that invalid signatures cannot cancel each other out
+    const size_t n = entries.size();
+    std::vector<Scalar> scalars(2 * n + 1);
+    std::vector<GeP3> points(2 * n + 1);
+
+    Blake2bHasher transcript(batch_key().data(), batch_key().size());
+    std::vector<Scalar> ks(n);
+    for (size_t i = 0; i < n; ++i) {
+        const auto& e = entries[i];
+        if (!sc_is_canonical(sc_frombytes(e.signature->data() + 32))) return false;
+
+        GeP3 A, R;
+        if (!ge_frombytes(A, e.public_key->data()) || !ge_frombytes(R, e.signature->data())) {
+            return false;
+        }
+        points[2 * i] = ge_neg(R);
+        points[2 * i + 1] = ge_neg(A);
+
+        ks[i] = challenge(e.signature->data(), e.public_key->data(), e.message, e.len);
+        transcript.update(*e.signature).update(*e.public_key);
+        transcript.update(reinterpret_cast<const uint8_t*>(ks[i].v), sizeof(ks[i].v));
+    }
+    auto seed = transcript.final();
+
+    Scalar base_scalar = SC_ZERO;
+    for (size_t i = 0; i < n; ++i) {
+        auto zh = Blake2bHasher(seed.data(), seed.size()).update_u64_be(i).final();
+        Scalar z = {{load64_le(zh.data()) | 1, load64_le(zh.data() + 8), 0, 0}};
+
+        const auto& sig = *entries[i].signature;
+        base_scalar = sc_muladd(z, sc_frombytes(sig.data() + 32), base_scalar);
+        scalars[2 * i] = z;
+        scalars[2 * i + 1] = sc_muladd(z, ks[i], SC_ZERO);
+    }
+    scalars[2 * n] = base_scalar;
+    points[2 * n] = GE_BASE;
+
+    GeP3 check = msm_vartime(scalars.data(), points.data(), scalars.size());
+    return ge_is_identity(ge_mul_cofactor(check));
+}
+
+// ============================================================================
+// SignatureCache
+// ============================================================================
+
+SignatureCache::SignatureCache(size_t capacity)
+    : shard_capacity_(std::max<size_t>(1, capacity / SHARDS)) {}
+
+SignatureCache::Key SignatureCache::key(const uint8_t* message, size_t len,
+                                        const Ed25519::Signature& sig,
+                                        const Ed25519::PublicKey& pk) {
+    return Blake2bHasher().update(message, len).update(pk).update(sig).final();
+}
+
+bool SignatureCache::contains(const Key& key) const {
+    auto& shard = shard_for(key);
+    bool found;
+    {
+        std::shared_lock lock(shard.mutex);
+        found = shard.entries.count(key) > 0;
+    }
+    (found ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void SignatureCache::insert(const Key& key) {
+    auto& shard = shard_for(key);
+    std::unique_lock lock(shard.mutex);
+    if (!shard.entries.insert(key).second) return;
+    
+    shard.order.push_back(key);
+    if (shard.order.size() > shard_capacity_) {
+        shard.entries.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+void SignatureCache::clear() {
+    for (auto& shard : shards_) {
+        std::unique_lock lock(shard.mutex);
+        shard.entries.clear();
+        shard.order.clear();
+    }
+    hits_ = 0;
+    misses_ = 0;
+}
+
+SignatureCache::Stats SignatureCache::stats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        std::shared_lock lock(shard.mutex);
+        stats.size += shard.entries.size();
+    }
+    return stats;
+}
+
+SignatureCache& SignatureCache::instance() {
+    static SignatureCache cache;
+    return cache;
+}
+
+} // namespace crypto
+} // namespace nonagon
@@ -0,0 +1,277 @@
+#include "nonagon/crypto.hpp"
+#include "keccak_kernels.hpp"
+#include <atomic>
+#include <cstring>
+
+namespace nonagon {
+namespace crypto {
+
+// ============================================================================
+// Keccak-f[1600] Permutation
+// ============================================================================
+
+namespace detail {
+
+const uint64_t keccak_round_constants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+static inline uint64_t rotl64(uint64_t x, int n) {
+    return (x << n) | (x >> (64 - n));
+}
+
+// One full round from the 25 lanes A.. into E.., named as in the Keccak
+// reference code: row b/g/k/m/s (y = 0..4), column a/e/i/o/u (x = 0..4).
+// Rho and pi are folded into which lane feeds each B. Chi runs on the
+// lane-complemented state (lanes be, bi, go, ki, mi, sa held inverted),
+// which leaves it five NOTs per round instead of 25.
+#define KECCAK_ROUND(A, E, rc) do { \
+        const uint64_t Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+        const uint64_t Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+        const uint64_t Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+        const uint64_t Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+        const uint64_t Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+        const uint64_t Da = Cu ^ rotl64(Ce, 1); \
+        const uint64_t De = Ca ^ rotl64(Ci, 1); \
+        const uint64_t Di = Ce ^ rotl64(Co, 1); \
+        const uint64_t Do = Ci ^ rotl64(Cu, 1); \
+        const uint64_t Du = Co ^ rotl64(Ca, 1); \
+        uint64_t B0, B1, B2, B3, B4; \
+        \
+        B0 = A##ba ^ Da; \
+        B1 = rotl64(A##ge ^ De, 44); \
+        B2 = rotl64(A##ki ^ Di, 43); \
+        B3 = rotl64(A##mo ^ Do, 21); \
+        B4 = rotl64(A##su ^ Du, 14); \
+        E##ba = B0 ^ (B1 | B2) ^ (rc); \
+        E##be = B1 ^ (~B2 | B3); \
+        E##bi = B2 ^ (B3 & B4); \
+        E##bo = B3 ^ (B4 | B0); \
+        E##bu = B4 ^ (B0 & B1); \
+        \
+        B0 = rotl64(A##bo ^ Do, 28); \
+        B1 = rotl64(A##gu ^ Du, 20); \
+        B2 = rotl64(A##ka ^ Da, 3); \
+        B3 = rotl64(A##me ^ De, 45); \
+        B4 = rotl64(A##si ^ Di, 61); \
+        E##ga = B0 ^ (B1 | B2); \
+        E##ge = B1 ^ (B2 & B3); \
+        E##gi = B2 ^ (B3 | ~B4); \
+        E##go = B3 ^ (B4 | B0); \
+        E##gu = B4 ^ (B0 & B1); \
+        \
+        B0 = rotl64(A##be ^ De, 1); \
+        B1 = rotl64(A##gi ^ Di, 6); \
+        B2 = rotl64(A##ko ^ Do, 25); \
+        B3 = rotl64(A##mu ^ Du, 8); \
+        B4 = rotl64(A##sa ^ Da, 18); \
+        E##ka = B0 ^ (B1 | B2); \
+        E##ke = B1 ^ (B2 & B3); \
+        E##ki = B2 ^ (~B3 & B4); \
+        E##ko = ~B3 ^ (B4 | B0); \
+        E##ku = B4 ^ (B0 & B1); \
+        \
+        B0 = rotl64(A##bu ^ Du, 27); \
+        B1 = rotl64(A##ga ^ Da, 36); \
+        B2 = rotl64(A##ke ^ De, 10); \
+        B3 = rotl64(A##mi ^ Di, 15); \
+        B4 = rotl64(A##so ^ Do, 56); \
+        E##ma = B0 ^ (B1 & B2); \
+        E##me = B1 ^ (B2 | B3); \
+        E##mi = B2 ^ (~B3 | B4); \
+        E##mo = ~B3 ^ (B4 & B0); \
+        E##mu = B4 ^ (B0 | B1); \
+        \
+        B0 = rotl64(A##bi ^ Di, 62); \
+        B1 = rotl64(A##go ^ Do, 55); \
+        B2 = rotl64(A##ku ^ Du, 39); \
+        B3 = rotl64(A##ma ^ Da, 41); \
+        B4 = rotl64(A##se ^ De, 2); \
+        E##sa = B0 ^ (~B1 & B2); \
+        E##se = ~B1 ^ (B2 | B3); \
+        E##si = B2 ^ (B3 & B4); \
+        E##so = B3 ^ (B4 | B0); \
+        E##su = B4 ^ (B0 & B1); \
+    } while (0)
+
+void keccakf1600_scalar(uint64_t st[25]) {
+    uint64_t Aba = st[0],   Abe = ~st[1],  Abi = ~st[2],  Abo = st[3],   Abu = st[4];
+    uint64_t Aga = st[5],   Age = st[6],   Agi = st[7],   Ago = ~st[8],  Agu = st[9];
+    uint64_t Aka = st[10],  Ake = st[11],  Aki = ~st[12], Ako = st[13],  Aku = st[14];
+    uint64_t Ama = st[15],  Ame = st[16],  Ami = ~st[17], Amo = st[18],  Amu = st[19];
+    uint64_t Asa = ~st[20], Ase = st[21],  Asi = st[22],  Aso = st[23],  Asu = st[24];
+    uint64_t Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;
+    uint64_t Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+
+    // Two rounds per iteration, ping-ponging between the A and E lanes
+    for (int round = 0; round < 24; round += 2) {
+        KECCAK_ROUND(A, E, keccak_round_constants[round]);
+        KECCAK_ROUND(E, A, keccak_round_constants[round + 1]);
+    }
+
+    st[0] = Aba;   st[1] = ~Abe;  st[2] = ~Abi;  st[3] = Abo;   st[4] = Abu;
+    st[5] = Aga;   st[6] = Age;   st[7] = Agi;   st[8] = ~Ago;  st[9] = Agu;
+    st[10] = Aka;  st[11] = Ake;  st[12] = ~Aki; st[13] = Ako;  st[14] = Aku;
+    st[15] = Ama;  st[16] = Ame;  st[17] = ~Ami; st[18] = Amo;  st[19] = Amu;
+    st[20] = ~Asa; st[21] = Ase;  st[22] = Asi;  st[23] = Aso;  st[24] = Asu;
+}
+
+#undef KECCAK_ROUND
+
+} // namespace detail
+
+// ============================================================================
+// Keccak-256 Sponge
+// ============================================================================
+
+// Rate in 64-bit lanes
+static constexpr size_t RATE_LANES = Keccak256::RATE / 8;
+
+static std::atomic<int> g_keccak_backend{-1};
+
+static Keccak256::Backend best_keccak_backend() {
+    return Keccak256::backend_supported(Keccak256::Backend::AVX2) ? Keccak256::Backend::AVX2
+                                                                  : Keccak256::Backend::Scalar;
+}
+
+bool Keccak256::backend_supported(Backend backend) {
+    switch (backend) {
+        case Backend::Scalar: return true;
+#ifdef NONAGON_BLAKE2B_X86
+        case Backend::AVX2:   return detail::cpu_has_avx2();
+#endif
+        default: return false;
+    }
+}
+
+Keccak256::Backend Keccak256::backend() {
+    int b = g_keccak_backend.load(std::memory_order_relaxed);
+    if (b < 0) {
+        b = static_cast<int>(best_keccak_backend());
+        g_keccak_backend.store(b, std::memory_order_relaxed);
+    }
+    return static_cast<Backend>(b);
+}
+
+bool Keccak256::set_backend(Backend backend) {
+    if (!backend_supported(backend)) return false;
+    g_keccak_backend.store(static_cast<int>(backend), std::memory_order_relaxed);
+    return true;
+}
+
+const char* Keccak256::backend_name(Backend backend) {
+    switch (backend) {
+        case Backend::AVX2: return "avx2";
+        default:            return "scalar";
+    }
+}
+
+size_t Keccak256::lanes() {
+    return backend() == Backend::AVX2 ? 4 : 1;
+}
+
+// Final block: the message tail with Keccak's pad10*1 and domain byte
+// 0x01 (SHA3-256 would use 0x06)
+static void pad_block(uint8_t block[Keccak256::RATE], const uint8_t* tail, size_t len) {
+    std::memset(block, 0, Keccak256::RATE);
+    if (len) std::memcpy(block, tail, len);
+    block[len] ^= 0x01;
+    block[Keccak256::RATE - 1] ^= 0x80;
+}
+
+Keccak256::HashBytes Keccak256::hash(const uint8_t* data, size_t len) {
+    uint64_t st[25] = {0};
+
+    while (len >= RATE) {
+        for (size_t i = 0; i < RATE_LANES; ++i) {
+            st[i] ^= detail::keccak_load64(data + 8 * i);
+        }
+        detail::keccakf1600_scalar(st);
+        data += RATE;
+        len -= RATE;
+    }
+
+    uint8_t block[RATE];
+    pad_block(block, data, len);
+    for (size_t i = 0; i < RATE_LANES; ++i) {
+        st[i] ^= detail::keccak_load64(block + 8 * i);
+    }
+    detail::keccakf1600_scalar(st);
+
+    HashBytes result;
+    for (size_t i = 0; i < 4; ++i) {
+        detail::keccak_store64(result.data() + 8 * i, st[i]);
+    }
+    return result;
+}
+
+Keccak256::HashBytes Keccak256::hash(const std::vector<uint8_t>& data) {
+    return hash(data.data(), data.size());
+}
+
+#ifdef NONAGON_BLAKE2B_X86
+// Hashes four messages with the same block count in SIMD lanes
+static void hash_group_x4(const uint8_t* const* inputs, const size_t* lens,
+                          Keccak256::HashBytes* out) {
+    alignas(32) uint64_t st[25 * 4] = {0};
+    alignas(32) uint8_t tail[4][Keccak256::RATE];
+
+    const size_t blocks = lens[0] / Keccak256::RATE + 1;
+    for (size_t b = 0; b < blocks; ++b) {
+        const bool last = (b + 1 == blocks);
+        const size_t offset = b * Keccak256::RATE;
+
+        for (size_t lane = 0; lane < 4; ++lane) {
+            const uint8_t* block = inputs[lane] + offset;
+            if (last) {
+                pad_block(tail[lane], block, lens[lane] - offset);
+                block = tail[lane];
+            }
+            for (size_t i = 0; i < RATE_LANES; ++i) {
+                st[4 * i + lane] ^= detail::keccak_load64(block + 8 * i);
+            }
+        }
+        detail::keccakf1600_x4_avx2(st);
+    }
+
+    for (size_t lane = 0; lane < 4; ++lane) {
+        for (size_t i = 0; i < 4; ++i) {
+            detail::keccak_store64(out[lane].data() + 8 * i, st[4 * i + lane]);
+        }
+    }
+}
+#endif
+
+void Keccak256::hash_many(const uint8_t* const* inputs, const size_t* lens,
+                          size_t count, HashBytes* out) {
+    size_t i = 0;
+
+#ifdef NONAGON_BLAKE2B_X86
+    if (backend() == Backend::AVX2) {
+        while (i + 4 <= count) {
+            // Lanes run in lockstep, so a group must share its block count
+            const size_t blocks = lens[i] / RATE;
+            if (lens[i + 1] / RATE != blocks || lens[i + 2] / RATE != blocks ||
+                lens[i + 3] / RATE != blocks) {
+                out[i] = hash(inputs[i], lens[i]);
+                ++i;
+                continue;
+            }
+            hash_group_x4(inputs + i, lens + i, out + i);
+            i += 4;
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = hash(inputs[i], lens[i]);
+    }
+}
+
+} // namespace crypto
+} // namespace nonagon
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "blake2b_kernels.hpp"  // x86 detection and cpu_has_avx2()
+
+// Internal to nonagon_crypto: Keccak-f[1600] permutation kernels
+
+namespace nonagon {
+namespace crypto {
+namespace detail {
+
+extern const uint64_t keccak_round_constants[24];
+
+// Lane (x, y) of the state is word x + 5y, each word little-endian.
+// Reference kernel; every other kernel must match it bit for bit.
+void keccakf1600_scalar(uint64_t state[25]);
+
+#ifdef NONAGON_BLAKE2B_X86
+// Multi-buffer: state[4 * i + l] is lane i of message l
+void keccakf1600_x4_avx2(uint64_t state[25 * 4]);
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+inline uint64_t keccak_load64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+        v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return v;
+}
+
+inline void keccak_store64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+#else
+inline uint64_t keccak_load64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void keccak_store64(uint8_t* p, uint64_t v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+#endif
+
+} // namespace detail
+} // namespace crypto
+} // namespace nonagon
@@ -0,0 +1,154 @@
+#include "keccak_kernels.hpp"
+
+#ifdef NONAGON_BLAKE2B_X86
+
+#include <immintrin.h>
+
+// Per-function ISA targeting so the library itself builds for baseline x86-64
+#if defined(__GNUC__) || defined(__clang__)
+#define NONAGON_TARGET(isa) __attribute__((target(isa)))
+#else
+#define NONAGON_TARGET(isa)
+#endif
+
+namespace nonagon {
+namespace crypto {
+namespace detail {
+
+// ============================================================================
+// AVX2 Multi-Buffer Kernel (lane l of every register is message l)
+// ============================================================================
+
+template <int N>
+NONAGON_TARGET("avx2")
+static inline __m256i rotl(__m256i x) {
+    return _mm256_or_si256(_mm256_slli_epi64(x, N), _mm256_srli_epi64(x, 64 - N));
+}
+
+// Byte-granular rotations are a single shuffle
+template <>
+NONAGON_TARGET("avx2")
+inline __m256i rotl<8>(__m256i x) {
+    const __m256i r8 = _mm256_setr_epi8(7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14,
+                                        7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14);
+    return _mm256_shuffle_epi8(x, r8);
+}
+
+template <>
+NONAGON_TARGET("avx2")
+inline __m256i rotl<56>(__m256i x) {
+    const __m256i r56 = _mm256_setr_epi8(1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8,
+                                         1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8);
+    return _mm256_shuffle_epi8(x, r56);
+}
+
+#define XOR(a, b) _mm256_xor_si256(a, b)
+// chi: a ^ (~b & c), with ANDN doing the NOT for free
+#define CHI(a, b, c) _mm256_xor_si256(a, _mm256_andnot_si256(b, c))
+
+// Same lane naming and rho/pi folding as the scalar kernel; AVX2 has ANDN,
+// so chi runs on the plain state
+#define KECCAK_ROUND_X4(A, E, rc) do { \
+        const __m256i Ca = XOR(XOR(XOR(A##ba, A##ga), XOR(A##ka, A##ma)), A##sa); \
+        const __m256i Ce = XOR(XOR(XOR(A##be, A##ge), XOR(A##ke, A##me)), A##se); \
+        const __m256i Ci = XOR(XOR(XOR(A##bi, A##gi), XOR(A##ki, A##mi)), A##si); \
+        const __m256i Co = XOR(XOR(XOR(A##bo, A##go), XOR(A##ko, A##mo)), A##so); \
+        const __m256i Cu = XOR(XOR(XOR(A##bu, A##gu), XOR(A##ku, A##mu)), A##su); \
+        const __m256i Da = XOR(Cu, rotl<1>(Ce)); \
+        const __m256i De = XOR(Ca, rotl<1>(Ci)); \
+        const __m256i Di = XOR(Ce, rotl<1>(Co)); \
+        const __m256i Do = XOR(Ci, rotl<1>(Cu)); \
+        const __m256i Du = XOR(Co, rotl<1>(Ca)); \
+        __m256i B0, B1, B2, B3, B4; \
+        \
+        B0 = XOR(A##ba, Da); \
+        B1 = rotl<44>(XOR(A##ge, De)); \
+        B2 = rotl<43>(XOR(A##ki, Di)); \
+        B3 = rotl<21>(XOR(A##mo, Do)); \
+        B4 = rotl<14>(XOR(A##su, Du)); \
+        E##ba = XOR(CHI(B0, B1, B2), _mm256_set1_epi64x(static_cast<long long>(rc))); \
+        E##be = CHI(B1, B2, B3); \
+        E##bi = CHI(B2, B3, B4); \
+        E##bo = CHI(B3, B4, B0); \
+        E##bu = CHI(B4, B0, B1); \
+        \
+        B0 = rotl<28>(XOR(A##bo, Do)); \
+        B1 = rotl<20>(XOR(A##gu, Du)); \
+        B2 = rotl<3>(XOR(A##ka, Da)); \
+        B3 = rotl<45>(XOR(A##me, De)); \
+        B4 = rotl<61>(XOR(A##si, Di)); \
+        E##ga = CHI(B0, B1, B2); \
+        E##ge = CHI(B1, B2, B3); \
+        E##gi = CHI(B2, B3, B4); \
+        E##go = CHI(B3, B4, B0); \
+        E##gu = CHI(B4, B0, B1); \
+        \
+        B0 = rotl<1>(XOR(A##be, De)); \
+        B1 = rotl<6>(XOR(A##gi, Di)); \
+        B2 = rotl<25>(XOR(A##ko, Do)); \
+        B3 = rotl<8>(XOR(A##mu, Du)); \
+        B4 = rotl<18>(XOR(A##sa, Da)); \
+        E##ka = CHI(B0, B1, B2); \
+        E##ke = CHI(B1, B2, B3); \
+        E##ki = CHI(B2, B3, B4); \
+        E##ko = CHI(B3, B4, B0); \
+        E##ku = CHI(B4, B0, B1); \
+        \
+        B0 = rotl<27>(XOR(A##bu, Du)); \
+        B1 = rotl<36>(XOR(A##ga, Da)); \
+        B2 = rotl<10>(XOR(A##ke, De)); \
+        B3 = rotl<15>(XOR(A##mi, Di)); \
+        B4 = rotl<56>(XOR(A##so, Do)); \
+        E##ma = CHI(B0, B1, B2); \
+        E##me = CHI(B1, B2, B3); \
+        E##mi = CHI(B2, B3, B4); \
+        E##mo = CHI(B3, B4, B0); \
+        E##mu = CHI(B4, B0, B1); \
+        \
+        B0 = rotl<62>(XOR(A##bi, Di)); \
+        B1 = rotl<55>(XOR(A##go, Do)); \
+        B2 = rotl<39>(XOR(A##ku, Du)); \
+        B3 = rotl<41>(XOR(A##ma, Da)); \
+        B4 = rotl<2>(XOR(A##se, De)); \
+        E##sa = CHI(B0, B1, B2); \
+        E##se = CHI(B1, B2, B3); \
+        E##si = CHI(B2, B3, B4); \
+        E##so = CHI(B3, B4, B0); \
+        E##su = CHI(B4, B0, B1); \
+    } while (0)
+
+NONAGON_TARGET("avx2")
+void keccakf1600_x4_avx2(uint64_t st[25 * 4]) {
+    auto load = [&](int i) NONAGON_TARGET("avx2") {
+        return _mm256_load_si256(reinterpret_cast<const __m256i*>(st + 4 * i));
+    };
+    __m256i Aba = load(0),  Abe = load(1),  Abi = load(2),  Abo = load(3),  Abu = load(4);
+    __m256i Aga = load(5),  Age = load(6),  Agi = load(7),  Ago = load(8),  Agu = load(9);
+    __m256i Aka = load(10), Ake = load(11), Aki = load(12), Ako = load(13), Aku = load(14);
+    __m256i Ama = load(15), Ame = load(16), Ami = load(17), Amo = load(18), Amu = load(19);
+    __m256i Asa = load(20), Ase = load(21), Asi = load(22), Aso = load(23), Asu = load(24);
+    __m256i Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;
+    __m256i Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+
+    for (int round = 0; round < 24; round += 2) {
+        KECCAK_ROUND_X4(A, E, keccak_round_constants[round]);
+        KECCAK_ROUND_X4(E, A, keccak_round_constants[round + 1]);
+    }
+
+    const __m256i out[25] = {Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu,
+                             Aka, Ake, Aki, Ako, Aku, Ama, Ame, Ami, Amo, Amu,
+                             Asa, Ase, Asi, Aso, Asu};
+    for (int i = 0; i < 25; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(st + 4 * i), out[i]);
+    }
+}
+
+#undef KECCAK_ROUND_X4
+#undef CHI
+#undef XOR
+
+} // namespace detail
+} // namespace crypto
+} // namespace nonagon
+
+#endif // NONAGON_BLAKE2B_X86
@@ -1,8 +1,21 @@
 #include "nonagon/execution.hpp"
 #include "nonagon/crypto.hpp"
+#include "nonagon/byte_io.hpp"
 #include <iostream>
+#include <algorithm>
+#include <array>
 #include <cstring>
 
+// Threaded dispatch uses the GCC/Clang labels-as-values extension; the
+// NONAGON_EVM_SWITCH_DISPATCH build option selects the portable switch
+#if !defined(NONAGON_EVM_COMPUTED_GOTO)
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NONAGON_EVM_SWITCH_DISPATCH)
+#define NONAGON_EVM_COMPUTED_GOTO 1
+#else
+#define NONAGON_EVM_COMPUTED_GOTO 0
+#endif
+#endif
+
 namespace nonagon {
 namespace execution {
 
@@ -10,12 +23,23 @@ namespace execution {
 // EVM Implementation
 // ============================================================================
 
-EVM::EVM(std::shared_ptr<storage::StateManager> state) : state_(state) {
+EVM::EVM(std::shared_ptr<storage::StateView> state) : state_(state) {
     // Register standard precompiles (addresses 1-9)
     // In production, implement each precompile
 }
 
 ExecutionResult EVM::execute_transaction(const Transaction& tx, const ExecutionContext& ctx) {
+    // Determine if contract creation or call
+    bool is_create = (tx.to.payment_credential == std::array<uint8_t, 28>{});
+    
+    // Plain transfers skip the interpreter and the per-step balance updates
+    if (!is_create) {
+        auto recipient = state_->get_account(tx.to);
+        if (recipient.code_hash == Hash256{}) {
+            return execute_transfer(tx, ctx, recipient);
+        }
+    }
+    
     ExecutionResult result;
     
     // Increment sender nonce
@@ -33,9 +57,6 @@ ExecutionResult EVM::execute_transaction(const Transaction& tx, const ExecutionC
     
     state_->sub_balance(tx.from, tx.value + gas_cost);
     
-    // Determine if contract creation or call
-    bool is_create = (tx.to.payment_credential == std::array<uint8_t, 28>{});
-    
     if (is_create) {
         result = create(tx.from, tx.data, tx.value, tx.gas_limit);
     } else {
@@ -43,9 +64,9 @@ ExecutionResult EVM::execute_transaction(const Transaction& tx, const ExecutionC
         state_->add_balance(tx.to, tx.value);
         
         // Execute contract code if present
-        auto code = state_->get_code(tx.to);
-        if (!code.empty()) {
-            result = execute_code(tx.from, tx.to, code, tx.data, 
+        auto code = load_code(tx.to);
+        if (code->size() > 0) {
+            result = execute_code(tx.from, tx.to, *code, tx.data, 
                                    tx.value, tx.gas_limit, false);
         } else {
             // Simple transfer
@@ -60,7 +81,46 @@ ExecutionResult EVM::execute_transaction(const Transaction& tx, const ExecutionC
     
     // Pay gas to sequencer
     uint64_t gas_payment = result.gas_used * tx.effective_gas_price(ctx.base_fee);
-    state_->add_balance(ctx.coinbase, gas_payment);
+    state_->credit_fee(ctx.coinbase, gas_payment);
+    
+    return result;
+}
+
+ExecutionResult EVM::execute_transfer(const Transaction& tx, const ExecutionContext& ctx,
+                                      AccountState recipient) {
+    ExecutionResult result;
+    const uint64_t gas_price = tx.effective_gas_price(ctx.base_fee);
+    const uint64_t gas_cost = tx.gas_limit * gas_price;
+    
+    // Accounts are keyed by payment credential
+    const bool self_transfer = tx.to.payment_credential == tx.from.payment_credential;
+    
+    AccountState sender = self_transfer ? recipient : state_->get_account(tx.from);
+    sender.nonce++;
+    
+    if (sender.balance < tx.value + gas_cost) {
+        // The nonce is still consumed
+        state_->set_account(tx.from, sender);
+        result.success = false;
+        result.error = "Insufficient balance";
+        return result;
+    }
+    
+    result.success = true;
+    result.gas_used = GasCosts::TRANSACTION;
+    
+    // Debit value and maximum fee, credit value, refund unused gas
+    sender.balance -= tx.value + gas_cost;
+    (self_transfer ? sender : recipient).balance += tx.value;
+    sender.balance += (tx.gas_limit - result.gas_used) * gas_price;
+    
+    state_->set_account(tx.from, sender);
+    if (!self_transfer) {
+        state_->set_account(tx.to, recipient);
+    }
+    
+    // Pay gas to sequencer, after the writes in case it is either party
+    state_->credit_fee(ctx.coinbase, result.gas_used * gas_price);
     
     return result;
 }
@@ -80,13 +140,13 @@ ExecutionResult EVM::simulate_transaction(const Transaction& tx, const Execution
 
 ExecutionResult EVM::call(const Address& from, const Address& to,
                            const Bytes& data, uint64_t gas_limit) {
-    auto code = state_->get_code(to);
-    if (code.empty()) {
+    auto code = load_code(to);
+    if (code->size() == 0) {
         return ExecutionResult{true, 0, {}, "", std::nullopt, {}, {}};
     }
     
     auto snapshot = state_->snapshot();
-    auto result = execute_code(from, to, code, data, 0, gas_limit, true);
+    auto result = execute_code(from, to, *code, data, 0, gas_limit, true);
     state_->revert(snapshot);
     
     return result;
@@ -121,7 +181,9 @@ ExecutionResult EVM::create(const Address& from, const Bytes& code,
     }
     
     // Execute constructor (init code)
-    auto init_result = execute_code(from, contract_addr, code, {}, value, gas_limit - result.gas_used, false);
+    // Init code runs once, so its analysis is not cached
+    auto init_result = execute_code(from, contract_addr, *CodeAnalysis::analyze(code), {}, value,
+                                    gas_limit - result.gas_used, false);
     
     result.gas_used += init_result.gas_used;
     
@@ -143,14 +205,427 @@ void EVM::register_precompile(const Address& addr, std::shared_ptr<Precompile> p
     precompiles_[addr.to_hex()] = precompile;
 }
 
+// ============================================================================
+// Opcode Table
+// ============================================================================
+
+// One interpreter handler per entry; several opcodes may share one
+#define NONAGON_EVM_HANDLERS(X) \
+    X(UNDEFINED) X(STOP) \
+    X(ADD) X(MUL) X(SUB) X(DIV) X(SDIV) X(MOD) X(SMOD) X(ADDMOD) X(MULMOD) X(EXP) X(SIGNEXTEND) \
+    X(LT) X(GT) X(SLT) X(SGT) X(EQ) X(ISZERO) X(AND) X(OR) X(XOR) X(NOT) X(BYTE) \
+    X(SHL) X(SHR) X(SAR) X(KECCAK256) \
+    X(ADDRESS) X(BALANCE) X(ORIGIN) X(CALLER) X(CALLVALUE) X(CALLDATALOAD) X(CALLDATASIZE) \
+    X(CALLDATACOPY) X(CODESIZE) X(CODECOPY) X(GASPRICE) X(EXTCODESIZE) X(RETURNDATASIZE) \
+    X(RETURNDATACOPY) \
+    X(BLOCKHASH) X(COINBASE) X(TIMESTAMP) X(NUMBER) X(DIFFICULTY) X(GASLIMIT) X(CHAINID) \
+    X(SELFBALANCE) X(BASEFEE) \
+    X(POP) X(MLOAD) X(MSTORE) X(MSTORE8) X(SLOAD) X(SSTORE) X(JUMP) X(JUMPI) X(PC) X(MSIZE) X(GAS) \
+    X(JUMPDEST) X(PUSH) X(DUP) X(SWAP) X(LOG) \
+    X(CREATE) X(CALL) X(CALLCODE) X(RETURN) X(DELEGATECALL) X(CREATE2) X(STATICCALL) \
+    X(REVERT) X(INVALID) X(SELFDESTRUCT)
+
+namespace {
+
+enum class Handler : uint8_t {
+#define NONAGON_EVM_ENUM(name) name,
+    NONAGON_EVM_HANDLERS(NONAGON_EVM_ENUM)
+#undef NONAGON_EVM_ENUM
+};
+
+/**
+ * @brief Static properties of one opcode
+ * 
+ * `gas` is the static cost, charged with the rest of its basic block;
+ * dynamic parts (EXP bytes, memory, calls) are charged by the handler.
+ * The stack must hold `stack_in` items, and may not exceed STACK_LIMIT
+ * after the opcode replaces them with `stack_out`. Handlers must pop and
+ * push exactly these counts, since the block checks rely on them.
+ */
+struct OpcodeInfo {
+    Handler handler{Handler::UNDEFINED};
+    uint8_t stack_in{0};
+    uint8_t stack_out{0};
+    uint16_t gas{GasCosts::BASE};
+};
+
+constexpr size_t STACK_LIMIT = EvmStack::CAPACITY;
+
+// Deepest nesting of CALL/CREATE frames; a call past it fails in the
+// caller without running
+constexpr size_t CALL_DEPTH_LIMIT = 1024;
+
+// Gas a CALL or CREATE may hand to the new frame: what was requested, but
+// never more than all but one 64th of what the caller has left (EIP-150)
+constexpr uint64_t forwarded_gas(uint64_t requested, uint64_t available) {
+    return std::min(requested, available - available / 64);
+}
+
+constexpr std::array<OpcodeInfo, 256> make_opcode_table() {
+    std::array<OpcodeInfo, 256> t{};
+    auto set = [&](uint8_t op, Handler h, uint64_t gas, uint8_t in, uint8_t out) {
+        t[op] = {h, in, out, static_cast<uint16_t>(gas)};
+    };
+    
+    set(0x00, Handler::STOP, GasCosts::ZERO, 0, 0);
+    set(0x01, Handler::ADD, GasCosts::VERYLOW, 2, 1);
+    set(0x02, Handler::MUL, GasCosts::LOW, 2, 1);
+    set(0x03, Handler::SUB, GasCosts::VERYLOW, 2, 1);
+    set(0x04, Handler::DIV, GasCosts::LOW, 2, 1);
+    set(0x05, Handler::SDIV, GasCosts::LOW, 2, 1);
+    set(0x06, Handler::MOD, GasCosts::LOW, 2, 1);
+    set(0x07, Handler::SMOD, GasCosts::LOW, 2, 1);
+    set(0x08, Handler::ADDMOD, GasCosts::MID, 3, 1);
+    set(0x09, Handler::MULMOD, GasCosts::MID, 3, 1);
+    set(0x0A, Handler::EXP, GasCosts::EXP, 2, 1);  // Plus EXPBYTE per exponent byte
+    set(0x0B, Handler::SIGNEXTEND, GasCosts::LOW, 2, 1);
+    
+    set(0x10, Handler::LT, GasCosts::VERYLOW, 2, 1);
+    set(0x11, Handler::GT, GasCosts::VERYLOW, 2, 1);
+    set(0x12, Handler::SLT, GasCosts::VERYLOW, 2, 1);
+    set(0x13, Handler::SGT, GasCosts::VERYLOW, 2, 1);
+    set(0x14, Handler::EQ, GasCosts::VERYLOW, 2, 1);
+    set(0x15, Handler::ISZERO, GasCosts::VERYLOW, 1, 1);
+    set(0x16, Handler::AND, GasCosts::VERYLOW, 2, 1);
+    set(0x17, Handler::OR, GasCosts::VERYLOW, 2, 1);
+    set(0x18, Handler::XOR, GasCosts::VERYLOW, 2, 1);
+    set(0x19, Handler::NOT, GasCosts::VERYLOW, 1, 1);
+    set(0x1A, Handler::BYTE, GasCosts::VERYLOW, 2, 1);
+    set(0x1B, Handler::SHL, GasCosts::VERYLOW, 2, 1);
+    set(0x1C, Handler::SHR, GasCosts::VERYLOW, 2, 1);
+    set(0x1D, Handler::SAR, GasCosts::VERYLOW, 2, 1);
+    set(0x20, Handler::KECCAK256, GasCosts::SHA3, 2, 1);
+    
+    // Environment and block information
+    set(0x30, Handler::ADDRESS, GasCosts::BASE, 0, 1);
+    set(0x31, Handler::BALANCE, GasCosts::BASE, 1, 1);
+    set(0x32, Handler::ORIGIN, GasCosts::BASE, 0, 1);
+    set(0x33, Handler::CALLER, GasCosts::BASE, 0, 1);
+    set(0x34, Handler::CALLVALUE, GasCosts::BASE, 0, 1);
+    set(0x35, Handler::CALLDATALOAD, GasCosts::BASE, 1, 1);
+    set(0x36, Handler::CALLDATASIZE, GasCosts::BASE, 0, 1);
+    set(0x37, Handler::CALLDATACOPY, GasCosts::BASE, 3, 0);
+    set(0x38, Handler::CODESIZE, GasCosts::BASE, 0, 1);
+    set(0x39, Handler::CODECOPY, GasCosts::BASE, 3, 0);
+    set(0x3A, Handler::GASPRICE, GasCosts::BASE, 0, 1);
+    set(0x3B, Handler::EXTCODESIZE, GasCosts::BASE, 1, 1);
+    set(0x3D, Handler::RETURNDATASIZE, GasCosts::BASE, 0, 1);
+    set(0x3E, Handler::RETURNDATACOPY, GasCosts::BASE, 3, 0);
+    set(0x40, Handler::BLOCKHASH, GasCosts::BASE, 1, 1);
+    set(0x41, Handler::COINBASE, GasCosts::BASE, 0, 1);
+    set(0x42, Handler::TIMESTAMP, GasCosts::BASE, 0, 1);
+    set(0x43, Handler::NUMBER, GasCosts::BASE, 0, 1);
+    set(0x44, Handler::DIFFICULTY, GasCosts::BASE, 0, 1);
+    set(0x45, Handler::GASLIMIT, GasCosts::BASE, 0, 1);
+    set(0x46, Handler::CHAINID, GasCosts::BASE, 0, 1);
+    set(0x47, Handler::SELFBALANCE, GasCosts::BASE, 0, 1);
+    set(0x48, Handler::BASEFEE, GasCosts::BASE, 0, 1);
+    
+    // Stack, memory, storage and flow
+    set(0x50, Handler::POP, GasCosts::BASE, 1, 0);
+    set(0x51, Handler::MLOAD, GasCosts::VERYLOW, 1, 1);
+    set(0x52, Handler::MSTORE, GasCosts::VERYLOW, 2, 0);
+    set(0x53, Handler::MSTORE8, GasCosts::VERYLOW, 2, 0);
+    set(0x54, Handler::SLOAD, GasCosts::SLOAD, 1, 1);
+    set(0x55, Handler::SSTORE, GasCosts::SSTORE_SET, 2, 0);  // Simplified
+    set(0x56, Handler::JUMP, GasCosts::MID, 1, 0);
+    set(0x57, Handler::JUMPI, GasCosts::HIGH, 2, 0);
+    set(0x58, Handler::PC, GasCosts::BASE, 0, 1);
+    set(0x59, Handler::MSIZE, GasCosts::BASE, 0, 1);
+    set(0x5A, Handler::GAS, GasCosts::BASE, 0, 1);
+    set(0x5B, Handler::JUMPDEST, 1, 0, 0);
+    
+    for (uint8_t n = 1; n <= 32; ++n) {
+        set(0x5F + n, Handler::PUSH, GasCosts::VERYLOW, 0, 1);
+    }
+    for (uint8_t n = 1; n <= 16; ++n) {
+        set(0x7F + n, Handler::DUP, GasCosts::VERYLOW, n, n + 1);
+        set(0x8F + n, Handler::SWAP, GasCosts::VERYLOW, n + 1, n + 1);
+    }
+    for (uint8_t n = 0; n <= 4; ++n) {
+        set(0xA0 + n, Handler::LOG, GasCosts::BASE, n + 2, 0);
+    }
+    
+    // System operations
+    set(0xF0, Handler::CREATE, GasCosts::BASE, 3, 1);
+    set(0xF1, Handler::CALL, GasCosts::BASE, 7, 1);
+    set(0xF2, Handler::CALLCODE, GasCosts::BASE, 7, 1);
+    set(0xF3, Handler::RETURN, GasCosts::ZERO, 2, 0);
+    set(0xF4, Handler::DELEGATECALL, GasCosts::BASE, 6, 1);
+    set(0xF5, Handler::CREATE2, GasCosts::BASE, 4, 1);
+    set(0xFA, Handler::STATICCALL, GasCosts::BASE, 6, 1);
+    set(0xFD, Handler::REVERT, GasCosts::ZERO, 2, 0);
+    set(0xFE, Handler::INVALID, GasCosts::ZERO, 0, 0);
+    set(0xFF, Handler::SELFDESTRUCT, GasCosts::SELFDESTRUCT, 1, 0);
+    return t;
+}
+
+constexpr std::array<OpcodeInfo, 256> OPCODES = make_opcode_table();
+
+constexpr uint8_t OP_JUMPDEST = 0x5B;
+
+// Instructions after which a new basic block starts. Besides jumps and
+// halts this includes the instructions that read the gas counter, which
+// must not have the rest of their block charged in advance.
+constexpr bool ends_block(Handler h) {
+    switch (h) {
+        case Handler::STOP: case Handler::JUMP: case Handler::JUMPI:
+        case Handler::RETURN: case Handler::REVERT: case Handler::INVALID:
+        case Handler::SELFDESTRUCT: case Handler::UNDEFINED:
+        case Handler::GAS: case Handler::CALL: case Handler::CALLCODE:
+        case Handler::DELEGATECALL: case Handler::STATICCALL:
+        case Handler::CREATE: case Handler::CREATE2:
+            return true;
+        default:
+            return false;
+    }
+}
+
+constexpr size_t immediate_size(uint8_t op) {
+    return (op >= 0x60 && op <= 0x7F) ? op - 0x5F : 0;
+}
+
+// A memory offset or length from the stack. Anything past 64 bits
+// saturates, which EvmMemory::expand() rejects unless the length is zero.
+constexpr uint64_t memory_operand(const uint256& v) {
+    return v.fits_u64() ? v[3] : UINT64_MAX;
+}
+
+#if NONAGON_EVM_COMPUTED_GOTO
+// Opcode -> handler label, built once from the interpreter's label list
+std::array<const void*, 256> make_jump_table(const void* const* labels) {
+    std::array<const void*, 256> table{};
+    for (size_t op = 0; op < 256; ++op) {
+        table[op] = labels[static_cast<size_t>(OPCODES[op].handler)];
+    }
+    return table;
+}
+#endif
+
+} // namespace
+
+// ============================================================================
+// Code Analysis
+// ============================================================================
+
+std::shared_ptr<const CodeAnalysis> CodeAnalysis::analyze(const Bytes& code) {
+    auto analysis = std::make_shared<CodeAnalysis>();
+    analysis->size_ = code.size();
+    analysis->code_.reserve(code.size() + PADDING);
+    analysis->code_.assign(code.begin(), code.end());
+    analysis->code_.resize(code.size() + PADDING, 0);
+    analysis->block_at_.assign(code.size() + 1, 0);
+    analysis->jumpdests_.assign((code.size() + 63) / 64, 0);
+    
+    Block block;
+    size_t start = 0;
+    int64_t height = 0;  // Relative to the block's entry height
+    auto close = [&](size_t next) {
+        analysis->block_at_[start] = static_cast<uint32_t>(analysis->blocks_.size());
+        analysis->blocks_.push_back(block);
+        block = Block{};
+        start = next;
+        height = 0;
+    };
+    
+    for (size_t pc = 0; pc < code.size();) {
+        const uint8_t op = code[pc];
+        const OpcodeInfo& info = OPCODES[op];
+        if (op == OP_JUMPDEST) {
+            analysis->jumpdests_[pc / 64] |= uint64_t(1) << (pc % 64);
+            if (pc != start) close(pc);
+        }
+        
+        block.gas += info.gas;
+        block.stack_req = static_cast<uint32_t>(
+            std::max<int64_t>(block.stack_req, info.stack_in - height));
+        height += info.stack_out - info.stack_in;
+        block.stack_growth = static_cast<uint32_t>(std::max<int64_t>(block.stack_growth, height));
+        
+        pc += 1 + immediate_size(op);
+        if (ends_block(info.handler)) close(pc);
+    }
+    close(code.size());  // Entered when the code falls off its end after a block ender
+    return analysis;
+}
+
+// ============================================================================
+// Code Cache
+// ============================================================================
+
+CodeCache::CodeCache(size_t capacity) : capacity_(std::max<size_t>(1, capacity)) {}
+
+std::shared_ptr<const CodeAnalysis> CodeCache::find(const Hash256& code_hash) const {
+    std::shared_ptr<const CodeAnalysis> found;
+    {
+        std::shared_lock lock(mutex_);
+        auto it = entries_.find(code_hash);
+        if (it != entries_.end()) found = it->second;
+    }
+    (found ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void CodeCache::insert(const Hash256& code_hash, std::shared_ptr<const CodeAnalysis> analysis) {
+    std::unique_lock lock(mutex_);
+    if (!entries_.emplace(code_hash, std::move(analysis)).second) return;
+    
+    order_.push_back(code_hash);
+    if (order_.size() > capacity_) {
+        entries_.erase(order_.front());
+        order_.pop_front();
+    }
+}
+
+void CodeCache::clear() {
+    std::unique_lock lock(mutex_);
+    entries_.clear();
+    order_.clear();
+    hits_ = 0;
+    misses_ = 0;
+}
+
+CodeCache::Stats CodeCache::stats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    std::shared_lock lock(mutex_);
+    stats.size = entries_.size();
+    return stats;
+}
+
+CodeCache& CodeCache::instance() {
+    static CodeCache cache;
+    return cache;
+}
+
+// ============================================================================
+// Memory
+// ============================================================================
+
+void EvmMemory::grow(size_t min_capacity) {
+    // Doubling keeps a run of small expansions amortised O(1) per byte
+    size_t new_capacity = (min_capacity + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    new_capacity = std::max<size_t>(new_capacity, std::min<uint64_t>(capacity_ * 2, MAX_SIZE));
+    
+    auto next = std::make_unique_for_overwrite<uint8_t[]>(new_capacity);
+    if (size_) std::memcpy(next.get(), data_.get(), size_);
+    data_ = std::move(next);
+    capacity_ = new_capacity;
+}
+
+// ============================================================================
+// Keccak Cache
+// ============================================================================
+
+KeccakCache::HashBytes KeccakCache::hash(const uint8_t* data, size_t len) {
+    static_assert(ENTRIES == 64, "the slot index is the top six bits");
+    if (len > MAX_CACHED_SIZE) return crypto::Keccak256::hash(data, len);
+    
+    // Fold the input to one word; the multiply spreads it into the top bits
+    uint64_t fold = len;
+    for (size_t i = 0; i + 8 <= len; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        fold = (fold ^ word) * 0x9E3779B97F4A7C15ULL;
+    }
+    for (size_t i = len & ~size_t(7); i < len; ++i) {
+        fold = (fold ^ data[i]) * 0x9E3779B97F4A7C15ULL;
+    }
+    Entry& entry = entries_[fold >> 58];
+    
+    if (entry.used && entry.len == len && std::memcmp(entry.input.data(), data, len) == 0) {
+        return entry.digest;
+    }
+    entry.digest = crypto::Keccak256::hash(data, len);
+    entry.used = true;
+    entry.len = static_cast<uint8_t>(len);
+    if (len) std::memcpy(entry.input.data(), data, len);
+    return entry.digest;
+}
+
+// ============================================================================
+// Frame Pool
+// ============================================================================
+
+/**
+ * @brief Free list of execution frames for the current thread
+ * 
+ * A nested CALL/CREATE takes another frame, so the pool grows to the
+ * deepest call seen on this thread and then stops allocating. Memory
+ * buffers keep their capacity between uses, up to MAX_RETAINED_MEMORY.
+ */
+class EVM::FramePool {
+public:
+    static constexpr size_t MAX_RETAINED_MEMORY = 1 << 20;
+    
+    // Returns a frame to the pool when it goes out of scope
+    class Lease {
+    public:
+        explicit Lease(FramePool& pool) : pool_(pool), frame_(pool.acquire()) {}
+        ~Lease() { pool_.release(std::move(frame_)); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        
+        ExecutionState& state() { return *frame_; }
+    
+    private:
+        FramePool& pool_;
+        std::unique_ptr<ExecutionState> frame_;
+    };
+    
+    static FramePool& local() {
+        thread_local FramePool pool;
+        return pool;
+    }
+
+private:
+    std::unique_ptr<ExecutionState> acquire() {
+        if (free_.empty()) return std::make_unique<ExecutionState>();
+        auto frame = std::move(free_.back());
+        free_.pop_back();
+        return frame;
+    }
+    
+    void release(std::unique_ptr<ExecutionState> frame) {
+        frame->stack.clear();
+        frame->memory.clear();
+        frame->return_data.clear();
+        if (frame->memory.capacity() > MAX_RETAINED_MEMORY) {
+            frame->memory.reset();
+        }
+        free_.push_back(std::move(frame));
+    }
+    
+    std::vector<std::unique_ptr<ExecutionState>> free_;
+};
+
+// ============================================================================
+// Interpreter
+// ============================================================================
+
+std::shared_ptr<const CodeAnalysis> EVM::load_code(const Address& addr) {
+    static const auto no_code = CodeAnalysis::analyze({});
+    
+    const Hash256 code_hash = state_->get_account(addr).code_hash;
+    if (code_hash == Hash256{}) return no_code;
+    
+    auto& cache = CodeCache::instance();
+    if (auto analysis = cache.find(code_hash)) return analysis;
+    
+    auto analysis = CodeAnalysis::analyze(state_->get_code(addr));
+    cache.insert(code_hash, analysis);
+    return analysis;
+}
+
 ExecutionResult EVM::execute_code(const Address& caller, const Address& address,
-                                   const Bytes& code, const Bytes& input,
+                                   const CodeAnalysis& code, const Bytes& input,
                                    uint64_t value, uint64_t gas_limit,
-                                   bool is_static) {
+                                   bool is_static, size_t depth) {
     ExecutionResult result;
     result.gas_used = 0;
     
-    if (code.empty()) {
+    if (code.size() == 0) {
         result.success = true;
         return result;
     }
@@ -161,1054 +636,947 @@ ExecutionResult EVM::execute_code(const Address& caller, const Address& address,
         return precompile_it->second->execute(input, gas_limit);
     }
     
-    // Initialize execution state
-    ExecutionState state;
-    state.memory.reserve(1024);
-    state.stack.reserve(1024);
-    state.gas_remaining = gas_limit;
-    state.pc = 0;
+    // Initialize execution state from a pooled frame
+    FramePool::Lease frame(FramePool::local());
+    ExecutionState& state = frame.state();
     state.stopped = false;
     state.reverted = false;
     
-    // Execute bytecode
-    while (!state.stopped && !state.reverted && state.pc < code.size()) {
-        uint8_t opcode = code[state.pc];
-        
-        // Check gas
-        uint64_t gas_cost = get_opcode_gas_cost(opcode);
-        if (state.gas_remaining < gas_cost) {
-            result.success = false;
-            result.error = "Out of gas";
-            result.gas_used = gas_limit;
-            return result;
-        }
-        state.gas_remaining -= gas_cost;
-        
-        // Execute opcode
-        switch (opcode) {
-            case 0x00: // STOP
+    // Execute bytecode. Gas and stack height are checked once per basic
+    // block, on entry, so handlers run without checks of their own. Each
+    // handler ends in NEXT_OP(), which dispatches the next instruction;
+    // NEXT_BLOCK() when its instruction ends a block and execution falls
+    // through into the next; or a jump to `done` once it has stopped or
+    // reverted. A block starting at a JUMPDEST is entered by that
+    // JUMPDEST's handler, however control arrived there.
+#if NONAGON_EVM_COMPUTED_GOTO
+    static const void* const labels[] = {
+#define NONAGON_EVM_LABEL(name) &&op_##name,
+        NONAGON_EVM_HANDLERS(NONAGON_EVM_LABEL)
+#undef NONAGON_EVM_LABEL
+    };
+    static const std::array<const void*, 256> jump_table = make_jump_table(labels);
+#define OPCODE(name) op_##name
+#define DISPATCH() do { opcode = code_data[pc]; goto *jump_table[opcode]; } while (0)
+#else
+#define OPCODE(name) case Handler::name
+#define DISPATCH() goto dispatch
+#endif
+#define ENTER_BLOCK(at) do { \
+        const CodeAnalysis::Block& block = code.block(at); \
+        if (gas < block.gas) goto out_of_gas; \
+        if (state.stack.size() < block.stack_req) goto stack_underflow; \
+        if (state.stack.size() + block.stack_growth > STACK_LIMIT) goto stack_overflow; \
+        gas -= block.gas; \
+    } while (0)
+#define NEXT_OP() do { ++pc; DISPATCH(); } while (0)
+#define NEXT_BLOCK() do { \
+        ++pc; \
+        if (code_data[pc] != OP_JUMPDEST) ENTER_BLOCK(pc); \
+        DISPATCH(); \
+    } while (0)
+#define CHARGE_GAS(fee) do { \
+        const uint64_t fee_ = (fee); \
+        if (gas < fee_) goto out_of_gas; \
+        gas -= fee_; \
+    } while (0)
+#define EXPAND_MEMORY(offset, len) do { \
+        if (!state.memory.expand(offset, len, gas)) goto out_of_gas; \
+    } while (0)
+#define REQUIRE_NON_STATIC() do { \
+        if (is_static) { \
+            state.reverted = true; \
+            result.error = "State modification in static call"; \
+            goto done; \
+        } \
+    } while (0)
+    
+    // The program counter and remaining gas live in locals rather than in
+    // `state`, so the compiler can keep them in registers across handlers.
+    // Code is read from the padded copy, so pc never needs a bounds check.
+    const uint8_t* const code_data = code.data();
+    size_t pc = 0;
+    uint64_t gas = gas_limit;
+    uint8_t opcode;
+    
+    if (code_data[0] != OP_JUMPDEST) ENTER_BLOCK(0);
+#if NONAGON_EVM_COMPUTED_GOTO
+    DISPATCH();
+    {
+#else
+    dispatch:
+    opcode = code_data[pc];
+    switch (OPCODES[opcode].handler) {
+#endif
+            OPCODE(STOP): {
                 state.stopped = true;
-                break;
+                goto done;
+            }
                 
-            case 0x01: // ADD
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    // 256-bit addition (simplified)
-                    uint64_t carry = 0;
-                    for (int i = 3; i >= 0; --i) {
-                        uint64_t sum = a[i] + b[i] + carry;
-                        c[i] = sum;
-                        carry = (sum < a[i]) ? 1 : 0;
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(ADD): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a + b);
+                NEXT_OP();
+            }
                 
-            case 0x02: // MUL
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};  // Simplified
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(MUL): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a * b);
+                NEXT_OP();
+            }
                 
-            case 0x03: // SUB
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    // 256-bit subtraction with borrow
-                    uint64_t borrow = 0;
-                    for (int i = 3; i >= 0; --i) {
-                        uint64_t diff = a[i] - b[i] - borrow;
-                        borrow = (a[i] < b[i] + borrow) ? 1 : 0;
-                        c[i] = diff;
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SUB): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a - b);
+                NEXT_OP();
+            }
                 
-            case 0x04: // DIV
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    // Simplified: only handles small values
-                    if (b[3] != 0) {
-                        c[3] = a[3] / b[3];
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(DIV): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a / b);
+                NEXT_OP();
+            }
                 
-            case 0x05: // SDIV (signed division)
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    // Simplified signed division
-                    if (b[3] != 0) {
-                        c[3] = static_cast<uint64_t>(
-                            static_cast<int64_t>(a[3]) / static_cast<int64_t>(b[3]));
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SDIV): { // (signed division)
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back((int256(a) / int256(b)).bits);
+                NEXT_OP();
+            }
                 
-            case 0x06: // MOD
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    if (b[3] != 0) {
-                        c[3] = a[3] % b[3];
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(MOD): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a % b);
+                NEXT_OP();
+            }
                 
-            case 0x07: // SMOD (signed modulo)
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    if (b[3] != 0) {
-                        c[3] = static_cast<uint64_t>(
-                            static_cast<int64_t>(a[3]) % static_cast<int64_t>(b[3]));
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SMOD): { // (signed modulo)
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back((int256(a) % int256(b)).bits);
+                NEXT_OP();
+            }
                 
-            case 0x08: // ADDMOD
-                if (state.stack.size() >= 3) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    auto n = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    if (n[3] != 0) {
-                        c[3] = (a[3] + b[3]) % n[3];
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(ADDMOD): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                auto n = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(addmod(a, b, n));
+                NEXT_OP();
+            }
                 
-            case 0x09: // MULMOD  
-                if (state.stack.size() >= 3) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    auto n = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    if (n[3] != 0) {
-                        c[3] = (a[3] * b[3]) % n[3];
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(MULMOD): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                auto n = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(mulmod(a, b, n));
+                NEXT_OP();
+            }
                 
-            case 0x0A: // EXP
-                if (state.stack.size() >= 2) {
-                    auto base = state.stack.back(); state.stack.pop_back();
-                    auto exp = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    // Simple exponentiation for small values
-                    uint64_t result = 1;
-                    uint64_t b_val = base[3];
-                    uint64_t e_val = exp[3];
-                    while (e_val > 0) {
-                        if (e_val & 1) result *= b_val;
-                        b_val *= b_val;
-                        e_val >>= 1;
-                    }
-                    c[3] = result;
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(EXP): {
+                auto base = state.stack.back(); state.stack.pop_back();
+                auto exponent = state.stack.back(); state.stack.pop_back();
                 
-            case 0x10: // LT
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    c[3] = (a < b) ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+                // Dynamic part: per byte of exponent
+                CHARGE_GAS(GasCosts::EXPBYTE * exponent.byte_length());
                 
-            case 0x14: // EQ
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    c[3] = (a == b) ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+                state.stack.push_back(exp(base, exponent));
+                NEXT_OP();
+            }
                 
-            case 0x15: // ISZERO
-                if (state.stack.size() >= 1) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    bool is_zero = true;
-                    for (int i = 0; i < 4; ++i) {
-                        if (a[i] != 0) is_zero = false;
-                    }
-                    c[3] = is_zero ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SIGNEXTEND): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(signextend(a, b));
+                NEXT_OP();
+            }
                 
-            case 0x11: // GT
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    c[3] = (a > b) ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(LT): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(uint256(a < b ? 1 : 0));
+                NEXT_OP();
+            }
                 
-            case 0x12: // SLT (signed less than)
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    c[3] = (static_cast<int64_t>(a[3]) < static_cast<int64_t>(b[3])) ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(GT): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(uint256(a > b ? 1 : 0));
+                NEXT_OP();
+            }
                 
-            case 0x13: // SGT (signed greater than)
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    c[3] = (static_cast<int64_t>(a[3]) > static_cast<int64_t>(b[3])) ? 1 : 0;
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SLT): { // (signed less than)
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(uint256(int256(a) < int256(b) ? 1 : 0));
+                NEXT_OP();
+            }
                 
-            case 0x16: // AND
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    for (int i = 0; i < 4; ++i) c[i] = a[i] & b[i];
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(SGT): { // (signed greater than)
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(uint256(int256(a) > int256(b) ? 1 : 0));
+                NEXT_OP();
+            }
                 
-            case 0x17: // OR
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    for (int i = 0; i < 4; ++i) c[i] = a[i] | b[i];
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(EQ): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(uint256(a == b ? 1 : 0));
+                NEXT_OP();
+            }
                 
-            case 0x18: // XOR
-                if (state.stack.size() >= 2) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    auto b = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    for (int i = 0; i < 4; ++i) c[i] = a[i] ^ b[i];
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(ISZERO): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a.is_zero() ? 1 : 0);
+                NEXT_OP();
+            }
                 
-            case 0x19: // NOT
-                if (state.stack.size() >= 1) {
-                    auto a = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    for (int i = 0; i < 4; ++i) c[i] = ~a[i];
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(AND): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a & b);
+                NEXT_OP();
+            }
                 
-            case 0x1A: // BYTE
-                if (state.stack.size() >= 2) {
-                    auto i_w = state.stack.back(); state.stack.pop_back();
-                    auto x = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    size_t i = i_w[3];
-                    if (i < 32) {
-                        int word_idx = i / 8;
-                        int byte_idx = i % 8;
-                        c[3] = (x[word_idx] >> (56 - byte_idx * 8)) & 0xFF;
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(OR): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a | b);
+                NEXT_OP();
+            }
                 
-            case 0x1B: // SHL (shift left)
-                if (state.stack.size() >= 2) {
-                    auto shift_w = state.stack.back(); state.stack.pop_back();
-                    auto value = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    size_t shift = shift_w[3];
-                    if (shift < 256) {
-                        // Simplified: only handles shifts within 64 bits
-                        c[3] = value[3] << (shift % 64);
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(XOR): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                auto b = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(a ^ b);
+                NEXT_OP();
+            }
                 
-            case 0x1C: // SHR (logical shift right)
-                if (state.stack.size() >= 2) {
-                    auto shift_w = state.stack.back(); state.stack.pop_back();
-                    auto value = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    size_t shift = shift_w[3];
-                    if (shift < 256) {
-                        c[3] = value[3] >> (shift % 64);
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(NOT): {
+                auto a = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(~a);
+                NEXT_OP();
+            }
                 
-            case 0x1D: // SAR (arithmetic shift right)
-                if (state.stack.size() >= 2) {
-                    auto shift_w = state.stack.back(); state.stack.pop_back();
-                    auto value = state.stack.back(); state.stack.pop_back();
-                    uint256 c = {};
-                    size_t shift = shift_w[3];
-                    if (shift < 256) {
-                        c[3] = static_cast<uint64_t>(
-                            static_cast<int64_t>(value[3]) >> (shift % 64));
-                    }
-                    state.stack.push_back(c);
-                }
-                break;
+            OPCODE(BYTE): {
+                auto i = state.stack.back(); state.stack.pop_back();
+                auto x = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(byte_at(i, x));
+                NEXT_OP();
+            }
                 
-            case 0x50: // POP
-                if (!state.stack.empty()) {
-                    state.stack.pop_back();
-                }
-                break;
+            OPCODE(SHL): { // (shift left)
+                auto shift = state.stack.back(); state.stack.pop_back();
+                auto value = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(value << shift_amount(shift));
+                NEXT_OP();
+            }
                 
-            case 0x51: // MLOAD
-                if (!state.stack.empty()) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    uint256 val = {};
-                    if (offset + 32 <= state.memory.size()) {
-                        for (int i = 0; i < 32; ++i) {
-                            int word_idx = i / 8;
-                            int byte_idx = i % 8;
-                            val[word_idx] |= static_cast<uint64_t>(state.memory[offset + i]) 
-                                             << (56 - byte_idx * 8);
-                        }
-                    }
-                    state.stack.push_back(val);
-                }
-                break;
+            OPCODE(SHR): { // (logical shift right)
+                auto shift = state.stack.back(); state.stack.pop_back();
+                auto value = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back(value >> shift_amount(shift));
+                NEXT_OP();
+            }
                 
-            case 0x52: // MSTORE
-                if (state.stack.size() >= 2) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto val = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    
-                    // Expand memory if needed
-                    if (offset + 32 > state.memory.size()) {
-                        state.memory.resize(offset + 32, 0);
-                    }
-                    
-                    // Store value
-                    for (int i = 0; i < 32; ++i) {
-                        int word_idx = i / 8;
-                        int byte_idx = i % 8;
-                        state.memory[offset + i] = static_cast<uint8_t>(
-                            (val[word_idx] >> (56 - byte_idx * 8)) & 0xFF);
+            OPCODE(SAR): { // (arithmetic shift right)
+                auto shift = state.stack.back(); state.stack.pop_back();
+                auto value = state.stack.back(); state.stack.pop_back();
+                state.stack.push_back((int256(value) >> shift_amount(shift)).bits);
+                NEXT_OP();
+            }
+                
+            OPCODE(KECCAK256): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(offset, size);
+                CHARGE_GAS(GasCosts::SHA3WORD * EvmMemory::words(size));
+                
+                const uint8_t* data = size > 0 ? state.memory.data() + offset : nullptr;
+                auto digest = keccak_cache_.hash(data, size);
+                state.stack.push_back(uint256::from_bytes(digest.data(), digest.size()));
+                NEXT_OP();
+            }
+                
+            OPCODE(POP): {
+                state.stack.pop_back();
+                NEXT_OP();
+            }
+                
+            OPCODE(MLOAD): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                EXPAND_MEMORY(offset, 32);
+                state.stack.push_back(uint256::from_bytes(state.memory.data() + offset, 32));
+                NEXT_OP();
+            }
+                
+            OPCODE(MSTORE): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto val = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                EXPAND_MEMORY(offset, 32);
+                val.to_bytes(state.memory.data() + offset);
+                NEXT_OP();
+            }
+                
+            OPCODE(MSTORE8): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto val = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                EXPAND_MEMORY(offset, 1);
+                state.memory.data()[offset] = static_cast<uint8_t>(val[3]);
+                NEXT_OP();
+            }
+                
+            OPCODE(SLOAD): {
+                auto key_w = state.stack.back(); state.stack.pop_back();
+                Hash256 key;
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 8; ++j) {
+                        key[i * 8 + j] = static_cast<uint8_t>(
+                            (key_w[i] >> (56 - j * 8)) & 0xFF);
                     }
                 }
-                break;
                 
-            case 0x54: // SLOAD
-                if (!state.stack.empty()) {
-                    auto key_w = state.stack.back(); state.stack.pop_back();
-                    Hash256 key;
-                    for (int i = 0; i < 4; ++i) {
-                        for (int j = 0; j < 8; ++j) {
-                            key[i * 8 + j] = static_cast<uint8_t>(
-                                (key_w[i] >> (56 - j * 8)) & 0xFF);
-                        }
-                    }
-                    
-                    auto val_bytes = state_->get_storage(address, key);
-                    uint256 val = {};
-                    for (size_t i = 0; i < std::min(val_bytes.size(), size_t(32)); ++i) {
-                        int word_idx = i / 8;
-                        int byte_idx = i % 8;
-                        val[word_idx] |= static_cast<uint64_t>(val_bytes[i]) 
-                                         << (56 - byte_idx * 8);
-                    }
-                    state.stack.push_back(val);
+                auto val_bytes = state_->get_storage(address, key);
+                uint256 val = {};
+                for (size_t i = 0; i < std::min(val_bytes.size(), size_t(32)); ++i) {
+                    int word_idx = i / 8;
+                    int byte_idx = i % 8;
+                    val[word_idx] |= static_cast<uint64_t>(val_bytes[i]) 
+                                     << (56 - byte_idx * 8);
                 }
-                break;
+                state.stack.push_back(val);
+                NEXT_OP();
+            }
                 
-            case 0x55: // SSTORE
-                if (is_static) {
-                    state.reverted = true;
-                    result.error = "State modification in static call";
-                } else if (state.stack.size() >= 2) {
-                    auto key_w = state.stack.back(); state.stack.pop_back();
-                    auto val_w = state.stack.back(); state.stack.pop_back();
-                    
-                    Hash256 key;
-                    Bytes val(32);
-                    for (int i = 0; i < 4; ++i) {
-                        for (int j = 0; j < 8; ++j) {
-                            key[i * 8 + j] = static_cast<uint8_t>(
-                                (key_w[i] >> (56 - j * 8)) & 0xFF);
-                            val[i * 8 + j] = static_cast<uint8_t>(
-                                (val_w[i] >> (56 - j * 8)) & 0xFF);
-                        }
+            OPCODE(SSTORE): {
+                REQUIRE_NON_STATIC();
+                auto key_w = state.stack.back(); state.stack.pop_back();
+                auto val_w = state.stack.back(); state.stack.pop_back();
+                
+                Hash256 key;
+                Bytes val(32);
+                for (int i = 0; i < 4; ++i) {
+                    for (int j = 0; j < 8; ++j) {
+                        key[i * 8 + j] = static_cast<uint8_t>(
+                            (key_w[i] >> (56 - j * 8)) & 0xFF);
+                        val[i * 8 + j] = static_cast<uint8_t>(
+                            (val_w[i] >> (56 - j * 8)) & 0xFF);
                     }
-                    
-                    state_->set_storage(address, key, val);
                 }
-                break;
                 
-            case 0x56: // JUMP
-                if (!state.stack.empty()) {
-                    auto dest = state.stack.back(); state.stack.pop_back();
-                    state.pc = dest[3] - 1;  // -1 because we increment at end
+                state_->set_storage(address, key, val);
+                NEXT_OP();
+            }
+                
+            OPCODE(JUMP): {
+                auto dest = state.stack.back(); state.stack.pop_back();
+                if (!code.valid_jump(dest)) {
+                    state.reverted = true;
+                    result.error = "Invalid jump destination";
+                    goto done;
                 }
-                break;
+                pc = dest[3] - 1;  // -1 because we increment at end
+                NEXT_OP();
+            }
                 
-            case 0x57: // JUMPI
-                if (state.stack.size() >= 2) {
-                    auto dest = state.stack.back(); state.stack.pop_back();
-                    auto cond = state.stack.back(); state.stack.pop_back();
-                    if (cond[3] != 0) {
-                        state.pc = dest[3] - 1;
+            OPCODE(JUMPI): {
+                auto dest = state.stack.back(); state.stack.pop_back();
+                auto cond = state.stack.back(); state.stack.pop_back();
+                if (!cond.is_zero()) {
+                    if (!code.valid_jump(dest)) {
+                        state.reverted = true;
+                        result.error = "Invalid jump destination";
+                        goto done;
                     }
+                    pc = dest[3] - 1;
+                    NEXT_OP();
                 }
-                break;
+                NEXT_BLOCK();
+            }
                 
-            case 0x5B: // JUMPDEST
-                // No-op, just a valid jump destination
-                break;
+            OPCODE(JUMPDEST): {
+                // Starts a basic block
+                ENTER_BLOCK(pc);
+                NEXT_OP();
+            }
                 
-            case 0x60: case 0x61: case 0x62: case 0x63: // PUSH1-PUSH4
-            case 0x64: case 0x65: case 0x66: case 0x67:
-            case 0x68: case 0x69: case 0x6A: case 0x6B:
-            case 0x6C: case 0x6D: case 0x6E: case 0x6F:
-            case 0x70: case 0x71: case 0x72: case 0x73:
-            case 0x74: case 0x75: case 0x76: case 0x77:
-            case 0x78: case 0x79: case 0x7A: case 0x7B:
-            case 0x7C: case 0x7D: case 0x7E: case 0x7F: {
-                int n = opcode - 0x60 + 1;  // Number of bytes to push
-                uint256 val = {};
-                for (int i = 0; i < n && state.pc + 1 + i < code.size(); ++i) {
-                    int word_idx = (31 - i) / 8;
-                    int byte_idx = (31 - i) % 8;
-                    val[word_idx] |= static_cast<uint64_t>(code[state.pc + 1 + i]) 
-                                     << (56 - byte_idx * 8);
-                }
-                state.stack.push_back(val);
-                state.pc += n;
-                break;
+            OPCODE(PUSH): { // PUSH1-PUSH32
+                size_t n = opcode - 0x60 + 1;  // Number of bytes to push
+                
+                // Big-endian immediate; bytes past the end of code read as
+                // zero from the padding
+                state.stack.push_back(uint256::from_bytes(code_data + pc + 1, n));
+                pc += n;
+                NEXT_OP();
             }
                 
-            case 0x80: case 0x81: case 0x82: case 0x83: // DUP1-DUP16
-            case 0x84: case 0x85: case 0x86: case 0x87:
-            case 0x88: case 0x89: case 0x8A: case 0x8B:
-            case 0x8C: case 0x8D: case 0x8E: case 0x8F: {
+            OPCODE(DUP): { // DUP1-DUP16
                 int n = opcode - 0x80 + 1;
-                if (state.stack.size() >= n) {
-                    state.stack.push_back(state.stack[state.stack.size() - n]);
-                }
-                break;
+                state.stack.push_back(state.stack[state.stack.size() - n]);
+                NEXT_OP();
             }
                 
-            case 0x90: case 0x91: case 0x92: case 0x93: // SWAP1-SWAP16
-            case 0x94: case 0x95: case 0x96: case 0x97:
-            case 0x98: case 0x99: case 0x9A: case 0x9B:
-            case 0x9C: case 0x9D: case 0x9E: case 0x9F: {
+            OPCODE(SWAP): { // SWAP1-SWAP16
                 int n = opcode - 0x90 + 1;
-                if (state.stack.size() > n) {
-                    std::swap(state.stack.back(), 
-                              state.stack[state.stack.size() - n - 1]);
-                }
-                break;
+                std::swap(state.stack.back(), 
+                          state.stack[state.stack.size() - n - 1]);
+                NEXT_OP();
             }
             
             // ===== Environment opcodes =====
-            case 0x30: { // ADDRESS
+            OPCODE(ADDRESS): {
                 uint256 addr_val = {};
                 std::copy(address.payment_credential.begin(), 
                           address.payment_credential.end(),
                           reinterpret_cast<uint8_t*>(&addr_val[0]));
                 state.stack.push_back(addr_val);
-                break;
+                NEXT_OP();
             }
             
-            case 0x31: { // BALANCE
-                if (!state.stack.empty()) {
-                    auto addr_w = state.stack.back(); state.stack.pop_back();
-                    Address target;
-                    // Extract address from 256-bit word
-                    for (int i = 0; i < 20 && i < 28; ++i) {
-                        target.payment_credential[i] = static_cast<uint8_t>(addr_w[3] >> ((7-i) * 8));
-                    }
-                    uint64_t bal = state_->get_balance(target);
-                    uint256 result = {};
-                    result[3] = bal;
-                    state.stack.push_back(result);
+            OPCODE(BALANCE): {
+                auto addr_w = state.stack.back(); state.stack.pop_back();
+                Address target;
+                // Extract address from 256-bit word
+                for (int i = 0; i < 20 && i < 28; ++i) {
+                    target.payment_credential[i] = static_cast<uint8_t>(addr_w[3] >> ((7-i) * 8));
                 }
-                break;
+                uint64_t bal = state_->get_balance(target);
+                uint256 result = {};
+                result[3] = bal;
+                state.stack.push_back(result);
+                NEXT_OP();
             }
             
-            case 0x32: { // ORIGIN
+            OPCODE(ORIGIN): {
                 uint256 origin_val = {};
                 // Use caller as origin for simplicity
                 state.stack.push_back(origin_val);
-                break;
+                NEXT_OP();
             }
             
-            case 0x33: { // CALLER
+            OPCODE(CALLER): {
                 uint256 caller_val = {};
                 state.stack.push_back(caller_val);
-                break;
+                NEXT_OP();
             }
             
-            case 0x34: { // CALLVALUE
+            OPCODE(CALLVALUE): {
                 uint256 val = {};
                 val[3] = value;
                 state.stack.push_back(val);
-                break;
+                NEXT_OP();
             }
             
-            case 0x35: { // CALLDATALOAD
-                if (!state.stack.empty()) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    uint256 data_val = {};
-                    for (size_t i = 0; i < 32 && offset + i < input.size(); ++i) {
-                        int word_idx = i / 8;
-                        int byte_idx = i % 8;
-                        data_val[word_idx] |= static_cast<uint64_t>(input[offset + i]) 
-                                             << (56 - byte_idx * 8);
-                    }
-                    state.stack.push_back(data_val);
+            OPCODE(CALLDATALOAD): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                size_t offset = offset_w[3];
+                uint256 data_val = {};
+                for (size_t i = 0; i < 32 && offset + i < input.size(); ++i) {
+                    int word_idx = i / 8;
+                    int byte_idx = i % 8;
+                    data_val[word_idx] |= static_cast<uint64_t>(input[offset + i]) 
+                                         << (56 - byte_idx * 8);
                 }
-                break;
+                state.stack.push_back(data_val);
+                NEXT_OP();
             }
             
-            case 0x36: { // CALLDATASIZE
+            OPCODE(CALLDATASIZE): {
                 uint256 size = {};
                 size[3] = input.size();
                 state.stack.push_back(size);
-                break;
+                NEXT_OP();
             }
             
-            case 0x37: { // CALLDATACOPY
-                if (state.stack.size() >= 3) {
-                    auto dest_w = state.stack.back(); state.stack.pop_back();
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t dest = dest_w[3];
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    if (dest + size > state.memory.size()) {
-                        state.memory.resize(dest + size, 0);
-                    }
-                    for (size_t i = 0; i < size; ++i) {
-                        if (offset + i < input.size()) {
-                            state.memory[dest + i] = input[offset + i];
-                        } else {
-                            state.memory[dest + i] = 0;
-                        }
-                    }
-                }
-                break;
+            OPCODE(CALLDATACOPY): {
+                auto dest_w = state.stack.back(); state.stack.pop_back();
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t dest = memory_operand(dest_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(dest, size);
+                CHARGE_GAS(GasCosts::COPY * EvmMemory::words(size));
+                state.memory.copy_in(dest, input.data(), input.size(), offset_w, size);
+                NEXT_OP();
             }
             
-            case 0x38: { // CODESIZE
+            OPCODE(CODESIZE): {
                 uint256 size = {};
                 size[3] = code.size();
                 state.stack.push_back(size);
-                break;
+                NEXT_OP();
             }
             
-            case 0x39: { // CODECOPY
-                if (state.stack.size() >= 3) {
-                    auto dest_w = state.stack.back(); state.stack.pop_back();
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t dest = dest_w[3];
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    if (dest + size > state.memory.size()) {
-                        state.memory.resize(dest + size, 0);
-                    }
-                    for (size_t i = 0; i < size; ++i) {
-                        if (offset + i < code.size()) {
-                            state.memory[dest + i] = code[offset + i];
-                        } else {
-                            state.memory[dest + i] = 0;
-                        }
-                    }
-                }
-                break;
+            OPCODE(CODECOPY): {
+                auto dest_w = state.stack.back(); state.stack.pop_back();
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t dest = memory_operand(dest_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(dest, size);
+                CHARGE_GAS(GasCosts::COPY * EvmMemory::words(size));
+                state.memory.copy_in(dest, code_data, code.size(), offset_w, size);
+                NEXT_OP();
             }
             
-            case 0x3A: { // GASPRICE
+            OPCODE(GASPRICE): {
                 uint256 gp = {};
                 gp[3] = 1000000000; // 1 Gwei
                 state.stack.push_back(gp);
-                break;
+                NEXT_OP();
             }
             
-            case 0x3B: { // EXTCODESIZE
-                if (!state.stack.empty()) {
-                    state.stack.pop_back();
-                    uint256 size = {};
-                    // Would look up contract code size
-                    state.stack.push_back(size);
-                }
-                break;
+            OPCODE(EXTCODESIZE): {
+                state.stack.pop_back();
+                uint256 size = {};
+                // Would look up contract code size
+                state.stack.push_back(size);
+                NEXT_OP();
             }
             
-            case 0x3D: { // RETURNDATASIZE
+            OPCODE(RETURNDATASIZE): {
                 uint256 size = {};
                 size[3] = state.return_data.size();
                 state.stack.push_back(size);
-                break;
+                NEXT_OP();
             }
             
-            case 0x3E: { // RETURNDATACOPY
-                if (state.stack.size() >= 3) {
-                    auto dest_w = state.stack.back(); state.stack.pop_back();
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t dest = dest_w[3];
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    if (dest + size > state.memory.size()) {
-                        state.memory.resize(dest + size, 0);
-                    }
-                    for (size_t i = 0; i < size; ++i) {
-                        if (offset + i < state.return_data.size()) {
-                            state.memory[dest + i] = state.return_data[offset + i];
-                        }
-                    }
-                }
-                break;
+            OPCODE(RETURNDATACOPY): {
+                auto dest_w = state.stack.back(); state.stack.pop_back();
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t dest = memory_operand(dest_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(dest, size);
+                CHARGE_GAS(GasCosts::COPY * EvmMemory::words(size));
+                state.memory.copy_in(dest, state.return_data.data(), state.return_data.size(), offset_w, size);
+                NEXT_OP();
             }
             
             // ===== Block info opcodes =====
-            case 0x40: { // BLOCKHASH
-                if (!state.stack.empty()) {
-                    state.stack.pop_back();
-                    state.stack.push_back({});  // Zero hash
-                }
-                break;
+            OPCODE(BLOCKHASH): {
+                state.stack.pop_back();
+                state.stack.push_back({});  // Zero hash
+                NEXT_OP();
             }
             
-            case 0x41: { // COINBASE
+            OPCODE(COINBASE): {
                 state.stack.push_back({});  // Zero address
-                break;
+                NEXT_OP();
             }
             
-            case 0x42: { // TIMESTAMP
+            OPCODE(TIMESTAMP): {
                 uint256 ts = {};
                 ts[3] = std::chrono::duration_cast<std::chrono::seconds>(
                     std::chrono::system_clock::now().time_since_epoch()).count();
                 state.stack.push_back(ts);
-                break;
+                NEXT_OP();
             }
             
-            case 0x43: { // NUMBER
+            OPCODE(NUMBER): {
                 uint256 num = {};
                 // Block number would come from context
                 state.stack.push_back(num);
-                break;
+                NEXT_OP();
             }
             
-            case 0x44: { // DIFFICULTY (PREVRANDAO)
+            OPCODE(DIFFICULTY): { // (PREVRANDAO)
                 state.stack.push_back({});
-                break;
+                NEXT_OP();
             }
             
-            case 0x45: { // GASLIMIT
+            OPCODE(GASLIMIT): {
                 uint256 limit = {};
                 limit[3] = gas_limit;
                 state.stack.push_back(limit);
-                break;
+                NEXT_OP();
             }
             
-            case 0x46: { // CHAINID
+            OPCODE(CHAINID): {
                 uint256 cid = {};
                 cid[3] = 1; // Nonagon chain ID
                 state.stack.push_back(cid);
-                break;
+                NEXT_OP();
             }
             
-            case 0x47: { // SELFBALANCE
+            OPCODE(SELFBALANCE): {
                 uint64_t bal = state_->get_balance(address);
                 uint256 result = {};
                 result[3] = bal;
                 state.stack.push_back(result);
-                break;
+                NEXT_OP();
             }
             
-            case 0x48: { // BASEFEE
+            OPCODE(BASEFEE): {
                 uint256 bf = {};
                 bf[3] = 1000000000; // 1 Gwei
                 state.stack.push_back(bf);
-                break;
+                NEXT_OP();
             }
             
             // ===== Stack/Memory/Flow opcodes =====
-            case 0x58: { // PC
+            OPCODE(PC): {
                 uint256 pc_val = {};
-                pc_val[3] = state.pc;
+                pc_val[3] = pc;
                 state.stack.push_back(pc_val);
-                break;
+                NEXT_OP();
             }
             
-            case 0x59: { // MSIZE
+            OPCODE(MSIZE): {
                 uint256 msize = {};
                 msize[3] = state.memory.size();
                 state.stack.push_back(msize);
-                break;
+                NEXT_OP();
             }
             
-            case 0x5A: { // GAS
+            OPCODE(GAS): {
                 uint256 gas_val = {};
-                gas_val[3] = state.gas_remaining;
+                gas_val[3] = gas;
                 state.stack.push_back(gas_val);
-                break;
+                NEXT_BLOCK();
             }
             
             // ===== LOG opcodes =====
-            case 0xA0: case 0xA1: case 0xA2: case 0xA3: case 0xA4: { // LOG0-LOG4
+            OPCODE(LOG): { // LOG0-LOG4
                 int num_topics = opcode - 0xA0;
-                if (state.stack.size() >= static_cast<size_t>(2 + num_topics) && !is_static) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    Log log;
-                    log.address = address;
-                    
-                    // Extract topics
-                    for (int i = 0; i < num_topics; ++i) {
-                        auto topic = state.stack.back(); state.stack.pop_back();
-                        Hash256 topic_hash;
-                        for (int j = 0; j < 4; ++j) {
-                            for (int k = 0; k < 8; ++k) {
-                                topic_hash[j * 8 + k] = static_cast<uint8_t>(
-                                    (topic[j] >> (56 - k * 8)) & 0xFF);
-                            }
+                REQUIRE_NON_STATIC();
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(offset, size);
+                
+                Log log;
+                log.address = address;
+                
+                // Extract topics
+                for (int i = 0; i < num_topics; ++i) {
+                    auto topic = state.stack.back(); state.stack.pop_back();
+                    Hash256 topic_hash;
+                    for (int j = 0; j < 4; ++j) {
+                        for (int k = 0; k < 8; ++k) {
+                            topic_hash[j * 8 + k] = static_cast<uint8_t>(
+                                (topic[j] >> (56 - k * 8)) & 0xFF);
                         }
-                        log.topics.push_back(topic_hash);
                     }
-                    
-                    // Extract data
-                    if (offset + size <= state.memory.size()) {
-                        log.data.assign(state.memory.begin() + offset,
-                                       state.memory.begin() + offset + size);
-                    }
-                    
-                    result.logs.push_back(log);
+                    log.topics.push_back(topic_hash);
                 }
-                break;
+                
+                // Extract data
+                if (size > 0) {
+                    log.data.assign(state.memory.data() + offset,
+                                    state.memory.data() + offset + size);
+                }
+                
+                result.logs.push_back(log);
+                NEXT_OP();
             }
             
             // ===== CALL opcodes =====
-            case 0xF1: { // CALL
-                if (state.stack.size() >= 7) {
-                    auto gas_w = state.stack.back(); state.stack.pop_back();
-                    auto addr_w = state.stack.back(); state.stack.pop_back();
-                    auto value_w = state.stack.back(); state.stack.pop_back();
-                    auto args_offset_w = state.stack.back(); state.stack.pop_back();
-                    auto args_size_w = state.stack.back(); state.stack.pop_back();
-                    auto ret_offset_w = state.stack.back(); state.stack.pop_back();
-                    auto ret_size_w = state.stack.back(); state.stack.pop_back();
-                    
-                    uint64_t val = value_w[3];
-                    uint64_t args_off = args_offset_w[3];
-                    uint64_t args_sz = args_size_w[3];
-                    uint64_t ret_off = ret_offset_w[3];
-                    uint64_t ret_sz = ret_size_w[3];
-                    uint64_t gas = gas_w[3];
-
-                    // Extract Address (28 bytes)
-                    Address to_addr;
-                    // Provide defaults
-                    
-                    // Decode uint256 addr_w to 28 bytes
-                    auto extract_byte = [&](int word_idx, int byte_idx) {
-                        return (uint8_t)((addr_w[word_idx] >> (byte_idx * 8)) & 0xFF);
-                    };
-                    
-                    // 28 bytes total. 
-                    // Word 0 (Top): skip 4, take 4 loops (3 downto 0).
-                    int pos = 0;
-                    for(int i=3; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(0, i);
-                    for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(1, i);
-                    for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(2, i);
-                    for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(3, i);
-                    
-                    // Get args
-                    Bytes input;
-                    if (args_sz > 0) {
-                        if (state.memory.size() < args_off + args_sz) state.memory.resize(args_off + args_sz);
-                        input.assign(state.memory.begin() + args_off, state.memory.begin() + args_off + args_sz);
-                    }
+            OPCODE(CALL): {
+                auto gas_w = state.stack.back(); state.stack.pop_back();
+                auto addr_w = state.stack.back(); state.stack.pop_back();
+                auto value_w = state.stack.back(); state.stack.pop_back();
+                auto args_offset_w = state.stack.back(); state.stack.pop_back();
+                auto args_size_w = state.stack.back(); state.stack.pop_back();
+                auto ret_offset_w = state.stack.back(); state.stack.pop_back();
+                auto ret_size_w = state.stack.back(); state.stack.pop_back();
+                
+                uint64_t val = value_w[3];
+                uint64_t args_off = memory_operand(args_offset_w);
+                uint64_t args_sz = memory_operand(args_size_w);
+                uint64_t ret_off = memory_operand(ret_offset_w);
+                uint64_t ret_sz = memory_operand(ret_size_w);
+                
+                // Both ranges are paid for up front, before the callee runs
+                EXPAND_MEMORY(args_off, args_sz);
+                EXPAND_MEMORY(ret_off, ret_sz);
 
-                    auto snap = state_->snapshot();
-                    bool success = true;
+                // The callee's gas is taken from the caller now; whatever the
+                // callee leaves is given back below
+                const uint64_t call_gas =
+                    forwarded_gas(gas_w.fits_u64() ? gas_w[3] : UINT64_MAX, gas);
+                gas -= call_gas;
 
-                    if (val > 0) {
-                        if (state_->get_balance(address) >= val) {
-                            state_->sub_balance(address, val);
-                            state_->add_balance(to_addr, val);
-                        } else {
-                            success = false;
-                        }
-                    }
+                // Extract Address (28 bytes)
+                Address to_addr;
+                // Provide defaults
+                
+                // Decode uint256 addr_w to 28 bytes
+                auto extract_byte = [&](int word_idx, int byte_idx) {
+                    return (uint8_t)((addr_w[word_idx] >> (byte_idx * 8)) & 0xFF);
+                };
+                
+                // 28 bytes total. 
+                // Word 0 (Top): skip 4, take 4 loops (3 downto 0).
+                int pos = 0;
+                for(int i=3; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(0, i);
+                for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(1, i);
+                for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(2, i);
+                for(int i=7; i>=0; --i) to_addr.payment_credential[pos++] = extract_byte(3, i);
+                
+                // Get args
+                Bytes input;
+                if (args_sz > 0) {
+                    input.assign(state.memory.data() + args_off,
+                                 state.memory.data() + args_off + args_sz);
+                }
 
-                    if (success) {
-                        Bytes target_code = state_->get_code(to_addr);
-                        // If precompile check needed here? execute_code logic handles it? yes (L158 in Step 2116)
-                        auto res = execute_code(address, to_addr, target_code, input, val, gas, is_static);
-                        success = res.success;
-                        
-                        if (ret_sz > 0) {
-                             if (state.memory.size() < ret_off + ret_sz) state.memory.resize(ret_off + ret_sz);
-                             size_t copy = std::min((size_t)ret_sz, res.return_data.size());
-                             std::copy(res.return_data.begin(), res.return_data.begin() + copy, state.memory.begin() + ret_off);
-                        }
-                    }
+                auto snap = state_->snapshot();
+                bool success = depth < CALL_DEPTH_LIMIT;
+                uint64_t call_gas_used = 0;
 
-                    if (!success) {
-                        state_->revert(snap);
-                        uint256 zero = {};
-                        state.stack.push_back(zero);
+                if (success && val > 0) {
+                    if (state_->get_balance(address) >= val) {
+                        state_->sub_balance(address, val);
+                        state_->add_balance(to_addr, val);
                     } else {
-                        uint256 one = {}; one[3] = 1;
-                        state.stack.push_back(one);
+                        success = false;
                     }
                 }
-                break;
+
+                if (success) {
+                    auto target_code = load_code(to_addr);
+                    // If precompile check needed here? execute_code logic handles it? yes (L158 in Step 2116)
+                    auto res = execute_code(address, to_addr, *target_code, input, val, call_gas,
+                                            is_static, depth + 1);
+                    success = res.success;
+                    call_gas_used = std::min(res.gas_used, call_gas);
+                    
+                    size_t copy = std::min<uint64_t>(ret_sz, res.return_data.size());
+                    if (copy > 0) {
+                        std::memcpy(state.memory.data() + ret_off, res.return_data.data(), copy);
+                    }
+                }
+                gas += call_gas - call_gas_used;
+
+                if (!success) {
+                    state_->revert(snap);
+                    uint256 zero = {};
+                    state.stack.push_back(zero);
+                } else {
+                    uint256 one = {}; one[3] = 1;
+                    state.stack.push_back(one);
+                }
+                NEXT_BLOCK();
             }
             
-            case 0xF2: { // CALLCODE
+            OPCODE(CALLCODE): {
                 // Similar to CALL but preserves caller context
-                if (state.stack.size() >= 7) {
-                    for (int i = 0; i < 7; ++i) state.stack.pop_back();
-                    uint256 success = {};
-                    success[3] = 1;
-                    state.stack.push_back(success);
-                }
-                break;
+                for (int i = 0; i < 7; ++i) state.stack.pop_back();
+                uint256 success = {};
+                success[3] = 1;
+                state.stack.push_back(success);
+                NEXT_BLOCK();
             }
             
-            case 0xF4: { // DELEGATECALL
-                if (state.stack.size() >= 6) {
-                    for (int i = 0; i < 6; ++i) state.stack.pop_back();
-                    uint256 success = {};
-                    success[3] = 1;
-                    state.stack.push_back(success);
-                }
-                break;
+            OPCODE(DELEGATECALL): {
+                for (int i = 0; i < 6; ++i) state.stack.pop_back();
+                uint256 success = {};
+                success[3] = 1;
+                state.stack.push_back(success);
+                NEXT_BLOCK();
             }
             
-            case 0xFA: { // STATICCALL
-                if (state.stack.size() >= 6) {
-                    for (int i = 0; i < 6; ++i) state.stack.pop_back();
-                    uint256 success = {};
-                    success[3] = 1;
-                    state.stack.push_back(success);
-                }
-                break;
+            OPCODE(STATICCALL): {
+                for (int i = 0; i < 6; ++i) state.stack.pop_back();
+                uint256 success = {};
+                success[3] = 1;
+                state.stack.push_back(success);
+                NEXT_BLOCK();
             }
             
-            case 0xF0: { // CREATE
-                if (state.stack.size() >= 3 && !is_static) {
-                    auto value_w = state.stack.back(); state.stack.pop_back();
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    
-                    uint64_t value = value_w[3];
-                    uint64_t offset = offset_w[3];
-                    uint64_t size = size_w[3];
-
-                    // Check balance
-                    if (state_->get_balance(address) < value) {
-                        state.stack.push_back({}); // fail
-                        break;
-                    }
+            OPCODE(CREATE): {
+                REQUIRE_NON_STATIC();
+                auto value_w = state.stack.back(); state.stack.pop_back();
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                
+                uint64_t value = value_w[3];
+                uint64_t offset = memory_operand(offset_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(offset, size);
 
-                    // Get Init Code
-                    Bytes init_code;
-                    if (size > 0 && offset + size <= state.memory.size()) {
-                        init_code.assign(state.memory.begin() + offset, state.memory.begin() + offset + size);
-                    }
+                // Check depth and balance
+                if (depth >= CALL_DEPTH_LIMIT || state_->get_balance(address) < value) {
+                    state.stack.push_back({}); // fail
+                    NEXT_BLOCK();
+                }
 
-                    // Calculate new address (Blake2b of addr + nonce)
-                    uint64_t nonce = state_->get_nonce(address);
-                    state_->increment_nonce(address);
-
-                    std::vector<uint8_t> preimage;
-                    preimage.insert(preimage.end(), address.payment_credential.begin(), address.payment_credential.end());
-                    for(int i=7; i>=0; --i) preimage.push_back((uint8_t)((nonce >> (i*8)) & 0xFF));
-                    auto hash = crypto::Blake2b256::hash(preimage);
-
-                    Address new_addr;
-                    new_addr.type = Address::Type::Script;
-                    std::copy(hash.begin(), hash.begin()+28, new_addr.payment_credential.begin());
-
-                    // Snapshot
-                    auto snap = state_->snapshot();
-
-                    // Transfer
-                    state_->sub_balance(address, value);
-                    state_->add_balance(new_addr, value);
-                    state_->set_account(new_addr, {value, 0}); // Reset account code/storage implicitly? (Assuming empty)
-
-                    // Execute Init Code
-                    auto res = execute_code(address, new_addr, init_code, {}, value, state.gas_remaining, false);
-
-                    if (res.success) {
-                        state_->set_code(new_addr, res.return_data);
-                        
-                        // Push Address to stack
-                        uint256 addr_val = {};
-                        // Pack 28 bytes into uint256 (Right aligned)
-                        // addr bytes: [0..27]
-                        // uint256: [0]=High, [3]=Low
-                        // [0]: bytes 0..3 of addr go to lowest 4 bytes of word 0
-                        for(int i=0; i<4; ++i) addr_val[0] |= ((uint64_t)new_addr.payment_credential[i] << ((3-i)*8));
-                        for(int i=0; i<8; ++i) addr_val[1] |= ((uint64_t)new_addr.payment_credential[4+i] << ((7-i)*8));
-                        for(int i=0; i<8; ++i) addr_val[2] |= ((uint64_t)new_addr.payment_credential[12+i] << ((7-i)*8));
-                        for(int i=0; i<8; ++i) addr_val[3] |= ((uint64_t)new_addr.payment_credential[20+i] << ((7-i)*8));
-                        
-                        state.stack.push_back(addr_val);
-                    } else {
-                        state_->revert(snap);
-                        state.stack.push_back({}); // 0
-                    }
+                // Get Init Code
+                Bytes init_code;
+                if (size > 0) {
+                    init_code.assign(state.memory.data() + offset, state.memory.data() + offset + size);
                 }
-                break;
+
+                // Calculate new address (Blake2b of addr + nonce)
+                uint64_t nonce = state_->get_nonce(address);
+                state_->increment_nonce(address);
+
+                std::vector<uint8_t> preimage;
+                preimage.insert(preimage.end(), address.payment_credential.begin(), address.payment_credential.end());
+                for(int i=7; i>=0; --i) preimage.push_back((uint8_t)((nonce >> (i*8)) & 0xFF));
+                auto hash = crypto::Blake2b256::hash(preimage);
+
+                Address new_addr;
+                new_addr.type = Address::Type::Script;
+                std::copy(hash.begin(), hash.begin()+28, new_addr.payment_credential.begin());
+
+                // Snapshot
+                auto snap = state_->snapshot();
+
+                // Transfer
+                state_->sub_balance(address, value);
+                state_->add_balance(new_addr, value);
+                state_->set_account(new_addr, {value, 0}); // Reset account code/storage implicitly? (Assuming empty)
+
+                // Execute Init Code with the gas it may be forwarded, taken
+                // from the caller until it returns
+                const uint64_t create_gas = forwarded_gas(gas, gas);
+                gas -= create_gas;
+                auto res = execute_code(address, new_addr, *CodeAnalysis::analyze(init_code), {}, value,
+                                        create_gas, false, depth + 1);
+                gas += create_gas - std::min(res.gas_used, create_gas);
+
+                if (res.success) {
+                    state_->set_code(new_addr, res.return_data);
+                    
+                    // Push Address to stack
+                    uint256 addr_val = {};
+                    // Pack 28 bytes into uint256 (Right aligned)
+                    // addr bytes: [0..27]
+                    // uint256: [0]=High, [3]=Low
+                    // [0]: bytes 0..3 of addr go to lowest 4 bytes of word 0
+                    for(int i=0; i<4; ++i) addr_val[0] |= ((uint64_t)new_addr.payment_credential[i] << ((3-i)*8));
+                    for(int i=0; i<8; ++i) addr_val[1] |= ((uint64_t)new_addr.payment_credential[4+i] << ((7-i)*8));
+                    for(int i=0; i<8; ++i) addr_val[2] |= ((uint64_t)new_addr.payment_credential[12+i] << ((7-i)*8));
+                    for(int i=0; i<8; ++i) addr_val[3] |= ((uint64_t)new_addr.payment_credential[20+i] << ((7-i)*8));
+                    
+                    state.stack.push_back(addr_val);
+                } else {
+                    state_->revert(snap);
+                    state.stack.push_back({}); // 0
+                }
+                NEXT_BLOCK();
             }
             
-            case 0xF5: { // CREATE2
-                if (state.stack.size() >= 4 && !is_static) {
-                    for (int i = 0; i < 4; ++i) state.stack.pop_back();
-                    state.stack.push_back({});
-                }
-                break;
+            OPCODE(CREATE2): {
+                REQUIRE_NON_STATIC();
+                for (int i = 0; i < 4; ++i) state.stack.pop_back();
+                state.stack.push_back({});
+                NEXT_BLOCK();
             }
                 
-            case 0xF3: // RETURN
-                if (state.stack.size() >= 2) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    if (offset + size <= state.memory.size()) {
-                        state.return_data.assign(
-                            state.memory.begin() + offset,
-                            state.memory.begin() + offset + size);
-                    }
+            OPCODE(RETURN): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(offset, size);
+                
+                if (size > 0) {
+                    state.return_data.assign(
+                        state.memory.data() + offset,
+                        state.memory.data() + offset + size);
                 }
                 state.stopped = true;
-                break;
+                goto done;
+            }
                 
-            case 0xFD: // REVERT
-                if (state.stack.size() >= 2) {
-                    auto offset_w = state.stack.back(); state.stack.pop_back();
-                    auto size_w = state.stack.back(); state.stack.pop_back();
-                    size_t offset = offset_w[3];
-                    size_t size = size_w[3];
-                    
-                    if (offset + size <= state.memory.size()) {
-                        state.return_data.assign(
-                            state.memory.begin() + offset,
-                            state.memory.begin() + offset + size);
-                    }
+            OPCODE(REVERT): {
+                auto offset_w = state.stack.back(); state.stack.pop_back();
+                auto size_w = state.stack.back(); state.stack.pop_back();
+                uint64_t offset = memory_operand(offset_w);
+                uint64_t size = memory_operand(size_w);
+                EXPAND_MEMORY(offset, size);
+                
+                if (size > 0) {
+                    state.return_data.assign(
+                        state.memory.data() + offset,
+                        state.memory.data() + offset + size);
                 }
                 state.reverted = true;
-                break;
+                goto done;
+            }
                 
-            case 0xFE: // INVALID
+            OPCODE(INVALID): {
                 state.reverted = true;
                 result.error = "Invalid opcode";
-                break;
+                goto done;
+            }
                 
-            case 0xFF: // SELFDESTRUCT
-                if (!is_static && !state.stack.empty()) {
-                    auto beneficiary_w = state.stack.back(); state.stack.pop_back();
-                    // Transfer balance to beneficiary and mark for deletion
-                    // Simplified: just stop
-                }
+            OPCODE(SELFDESTRUCT): {
+                REQUIRE_NON_STATIC();
+                auto beneficiary_w = state.stack.back(); state.stack.pop_back();
+                // Transfer balance to beneficiary and mark for deletion
+                // Simplified: just stop
                 state.stopped = true;
-                break;
+                goto done;
+            }
                 
-            default:
+            OPCODE(UNDEFINED): {
                 // Unknown opcode
                 state.reverted = true;
                 result.error = "Unknown opcode: 0x" + 
                                std::to_string(static_cast<int>(opcode));
-                break;
+                goto done;
+            }
         }
-        
-        state.pc++;
-    }
     
-    result.gas_used = gas_limit - state.gas_remaining;
-    result.success = !state.reverted;
-    result.return_data = state.return_data;
+#undef OPCODE
+#undef DISPATCH
+#undef ENTER_BLOCK
+#undef NEXT_OP
+#undef NEXT_BLOCK
+#undef CHARGE_GAS
+#undef EXPAND_MEMORY
+#undef REQUIRE_NON_STATIC
     
-    return result;
+    out_of_gas:
+        result.success = false;
+        result.error = "Out of gas";
+        result.gas_used = gas_limit;
+        return result;
+    
+    stack_underflow:
+        result.success = false;
+        result.error = "Stack underflow";
+        result.gas_used = gas_limit;
+        return result;
+    
+    stack_overflow:
+        result.success = false;
+        result.error = "Stack overflow";
+        result.gas_used = gas_limit;
+        return result;
+    
+    done:
+        result.gas_used = gas_limit - gas;
+        result.success = !state.reverted;
+        result.return_data = std::move(state.return_data);
+        return result;
 }
 
 uint64_t get_opcode_gas_cost(uint8_t opcode) {
-    switch (opcode) {
-        case 0x00: return GasCosts::ZERO;  // STOP
-        case 0x01: case 0x02: case 0x03: return GasCosts::VERYLOW;  // ADD, MUL, SUB
-        case 0x10: case 0x11: case 0x12: case 0x13: return GasCosts::VERYLOW;  // LT, GT, SLT, SGT
-        case 0x14: case 0x15: return GasCosts::VERYLOW;  // EQ, ISZERO
-        case 0x50: return GasCosts::BASE;  // POP
-        case 0x51: case 0x52: return GasCosts::VERYLOW;  // MLOAD, MSTORE
-        case 0x54: return GasCosts::SLOAD;
-        case 0x55: return GasCosts::SSTORE_SET;  // Simplified
-        case 0x56: return GasCosts::MID;  // JUMP
-        case 0x57: return GasCosts::HIGH;  // JUMPI
-        case 0x5B: return 1;  // JUMPDEST
-        case 0xF3: case 0xFD: return GasCosts::ZERO;  // RETURN, REVERT
-        case 0xFE: return GasCosts::ZERO;  // INVALID
-        case 0xFF: return GasCosts::SELFDESTRUCT;
-        default:
-            if (opcode >= 0x60 && opcode <= 0x7F) return GasCosts::VERYLOW;  // PUSH
-            if (opcode >= 0x80 && opcode <= 0x8F) return GasCosts::VERYLOW;  // DUP
-            if (opcode >= 0x90 && opcode <= 0x9F) return GasCosts::VERYLOW;  // SWAP
-            return GasCosts::BASE;
-    }
+    return OPCODES[opcode].gas;
 }
 
 // ============================================================================
 // TransactionProcessor Implementation
 // ============================================================================
 
-TransactionProcessor::TransactionProcessor(std::shared_ptr<storage::StateManager> state,
+TransactionProcessor::TransactionProcessor(std::shared_ptr<storage::StateView> state,
                                            std::shared_ptr<EVM> evm)
     : state_(state), evm_(evm) {}
 
@@ -1220,6 +1588,7 @@ TransactionProcessor::ProcessResult TransactionProcessor::process(
     // Validate first
     auto validation = validate(tx, ctx.base_fee);
     if (!validation.valid) {
+        result.gas_used = 0;
         result.success = false;
         result.error = validation.error;
         result.receipt.success = false;
@@ -1246,15 +1615,16 @@ TransactionProcessor::ProcessResult TransactionProcessor::process(
 TransactionProcessor::ValidationResult TransactionProcessor::validate(
     const Transaction& tx, uint64_t base_fee) const {
     
+    auto sender = state_->get_account(tx.from);
+    
     // Check nonce
-    uint64_t expected_nonce = state_->get_nonce(tx.from);
-    if (tx.nonce != expected_nonce) {
+    if (tx.nonce != sender.nonce) {
         return {false, "Invalid nonce"};
     }
     
     // Check balance
     uint64_t cost = tx.value + (tx.gas_limit * tx.max_fee_per_gas);
-    if (state_->get_balance(tx.from) < cost) {
+    if (sender.balance < cost) {
         return {false, "Insufficient balance"};
     }
     
@@ -1325,21 +1695,36 @@ BlockProcessor::BlockResult BlockProcessor::process_block(const Block& block) {
     ctx.chain_id = 1;  // Would come from config
     ctx.block_hash = block.header.hash();
     
-    // Process each transaction
+    // Execute transactions, in parallel if an executor is set
+    std::vector<TransactionProcessor::ProcessResult> tx_results;
+    tx_results.reserve(block.transactions().size());
+    
+    if (parallel_executor_) {
+        for (auto& tx_result : parallel_executor_->execute(block.transactions(), ctx)) {
+            tx_results.push_back(std::move(*tx_result));
+        }
+    } else {
+        for (const auto& tx_ptr : block.transactions()) {
+            const Transaction& tx = *tx_ptr;
+            ctx.caller = tx.from;
+            ctx.origin = tx.from;
+            ctx.gas_price = tx.effective_gas_price(ctx.base_fee);
+            
+            tx_results.push_back(tx_processor_->process(tx, ctx));
+        }
+    }
+    
+    // Build receipts
     uint64_t cumulative_gas = 0;
+    crypto::MerkleAccumulator receipts_acc;
     
-    for (const auto& tx : block.transactions) {
-        ctx.caller = tx.from;
-        ctx.origin = tx.from;
-        ctx.gas_price = tx.effective_gas_price(ctx.base_fee);
-        
-        auto tx_result = tx_processor_->process(tx, ctx);
-        
+    for (auto& tx_result : tx_results) {
         cumulative_gas += tx_result.gas_used;
         tx_result.receipt.cumulative_gas_used = cumulative_gas;
         tx_result.receipt.block_number = block.header.number;
         tx_result.receipt.transaction_index = result.receipts.size();
         
+        receipts_acc.append(tx_result.receipt.hash());
         result.receipts.push_back(tx_result.receipt);
         
         if (!tx_result.success) {
@@ -1353,12 +1738,8 @@ BlockProcessor::BlockResult BlockProcessor::process_block(const Block& block) {
     // Commit state changes
     result.state_root = state_->commit();
     
-    // Compute receipts root
-    std::vector<Hash256> receipt_hashes;
-    for (const auto& receipt : result.receipts) {
-        receipt_hashes.push_back(receipt.hash());
-    }
-    result.receipts_root = crypto::Blake2b256::merkle_root(receipt_hashes);
+    // Receipts root (accumulated during execution)
+    result.receipts_root = receipts_acc.root();
     
     return result;
 }
@@ -1370,11 +1751,16 @@ bool BlockProcessor::validate_block(const Block& block) const {
     }
     
     // Check transactions root
-    auto computed_root = const_cast<Block&>(block).compute_transactions_root();
+    auto computed_root = block.compute_transactions_root();
     if (computed_root != block.header.transactions_root) {
         return false;
     }
     
+    // Check transaction signatures (one batch for the whole block)
+    if (!block.verify_signatures()) {
+        return false;
+    }
+    
     return true;
 }
 
@@ -1410,40 +1796,31 @@ uint64_t BlockProcessor::calculate_base_fee(const BlockHeader& parent,
 // ============================================================================
 
 Bytes ValidityProof::encode() const {
-    Bytes result;
+    ByteWriter out(3 * 8 + 3 * 32 + 8 + 32 * state_proof.size() +
+                   8 + 32 * execution_trace.size() + 3 * 32);
     
-    auto append_uint64 = [&result](uint64_t v) {
-        for (int i = 7; i >= 0; --i) {
-            result.push_back(static_cast<uint8_t>((v >> (i * 8)) & 0xFF));
-        }
-    };
-    
-    auto append_hash = [&result](const Hash256& h) {
-        result.insert(result.end(), h.begin(), h.end());
-    };
+    out.u64_be(batch_id);
+    out.u64_be(start_block);
+    out.u64_be(end_block);
+    out.bytes(pre_state_root);
+    out.bytes(post_state_root);
+    out.bytes(transactions_root);
     
-    append_uint64(batch_id);
-    append_uint64(start_block);
-    append_uint64(end_block);
-    append_hash(pre_state_root);
-    append_hash(post_state_root);
-    append_hash(transactions_root);
-    
-    append_uint64(state_proof.size());
+    out.u64_be(state_proof.size());
     for (const auto& h : state_proof) {
-        append_hash(h);
+        out.bytes(h);
     }
     
-    append_uint64(execution_trace.size());
+    out.u64_be(execution_trace.size());
     for (const auto& h : execution_trace) {
-        append_hash(h);
+        out.bytes(h);
     }
     
-    append_hash(commitment);
-    append_hash(proof_hash);
-    append_hash(verification_key);
+    out.bytes(commitment);
+    out.bytes(proof_hash);
+    out.bytes(verification_key);
     
-    return result;
+    return out.finish();
 }
 
 std::optional<ValidityProof> ValidityProof::decode(const Bytes& data) {
@@ -1546,12 +1923,13 @@ ValidityProof ZKProver::generate_proof(
     proof.pre_state_root = pre_state_root;
     proof.post_state_root = post_state_root;
     
-    // Compute transactions root
-    std::vector<Hash256> tx_hashes;
+    // Compute transactions root (per-block roots are cached on the blocks)
+    std::vector<Hash256> tx_roots;
+    tx_roots.reserve(blocks.size());
     for (const auto& block : blocks) {
-        tx_hashes.push_back(block.compute_transactions_root());
+        tx_roots.push_back(block.compute_transactions_root());
     }
-    proof.transactions_root = crypto::Blake2b256::merkle_root(tx_hashes);
+    proof.transactions_root = crypto::MerkleTree(std::move(tx_roots)).root();
     
     // Build state proof (Merkle path from pre to post)
     proof.state_proof = build_state_proof(pre_state_root, post_state_root);
@@ -1629,7 +2007,8 @@ Hash256 ZKProver::compute_execution_digest(const std::vector<TransactionReceipt>
         receipt_hashes.push_back(r.hash());
     }
     
-    return crypto::Blake2b256::merkle_root(receipt_hashes);
+    // Levels are hashed in one pass, split across threads for large batches
+    return crypto::MerkleTree(std::move(receipt_hashes)).root();
 }
 
 std::vector<Hash256> ZKProver::build_state_proof(const Hash256& pre, const Hash256& post) {
@@ -1652,20 +2031,18 @@ std::vector<Hash256> ZKProver::build_state_proof(const Hash256& pre, const Hash2
 
 Hash256 ZKProver::generate_proof_hash(const Hash256& commitment,
                                        const std::vector<Hash256>& trace) const {
-    Bytes data;
-    data.insert(data.end(), commitment.begin(), commitment.end());
-    data.insert(data.end(), verification_key_.begin(), verification_key_.end());
+    crypto::Blake2bHasher hasher;
+    hasher.update(commitment);
+    hasher.update(verification_key_);
     
     for (const auto& h : trace) {
-        data.insert(data.end(), h.begin(), h.end());
+        hasher.update(h);
     }
     
     // Multiple rounds of hashing for security margin
-    Hash256 result = crypto::Blake2b256::hash(data);
+    Hash256 result = hasher.final();
     for (int i = 0; i < 3; ++i) {
-        Bytes round_data(result.begin(), result.end());
-        round_data.insert(round_data.end(), commitment.begin(), commitment.end());
-        result = crypto::Blake2b256::hash(round_data);
+        result = crypto::Blake2bHasher().update(result).update(commitment).final();
     }
     
     return result;
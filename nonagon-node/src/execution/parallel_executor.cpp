@@ -0,0 +1,809 @@
+#include "nonagon/execution.hpp"
+#include "nonagon/crypto.hpp"
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace nonagon {
+namespace execution {
+
+namespace {
+
+using TxIndex = uint32_t;
+
+// Transaction and incarnation that wrote a value
+struct Version {
+    TxIndex tx{0};
+    uint32_t incarnation{0};
+
+    bool operator==(const Version&) const = default;
+};
+
+/**
+ * One unit of state whose reads and writes are tracked. Accounts are
+ * identified by payment credential, as in StateManager; code is keyed by
+ * its hash, so a blob is shared by every account that runs it.
+ */
+struct Location {
+    enum class Kind : uint8_t { Account, Storage, Code };
+
+    Kind kind{Kind::Account};
+    std::array<uint8_t, 28> credential{};
+    Hash256 key{};  // Storage slot, or code hash
+
+    bool operator==(const Location&) const = default;
+
+    static Location account(const Address& addr) {
+        return {Kind::Account, addr.payment_credential, {}};
+    }
+    static Location storage(const Address& addr, const Hash256& slot) {
+        return {Kind::Storage, addr.payment_credential, slot};
+    }
+    static Location code(const Hash256& code_hash) {
+        return {Kind::Code, {}, code_hash};
+    }
+};
+
+struct LocationHash {
+    size_t operator()(const Location& loc) const {
+        // FNV-1a over the kind, credential and key
+        uint64_t h = 0xcbf29ce484222325ULL ^ static_cast<uint8_t>(loc.kind);
+        for (uint8_t b : loc.credential) h = (h ^ b) * 0x100000001b3ULL;
+        for (uint8_t b : loc.key) h = (h ^ b) * 0x100000001b3ULL;
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * Contents of a location: `account` for an account, `bytes` for a storage
+ * slot or code. `addr` is the address it was written through, which is
+ * what the final write to the StateManager goes through.
+ */
+struct Value {
+    Address addr;
+    AccountState account;
+    Bytes bytes;
+};
+
+// A read and where it was served from: a lower transaction's write, or
+// the StateManager when `version` is empty. A read of the coinbase also
+// records the fees added on top of that.
+struct ReadEntry {
+    Location location;
+    std::optional<Version> version;
+    std::optional<uint64_t> fees;
+};
+
+// Thrown out of an execution that read an estimate of `blocking`
+struct ReadBlocked {
+    TxIndex blocking;
+};
+
+} // namespace
+
+// ============================================================================
+// Multi-Version Store
+// ============================================================================
+
+/**
+ * Fees are not written to the coinbase account. Each incarnation records
+ * the fee it credited, and a read of the coinbase is its latest write plus
+ * the fees of the transactions from that writer up to the reader, so the
+ * producer's account is only a conflict for transactions that touch it.
+ */
+class ParallelExecutor::MultiVersionStore {
+public:
+    MultiVersionStore(size_t tx_count, const Location& coinbase)
+        : records_(tx_count), coinbase_(coinbase) {}
+
+    enum class ReadStatus { Found, NotFound, Blocked };
+
+    struct ReadResult {
+        ReadStatus status{ReadStatus::NotFound};
+        Version version;  // Writer if Found, blocking transaction if Blocked
+        Value value;
+        std::optional<uint64_t> fees;  // Credited to the coinbase since `version`
+    };
+
+    // Latest write to `loc` by a transaction below `tx`
+    ReadResult read(const Location& loc, TxIndex tx) const {
+        ReadResult result;
+        {
+            const Shard& shard = shard_for(loc);
+            std::lock_guard lock(shard.mutex);
+            if (const auto* entry = latest_below(shard, loc, tx, result)) {
+                result.value = entry->value;
+            }
+        }
+        if (loc == coinbase_ && result.status != ReadStatus::Blocked) {
+            add_fees(result.status == ReadStatus::Found ? result.version.tx : 0, tx, result);
+        }
+        return result;
+    }
+
+    /**
+     * Publish an incarnation's writes and read set. Locations the previous
+     * incarnation wrote and this one did not are withdrawn. Returns true if
+     * it wrote a location the previous incarnation did not, which may
+     * invalidate higher transactions that already passed validation.
+     */
+    bool record(Version version, std::vector<ReadEntry> reads,
+                std::vector<std::pair<Location, Value>> writes,
+                std::optional<uint64_t> fee) {
+        std::vector<Location> locations;
+        locations.reserve(writes.size());
+        for (auto& [loc, value] : writes) {
+            Shard& shard = shard_for(loc);
+            std::lock_guard lock(shard.mutex);
+            shard.data[loc][version.tx] = Entry{version.incarnation, false, std::move(value)};
+            locations.push_back(loc);
+        }
+
+        TxRecord& record = records_[version.tx];
+        std::vector<Location> previous;
+        {
+            std::lock_guard lock(record.mutex);
+            previous = std::exchange(record.writes, locations);
+        }
+
+        auto contains = [](const std::vector<Location>& set, const Location& loc) {
+            return std::find(set.begin(), set.end(), loc) != set.end();
+        };
+        for (const auto& loc : previous) {
+            if (contains(locations, loc)) continue;
+            Shard& shard = shard_for(loc);
+            std::lock_guard lock(shard.mutex);
+            auto it = shard.data.find(loc);
+            if (it != shard.data.end()) it->second.erase(version.tx);
+        }
+
+        {
+            std::lock_guard lock(record.mutex);
+            record.reads = std::move(reads);
+            record.executed = true;
+            record.fee = fee;
+        }
+
+        for (const auto& loc : locations) {
+            if (!contains(previous, loc)) return true;
+        }
+        return false;
+    }
+
+    // True if every read of the last incarnation of `tx` would still be
+    // served from the same place
+    bool validate(TxIndex tx) const {
+        const TxRecord& record = records_[tx];
+        std::lock_guard lock(record.mutex);
+
+        for (const auto& read : record.reads) {
+            ReadResult current;
+            {
+                const Shard& shard = shard_for(read.location);
+                std::lock_guard shard_lock(shard.mutex);
+                latest_below(shard, read.location, tx, current);
+            }
+            switch (current.status) {
+                case ReadStatus::Blocked:
+                    return false;
+                case ReadStatus::NotFound:
+                    if (read.version) return false;
+                    break;
+                case ReadStatus::Found:
+                    if (!read.version || !(*read.version == current.version)) return false;
+                    break;
+            }
+            if (read.location == coinbase_) {
+                add_fees(current.status == ReadStatus::Found ? current.version.tx : 0, tx,
+                         current);
+                if (current.status == ReadStatus::Blocked || current.fees != read.fees) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Mark the writes of an aborted incarnation as estimates, so readers
+    // wait for the next one instead of reading stale values
+    void convert_writes_to_estimates(TxIndex tx) {
+        TxRecord& record = records_[tx];
+        std::lock_guard record_lock(record.mutex);
+        record.executed = false;
+
+        for (const auto& loc : record.writes) {
+            Shard& shard = shard_for(loc);
+            std::lock_guard lock(shard.mutex);
+            shard.data[loc][tx].estimate = true;
+        }
+    }
+
+    // Final value of every written location: the write of the highest
+    // transaction. Only valid once every transaction has been validated.
+    template <typename Fn>
+    void for_each_final(Fn&& fn) const {
+        for (const auto& shard : shards_) {
+            for (const auto& [loc, versions] : shard.data) {
+                if (!versions.empty()) fn(loc, versions.rbegin()->second.value);
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t incarnation{0};
+        bool estimate{false};
+        Value value;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<Location, std::map<TxIndex, Entry>, LocationHash> data;
+    };
+
+    // Last incarnation's read set, written locations and fee
+    struct TxRecord {
+        mutable std::mutex mutex;
+        std::vector<ReadEntry> reads;
+        std::vector<Location> writes;
+        bool executed{false};         // Cleared while its writes are estimates
+        std::optional<uint64_t> fee;  // Credited after its last coinbase write
+    };
+
+    static constexpr size_t SHARDS = 64;  // Power of two
+
+    std::array<Shard, SHARDS> shards_;
+    std::vector<TxRecord> records_;
+    const Location coinbase_;
+
+    // Adds the fees of transactions [from, to) to `result`, or marks it
+    // Blocked on the first one without a fee yet. Caller holds no shard
+    // lock; record locks are only ever nested higher before lower.
+    void add_fees(TxIndex from, TxIndex to, ReadResult& result) const {
+        for (TxIndex i = from; i < to; ++i) {
+            const TxRecord& record = records_[i];
+            std::lock_guard lock(record.mutex);
+            if (!record.executed) {
+                result.status = ReadStatus::Blocked;
+                result.version = {i, 0};
+                return;
+            }
+            if (record.fee) result.fees = result.fees.value_or(0) + *record.fee;
+        }
+    }
+
+    // Fills in status and version; returns the entry if Found. Caller
+    // holds the shard lock.
+    static const Entry* latest_below(const Shard& shard, const Location& loc, TxIndex tx,
+                                     ReadResult& result) {
+        auto it = shard.data.find(loc);
+        if (it == shard.data.end()) return nullptr;
+
+        auto entry = it->second.lower_bound(tx);
+        if (entry == it->second.begin()) return nullptr;
+        --entry;
+
+        if (entry->second.estimate) {
+            result.status = ReadStatus::Blocked;
+            result.version = {entry->first, 0};
+            return nullptr;
+        }
+        result.status = ReadStatus::Found;
+        result.version = {entry->first, entry->second.incarnation};
+        return &entry->second;
+    }
+
+    Shard& shard_for(const Location& loc) {
+        return shards_[LocationHash{}(loc) & (SHARDS - 1)];
+    }
+    const Shard& shard_for(const Location& loc) const {
+        return shards_[LocationHash{}(loc) & (SHARDS - 1)];
+    }
+};
+
+// ============================================================================
+// Scheduler
+// ============================================================================
+
+/**
+ * Hands out execution and validation tasks, lowest transaction first.
+ * Two shared indices track the next transaction to execute and to
+ * validate; aborts and re-executions move them back down. The block is
+ * done once both have passed the last transaction with no task in flight
+ * and no decrease raced the check.
+ */
+class ParallelExecutor::Scheduler {
+public:
+    explicit Scheduler(size_t tx_count) : count_(tx_count), txs_(tx_count) {}
+
+    struct Task {
+        enum class Kind { None, Execute, Validate };
+        Kind kind{Kind::None};
+        Version version;
+    };
+
+    bool done() const { return done_.load(); }
+
+    Task next_task() {
+        if (validation_idx_.load() < execution_idx_.load()) {
+            if (auto version = next_version_to_validate()) {
+                return {Task::Kind::Validate, *version};
+            }
+        } else if (auto version = next_version_to_execute()) {
+            return {Task::Kind::Execute, *version};
+        }
+        return {};
+    }
+
+    /**
+     * Park `tx` until `blocking` has executed again. Returns false if that
+     * already happened, in which case the caller re-executes `tx` at once.
+     */
+    bool add_dependency(TxIndex tx, TxIndex blocking) {
+        TxState& blocker = txs_[blocking];
+        std::lock_guard blocker_lock(blocker.mutex);
+        if (blocker.status == Status::Executed) return false;
+
+        {
+            // Held under the blocker's lock, so its resume cannot run first
+            std::lock_guard lock(txs_[tx].mutex);
+            txs_[tx].status = Status::Aborting;
+        }
+        blocker.dependents.push_back(tx);
+        active_tasks_.fetch_sub(1);
+        return true;
+    }
+
+    Task finish_execution(Version version, bool wrote_new_location) {
+        std::vector<TxIndex> dependents;
+        {
+            TxState& state = txs_[version.tx];
+            std::lock_guard lock(state.mutex);
+            state.status = Status::Executed;
+            dependents.swap(state.dependents);
+        }
+        resume(dependents);
+
+        if (validation_idx_.load() > version.tx) {
+            if (!wrote_new_location) {
+                // Only this transaction needs validating again
+                return {Task::Kind::Validate, version};
+            }
+            decrease_validation_idx(version.tx);
+        }
+        active_tasks_.fetch_sub(1);
+        return {};
+    }
+
+    // Claim the abort of an incarnation that failed validation; only the
+    // first validator to get here does
+    bool try_validation_abort(Version version) {
+        TxState& state = txs_[version.tx];
+        std::lock_guard lock(state.mutex);
+        if (state.status == Status::Executed && state.incarnation == version.incarnation) {
+            state.status = Status::Aborting;
+            return true;
+        }
+        return false;
+    }
+
+    Task finish_validation(TxIndex tx, bool aborted) {
+        if (aborted) {
+            set_ready(tx);
+            decrease_validation_idx(tx + 1);
+            if (execution_idx_.load() > tx) {
+                // Re-execute straight away rather than waiting for the index
+                if (auto version = try_incarnate(tx)) {
+                    return {Task::Kind::Execute, *version};
+                }
+            }
+        }
+        active_tasks_.fetch_sub(1);
+        return {};
+    }
+
+private:
+    enum class Status : uint8_t { ReadyToExecute, Executing, Executed, Aborting };
+
+    struct TxState {
+        std::mutex mutex;
+        Status status{Status::ReadyToExecute};
+        uint32_t incarnation{0};
+        std::vector<TxIndex> dependents;  // Waiting for this one to execute
+    };
+
+    const size_t count_;
+    std::vector<TxState> txs_;
+    std::atomic<size_t> execution_idx_{0};
+    std::atomic<size_t> validation_idx_{0};
+    std::atomic<size_t> decrease_count_{0};
+    std::atomic<size_t> active_tasks_{0};
+    std::atomic<bool> done_{false};
+
+    void decrease_execution_idx(size_t target) {
+        size_t current = execution_idx_.load();
+        while (current > target && !execution_idx_.compare_exchange_weak(current, target)) {}
+        decrease_count_.fetch_add(1);
+    }
+
+    void decrease_validation_idx(size_t target) {
+        size_t current = validation_idx_.load();
+        while (current > target && !validation_idx_.compare_exchange_weak(current, target)) {}
+        decrease_count_.fetch_add(1);
+    }
+
+    void check_done() {
+        size_t observed = decrease_count_.load();
+        if (std::min(execution_idx_.load(), validation_idx_.load()) >= count_ &&
+            active_tasks_.load() == 0 && observed == decrease_count_.load()) {
+            done_.store(true);
+        }
+    }
+
+    std::optional<Version> try_incarnate(size_t tx) {
+        if (tx < count_) {
+            TxState& state = txs_[tx];
+            std::lock_guard lock(state.mutex);
+            if (state.status == Status::ReadyToExecute) {
+                state.status = Status::Executing;
+                return Version{static_cast<TxIndex>(tx), state.incarnation};
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<Version> next_version_to_execute() {
+        if (execution_idx_.load() >= count_) {
+            check_done();
+            return std::nullopt;
+        }
+        active_tasks_.fetch_add(1);
+        auto version = try_incarnate(execution_idx_.fetch_add(1));
+        if (!version) active_tasks_.fetch_sub(1);
+        return version;
+    }
+
+    std::optional<Version> next_version_to_validate() {
+        if (validation_idx_.load() >= count_) {
+            check_done();
+            return std::nullopt;
+        }
+        active_tasks_.fetch_add(1);
+        size_t tx = validation_idx_.fetch_add(1);
+        if (tx < count_) {
+            TxState& state = txs_[tx];
+            std::lock_guard lock(state.mutex);
+            if (state.status == Status::Executed) {
+                return Version{static_cast<TxIndex>(tx), state.incarnation};
+            }
+        }
+        active_tasks_.fetch_sub(1);
+        return std::nullopt;
+    }
+
+    void set_ready(TxIndex tx) {
+        TxState& state = txs_[tx];
+        std::lock_guard lock(state.mutex);
+        state.incarnation++;
+        state.status = Status::ReadyToExecute;
+    }
+
+    void resume(const std::vector<TxIndex>& dependents) {
+        if (dependents.empty()) return;
+        for (TxIndex tx : dependents) set_ready(tx);
+        decrease_execution_idx(*std::min_element(dependents.begin(), dependents.end()));
+    }
+};
+
+// ============================================================================
+// Incarnation View
+// ============================================================================
+
+/**
+ * StateView for one incarnation. Its own writes are buffered and
+ * journaled like StateManager's; everything else is read through the
+ * multi-version store, falling back to the StateManager, and remembered so
+ * that each location is read once per incarnation. Fees to the coinbase
+ * are held back as they are by StateManager.
+ */
+class ParallelExecutor::IncarnationView : public storage::StateView {
+public:
+    explicit IncarnationView(const storage::StateManager& base) : base_(base) {}
+
+    void begin(const MultiVersionStore& store, TxIndex tx, const Address& coinbase) {
+        store_ = &store;
+        tx_ = tx;
+        coinbase_ = Location::account(coinbase);
+        fee_.reset();
+        reads_.clear();
+        writes_.clear();
+        journal_.clear();
+    }
+
+    std::vector<ReadEntry> take_reads() {
+        std::vector<ReadEntry> reads;
+        reads.reserve(reads_.size());
+        for (auto& [loc, read] : reads_) reads.push_back({loc, read.version, read.fees});
+        return reads;
+    }
+
+    // Fee credited to the coinbase since this incarnation last wrote it
+    std::optional<uint64_t> fee() const { return fee_; }
+
+    std::vector<std::pair<Location, Value>> take_writes() {
+        std::vector<std::pair<Location, Value>> writes;
+        writes.reserve(writes_.size());
+        for (auto& [loc, value] : writes_) writes.emplace_back(loc, std::move(value));
+        return writes;
+    }
+
+    AccountState get_account(const Address& addr) const override {
+        const Location loc = Location::account(addr);
+        AccountState state;
+        if (auto it = writes_.find(loc); it != writes_.end()) {
+            state = it->second.account;
+        } else {
+            state = read(loc, [&](Value& value) { value.account = base_.get_account(addr); }).account;
+        }
+        if (fee_ && loc == coinbase_) state.balance += *fee_;
+        return state;
+    }
+
+    void set_account(const Address& addr, const AccountState& state) override {
+        const Location loc = Location::account(addr);
+        if (loc == coinbase_) fee_.reset();
+        auto it = writes_.find(loc);
+        journal_.push_back({loc, it != writes_.end() ? std::optional<Value>(it->second)
+                                                     : std::nullopt});
+        Value& value = writes_[loc];
+        value.addr = addr;
+        value.account = state;
+    }
+
+    Bytes get_storage(const Address& addr, const Hash256& key) const override {
+        const Location loc = Location::storage(addr, key);
+        if (auto it = writes_.find(loc); it != writes_.end()) return it->second.bytes;
+        return read(loc, [&](Value& value) { value.bytes = base_.get_storage(addr, key); }).bytes;
+    }
+
+    void set_storage(const Address& addr, const Hash256& key, const Bytes& data) override {
+        Value& value = writes_[Location::storage(addr, key)];
+        value.addr = addr;
+        value.bytes = data;
+    }
+
+    Bytes get_code(const Address& addr) const override {
+        const Hash256 code_hash = get_account(addr).code_hash;
+        const Location loc = Location::code(code_hash);
+        if (auto it = writes_.find(loc); it != writes_.end()) return it->second.bytes;
+        return read(loc, [&](Value& value) {
+            value.bytes = base_.get_code_by_hash(code_hash);
+        }).bytes;
+    }
+
+    void set_code(const Address& addr, const Bytes& code) override {
+        auto code_hash = crypto::Blake2b256::hash(code);
+        writes_[Location::code(code_hash)].bytes = code;
+
+        auto state = get_account(addr);
+        state.code_hash = code_hash;
+        set_account(addr, state);
+    }
+
+    void credit_fee(const Address& coinbase, uint64_t amount) override {
+        if (Location::account(coinbase) == coinbase_) {
+            fee_ = fee_.value_or(0) + amount;
+        } else {
+            add_balance(coinbase, amount);
+        }
+    }
+
+    Snapshot snapshot() const override {
+        return Snapshot{Hash256{}, journal_.size(), fee_};
+    }
+
+    // Account writes since the snapshot are undone; like StateManager,
+    // storage and code writes stay
+    void revert(const Snapshot& snap) override {
+        while (journal_.size() > snap.journal_size) {
+            auto& entry = journal_.back();
+            if (entry.prev) {
+                writes_[entry.location] = std::move(*entry.prev);
+            } else {
+                writes_.erase(entry.location);
+            }
+            journal_.pop_back();
+        }
+        fee_ = snap.pending_fees;
+    }
+
+private:
+    struct Read {
+        std::optional<Version> version;
+        Value value;
+        std::optional<uint64_t> fees;
+    };
+
+    struct JournalEntry {
+        Location location;
+        std::optional<Value> prev;  // Empty if this transaction had not written it
+    };
+
+    const storage::StateManager& base_;
+    const MultiVersionStore* store_{nullptr};
+    TxIndex tx_{0};
+    Location coinbase_;
+    std::optional<uint64_t> fee_;
+
+    mutable std::unordered_map<Location, Read, LocationHash> reads_;
+    std::unordered_map<Location, Value, LocationHash> writes_;
+    std::vector<JournalEntry> journal_;
+
+    template <typename Fallback>
+    const Value& read(const Location& loc, Fallback&& from_base) const {
+        if (auto it = reads_.find(loc); it != reads_.end()) return it->second.value;
+
+        auto result = store_->read(loc, tx_);
+        Read entry;
+        switch (result.status) {
+            case MultiVersionStore::ReadStatus::Blocked:
+                throw ReadBlocked{result.version.tx};
+            case MultiVersionStore::ReadStatus::Found:
+                entry.version = result.version;
+                entry.value = std::move(result.value);
+                break;
+            case MultiVersionStore::ReadStatus::NotFound:
+                from_base(entry.value);
+                break;
+        }
+        if (result.fees) {
+            entry.fees = result.fees;
+            entry.value.account.balance += *result.fees;
+        }
+        return reads_.emplace(loc, std::move(entry)).first->second.value;
+    }
+};
+
+// ============================================================================
+// ParallelExecutor Implementation
+// ============================================================================
+
+struct ParallelExecutor::Worker {
+    explicit Worker(const storage::StateManager& base)
+        : view(std::make_shared<IncarnationView>(base)),
+          evm(std::make_shared<EVM>(view)),
+          processor(view, evm) {}
+
+    std::shared_ptr<IncarnationView> view;
+    std::shared_ptr<EVM> evm;
+    TransactionProcessor processor;
+    Stats stats;
+};
+
+ParallelExecutor::ParallelExecutor(std::shared_ptr<storage::StateManager> state, size_t threads)
+    : state_(state), pool_(std::max<size_t>(threads, 1)) {
+    for (size_t i = 0; i < pool_.size(); ++i) {
+        workers_.push_back(std::make_unique<Worker>(*state_));
+    }
+}
+
+ParallelExecutor::~ParallelExecutor() = default;
+
+std::vector<std::optional<TransactionProcessor::ProcessResult>> ParallelExecutor::execute(
+    const std::vector<TransactionPtr>& txs, const ExecutionContext& ctx,
+    const Admission& admit) {
+
+    std::vector<std::optional<TransactionProcessor::ProcessResult>> results(txs.size());
+    stats_ = Stats{};
+    if (txs.empty()) return results;
+
+    const Location coinbase = Location::account(ctx.coinbase);
+    MultiVersionStore store(txs.size(), coinbase);
+    Scheduler scheduler(txs.size());
+
+    // Outcome of each transaction's latest incarnation. Only the worker
+    // running an incarnation writes its slot.
+    std::vector<std::exception_ptr> errors(txs.size());
+
+    pool_.parallel_for(workers_.size(), [&](size_t w) {
+        Worker& worker = *workers_[w];
+
+        auto try_execute = [&](Version version) -> Scheduler::Task {
+            const Transaction& tx = *txs[version.tx];
+            ExecutionContext tx_ctx = ctx;
+            tx_ctx.caller = tx.from;
+            tx_ctx.origin = tx.from;
+            tx_ctx.gas_price = tx.effective_gas_price(ctx.base_fee);
+
+            while (true) {
+                worker.view->begin(store, version.tx, ctx.coinbase);
+                worker.stats.executions++;
+                try {
+                    errors[version.tx] = nullptr;
+                    if (!admit || admit(*worker.view, tx)) {
+                        results[version.tx] = worker.processor.process(tx, tx_ctx);
+                    } else {
+                        results[version.tx].reset();
+                    }
+                } catch (const ReadBlocked& blocked) {
+                    worker.stats.suspensions++;
+                    if (scheduler.add_dependency(version.tx, blocked.blocking)) {
+                        return {};
+                    }
+                    continue;  // Dependency already resolved
+                } catch (...) {
+                    // Rethrown after the block if this incarnation stands;
+                    // it may just be the product of an inconsistent read
+                    errors[version.tx] = std::current_exception();
+                }
+                break;
+            }
+
+            bool wrote_new = store.record(version, worker.view->take_reads(),
+                                          worker.view->take_writes(), worker.view->fee());
+            return scheduler.finish_execution(version, wrote_new);
+        };
+
+        auto try_validate = [&](Version version) -> Scheduler::Task {
+            worker.stats.validations++;
+            bool aborted = !store.validate(version.tx) && scheduler.try_validation_abort(version);
+            if (aborted) {
+                worker.stats.aborts++;
+                store.convert_writes_to_estimates(version.tx);
+            }
+            return scheduler.finish_validation(version.tx, aborted);
+        };
+
+        Scheduler::Task task;
+        while (!scheduler.done()) {
+            if (task.kind == Scheduler::Task::Kind::Execute) {
+                task = try_execute(task.version);
+            } else if (task.kind == Scheduler::Task::Kind::Validate) {
+                task = try_validate(task.version);
+            } else {
+                task = scheduler.next_task();
+            }
+        }
+    });
+
+    for (auto& worker : workers_) {
+        stats_.executions += worker->stats.executions;
+        stats_.validations += worker->stats.validations;
+        stats_.aborts += worker->stats.aborts;
+        stats_.suspensions += worker->stats.suspensions;
+        worker->stats = Stats{};
+    }
+
+    // A transaction that throws fails the block, as it would serially;
+    // nothing is applied
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    store.for_each_final([&](const Location& loc, const Value& value) {
+        switch (loc.kind) {
+            case Location::Kind::Account:
+                state_->set_account(value.addr, value.account);
+                break;
+            case Location::Kind::Storage:
+                state_->set_storage(value.addr, loc.key, value.bytes);
+                break;
+            case Location::Kind::Code:
+                state_->put_code(value.bytes);
+                break;
+        }
+    });
+
+    // Fees of the transactions from the coinbase's last writer on, in one
+    // credit
+    auto fees = store.read(coinbase, static_cast<TxIndex>(txs.size())).fees;
+    if (fees) state_->credit_fee(ctx.coinbase, *fees);
+
+    return results;
+}
+
+} // namespace execution
+} // namespace nonagon
@@ -50,6 +50,7 @@ void print_usage(const char* program) {
               << "  --sequencer          Enable sequencer mode\n"
               << "  --rpc-port <port>    RPC HTTP port (default: 8545)\n"
               << "  --p2p-port <port>    P2P port (default: 30303)\n"
+              << "  --exec-threads <n>   Execute blocks in parallel on n threads (default: serial)\n"
               << "  --log-level <level>  Log level: trace, debug, info, warn, error\n"
               << "  --help               Show this help message\n"
               << std::endl;
@@ -76,6 +77,8 @@ NodeConfig parse_args(int argc, char* argv[]) {
             config.rpc.http_port = static_cast<uint16_t>(std::stoi(argv[++i]));
         } else if (arg == "--p2p-port" && i + 1 < argc) {
             config.network.listen_port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--exec-threads" && i + 1 < argc) {
+            config.execution_threads = static_cast<size_t>(std::stoul(argv[++i]));
         } else if (arg == "--log-level" && i + 1 < argc) {
             std::string level = argv[++i];
             if (level == "trace") config.log_level = NodeConfig::LogLevel::Trace;
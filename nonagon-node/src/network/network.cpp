@@ -1,4 +1,6 @@
 #include "nonagon/network.hpp"
+#include "nonagon/storage.hpp"
+#include "nonagon/byte_io.hpp"
 #include <iostream>
 #include <thread>
 #include <cstring>
@@ -57,36 +59,24 @@ std::string PeerId::to_string() const {
 // ============================================================================
 
 Bytes Message::encode() const {
-    Bytes data;
-    data.push_back(static_cast<uint8_t>(type));
-    // Timestamp
-    for (int i = 7; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((timestamp >> (i * 8)) & 0xFF));
-    }
-    // Size
-    uint32_t size = static_cast<uint32_t>(payload.size());
-    for (int i = 3; i >= 0; --i) {
-        data.push_back(static_cast<uint8_t>((size >> (i * 8)) & 0xFF));
-    }
-    data.insert(data.end(), payload.begin(), payload.end());
-    return data;
+    // Type, timestamp, payload size, payload
+    ByteWriter out(1 + 8 + 4 + payload.size());
+    out.u8(static_cast<uint8_t>(type));
+    out.u64_be(timestamp);
+    out.u32_be(static_cast<uint32_t>(payload.size()));
+    out.bytes(payload);
+    return out.finish();
 }
 
 std::optional<Message> Message::decode(const Bytes& data) {
-    if (data.size() < 13) return std::nullopt;
+    ByteReader in(data);
     Message msg;
-    size_t offset = 0;
-    msg.type = static_cast<MessageType>(data[offset++]);
-    msg.timestamp = 0;
-    for (int i = 0; i < 8; ++i) {
-        msg.timestamp = (msg.timestamp << 8) | data[offset++];
-    }
-    uint32_t size = 0;
-    for (int i = 0; i < 4; ++i) {
-        size = (size << 8) | data[offset++];
-    }
-    if (data.size() < offset + size) return std::nullopt;
-    msg.payload.assign(data.begin() + offset, data.begin() + offset + size);
+    msg.type = static_cast<MessageType>(in.u8());
+    msg.timestamp = in.u64_be();
+    uint32_t size = in.u32_be();
+    const uint8_t* payload = in.take(size);
+    if (!payload) return std::nullopt;
+    msg.payload.assign(payload, payload + size);
     return msg;
 }
 
@@ -323,6 +313,7 @@ BlockSynchronizer::BlockSynchronizer(std::shared_ptr<P2PNetwork> network,
 void BlockSynchronizer::start(SyncMode mode) {
     mode_ = mode;
     syncing_ = true;
+    
     sync_thread_ = std::thread([this]() {
         std::cout << "[SYNC] Block synchronizer started" << std::endl;
         while (syncing_) {
@@ -352,6 +343,51 @@ void BlockSynchronizer::stop() {
     if (sync_thread_.joinable()) sync_thread_.join();
 }
 
+bool BlockSynchronizer::import_block(const Bytes& encoded) {
+    // Nothing here needs a materialized Block; that is left to execution
+    auto view = BlockView::parse(encoded);
+    if (!view) return false;
+    
+    uint64_t number = view->number();
+    if (blocks_->get_block_bytes(number)) return false;  // Already known
+    
+    // Must extend the local head; a fresh store accepts the first block
+    uint64_t head = blocks_->get_head();
+    auto parent_raw = blocks_->get_block_bytes(head);
+    if (parent_raw) {
+        if (number != head + 1) return false;
+        auto parent = BlockView::parse(*parent_raw);
+        if (!parent || parent->header_hash() != view->parent_hash()) return false;
+    } else if (number > head + 1) {
+        return false;
+    }
+    
+    auto tx_hashes = view->transaction_hashes();
+    crypto::MerkleAccumulator tx_root;
+    for (const auto& h : tx_hashes) tx_root.append(h);
+    if (tx_root.root() != view->transactions_root()) {
+        std::cout << "[SYNC] Rejected block #" << number << ": transactions root mismatch" << std::endl;
+        return false;
+    }
+    if (!view->verify_signatures(tx_hashes)) {
+        std::cout << "[SYNC] Rejected block #" << number << ": invalid transaction signature" << std::endl;
+        return false;
+    }
+    
+    if (number > target_block_) target_block_ = number;
+    
+    // Stored exactly as received; no decode/re-encode round trip
+    blocks_->store_encoded_block(number, view->header_hash(), encoded);
+    for (size_t i = 0; i < tx_hashes.size(); ++i) {
+        blocks_->index_transaction(tx_hashes[i], number, static_cast<uint32_t>(i));
+    }
+    
+    current_block_ = number;
+    if (progress_cb_) progress_cb_(number, target_block_);
+    if (complete_cb_ && number >= target_block_) complete_cb_();
+    return true;
+}
+
 BlockSynchronizer::SyncStatus BlockSynchronizer::status() const {
     SyncStatus s;
     s.syncing = syncing_;
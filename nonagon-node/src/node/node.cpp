@@ -56,6 +56,7 @@ NodeConfig NodeConfig::from_file(const std::string& path) {
                  else if (key == "is_sequencer") config.is_sequencer = (val_str == "true");
                  else if (key == "sequencer_key_file") config.sequencer_key_file = val_str;
                  else if (key == "sequencer_address") config.sequencer_address = Address::from_hex(val_str).value_or(Address{});
+                 else if (key == "execution_threads") config.execution_threads = to_uint64(val_str);
             }
             else if (current_section == "network") {
                  if (key == "listen_port") config.network.listen_port = to_uint16(val_str);
@@ -92,6 +93,7 @@ void NodeConfig::save_to_file(const std::string& path) const {
         file << "is_sequencer = " << (is_sequencer ? "true" : "false") << "\n";
         if (!sequencer_key_file.empty()) file << "sequencer_key_file = \"" << sequencer_key_file << "\"\n";
         if (is_sequencer) file << "sequencer_address = \"" << sequencer_address.to_hex() << "\"\n";
+        file << "execution_threads = " << execution_threads << "\n";
         file << "\n";
 
         file << "[network]\n";
@@ -221,6 +223,13 @@ std::string Metrics::prometheus_export() const {
         ss << name << " " << value << "\n";
     }
     
+    // Signature cache counters live in the cache itself
+    auto sig_cache = crypto::SignatureCache::instance().stats();
+    ss << SIG_CACHE_HITS << " " << sig_cache.hits << "\n";
+    ss << SIG_CACHE_MISSES << " " << sig_cache.misses << "\n";
+    ss << SIG_CACHE_HIT_RATE << " " << sig_cache.hit_rate() << "\n";
+    ss << SIG_CACHE_SIZE << " " << sig_cache.size << "\n";
+    
     return ss.str();
 }
 
@@ -255,6 +264,16 @@ bool Node::initialize() {
         state_manager_ = std::make_shared<storage::StateManager>(db_);
         block_store_ = std::make_shared<storage::BlockStore>(db_);
         
+        // Initialize execution layer; the parallel executor runs the same
+        // processor per worker, so both paths produce the same state
+        std::cout << "[NONAGON]   Initializing execution..." << std::endl;
+        evm_ = std::make_shared<execution::EVM>(state_manager_);
+        tx_processor_ = std::make_shared<execution::TransactionProcessor>(state_manager_, evm_);
+        if (config_.execution_threads > 1) {
+            parallel_executor_ = std::make_shared<execution::ParallelExecutor>(
+                state_manager_, config_.execution_threads);
+        }
+        
         // Initialize consensus layer
         std::cout << "[NONAGON]   Initializing consensus..." << std::endl;
         consensus_ = std::make_shared<consensus::ConsensusEngine>(config_.consensus);
@@ -374,13 +393,13 @@ Block Node::latest_block() const {
     return block.value_or(Block{});
 }
 
-Hash256 Node::submit_transaction(const Transaction& tx) {
-    auto tx_hash = tx.hash();
+Hash256 Node::submit_transaction(TransactionPtr tx) {
+    auto tx_hash = tx->hash();
     
     // Get sender balance for validation
-    uint64_t balance = state_manager_->get_balance(tx.from);
+    uint64_t balance = state_manager_->get_balance(tx->from);
     
-    auto result = mempool_->add_transaction(tx, balance);
+    auto result = mempool_->add_transaction(std::move(tx), balance);
     if (result == consensus::Mempool::AddResult::Added || 
         result == consensus::Mempool::AddResult::Replaced) {
         Metrics::instance().increment(Metrics::TXS_PROCESSED);
@@ -418,66 +437,78 @@ void Node::produce_block() {
         last_empty_block = now;
     }
     
-    // Execute transactions and build receipts
+    // Execute transactions and build receipts. Both roots are accumulated
+    // as transactions execute, so they are ready after the last one.
+    Block block;
     std::vector<TransactionReceipt> receipts;
-    std::vector<Transaction> executed_txs;
+    crypto::MerkleAccumulator receipts_acc;
+    std::vector<Hash256> confirmed;
     uint64_t total_gas_used = 0;
     
-    for (const auto& tx : txs) {
-        // Check sender has enough balance
-        uint64_t sender_balance = state_manager_->get_balance(tx.from);
+    // One context for the whole block, whichever path executes it
+    execution::ExecutionContext ctx;
+    ctx.block_number = new_block_number;
+    ctx.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    ctx.gas_limit = gas_limit;
+    ctx.base_fee = base_fee;
+    ctx.chain_id = 88; // Nonagon Testnet
+    ctx.coinbase = config_.sequencer_address;
+    ctx.block_hash = parent_hash;
+    
+    // Sender must be at the transaction's nonce and cover value plus the
+    // worst-case fee
+    auto admissible = [](const storage::StateView& state, const Transaction& tx) {
+        auto sender = state.get_account(tx.from);
         uint64_t tx_cost = tx.value + (tx.gas_limit * tx.max_fee_per_gas);
+        return sender.nonce == tx.nonce && sender.balance >= tx_cost;
+    };
+    
+    // The parallel executor runs every candidate up front, applying the
+    // admission check to the state each one sees in block order
+    std::vector<std::optional<execution::TransactionProcessor::ProcessResult>> executed;
+    if (parallel_executor_) {
+        executed = parallel_executor_->execute(txs, ctx, admissible);
+    }
+    
+    for (size_t i = 0; i < txs.size(); ++i) {
+        const auto& tx_ptr = txs[i];
+        const Transaction& tx = *tx_ptr;
         
-        if (sender_balance < tx_cost) {
-            std::cout << "[BLOCK] Skipping tx - insufficient balance" << std::endl;
+        bool admitted = parallel_executor_ ? executed[i].has_value()
+                                           : admissible(*state_manager_, tx);
+        if (!admitted) {
+            std::cout << "[BLOCK] Skipping tx - bad nonce or insufficient balance" << std::endl;
             continue;
         }
         
-        // Create execution context
-        execution::ExecutionContext ctx;
-        ctx.block_number = new_block_number;
-        ctx.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-        ctx.gas_limit = gas_limit;
-        ctx.base_fee = base_fee;
-        ctx.chain_id = 88; // Nonagon Testnet
-        ctx.coinbase = config_.sequencer_address;
-        ctx.caller = tx.from;
-        ctx.origin = tx.from;
-        ctx.gas_price = tx.max_fee_per_gas;
-        ctx.block_hash = parent_hash;
-
-        TransactionReceipt receipt;
-        uint64_t gas_used = 0;
-
-        if (tx_processor_) {
-            auto result = tx_processor_->process(tx, ctx);
-            receipt = result.receipt;
-            gas_used = result.gas_used;
-            
-            // TransactionProcessor handles state updates
+        execution::TransactionProcessor::ProcessResult result;
+        if (parallel_executor_) {
+            result = std::move(*executed[i]);
         } else {
-            // Fallback for robust start handling
-            state_manager_->sub_balance(tx.from, tx.value);
-            state_manager_->add_balance(tx.to, tx.value);
-            state_manager_->increment_nonce(tx.from);
-            gas_used = 21000;
-            
-            receipt.transaction_hash = tx.hash();
-            receipt.success = true;
-            receipt.status = 1;
-            receipt.gas_used = gas_used;
-            receipt.from = tx.from;
-            receipt.to = tx.to;
-            receipt.block_number = new_block_number;
-            receipt.transaction_index = receipts.size();
+            execution::ExecutionContext tx_ctx = ctx;
+            tx_ctx.caller = tx.from;
+            tx_ctx.origin = tx.from;
+            tx_ctx.gas_price = tx.effective_gas_price(ctx.base_fee);
+            result = tx_processor_->process(tx, tx_ctx);
         }
-
+        
+        auto tx_hash = tx.hash();
+        uint64_t gas_used = result.gas_used;
+        TransactionReceipt receipt = std::move(result.receipt);
+        receipt.transaction_hash = tx_hash;
+        receipt.status = receipt.success ? 1 : 0;
+        receipt.block_number = new_block_number;
+        receipt.transaction_index = receipts.size();
+        receipt.from = tx.from;
+        receipt.to = tx.to;
         receipt.cumulative_gas_used = total_gas_used + gas_used;
         total_gas_used += gas_used;
         
+        receipts_acc.append(receipt.hash());
         receipts.push_back(receipt);
-        executed_txs.push_back(tx);
+        block.add_transaction(tx_ptr);
+        confirmed.push_back(tx_hash);
         
         std::cout << "[BLOCK] Executed tx: " << tx.value << " wei from ";
         printf("%02x...%02x", tx.from.payment_credential[0], tx.from.payment_credential[27]);
@@ -490,27 +521,18 @@ void Node::produce_block() {
     auto new_state_root = state_manager_->commit();
     
     // Build block
-    Block block;
     block.header.number = new_block_number;
     block.header.parent_hash = parent_hash;
     block.header.state_root = new_state_root;
-    block.header.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    block.header.timestamp = ctx.timestamp;
     block.header.gas_limit = gas_limit;
     block.header.gas_used = total_gas_used;
     block.header.base_fee = base_fee;
     block.header.batch_id = settlement_manager_ ? settlement_manager_->get_current_batch_id() : 0;
-    block.transactions = executed_txs;
     
-    // Compute merkle roots
+    // Merkle roots (already accumulated)
     block.header.transactions_root = block.compute_transactions_root();
-    
-    // Compute receipts root
-    std::vector<Hash256> receipt_hashes;
-    for (const auto& r : receipts) {
-        receipt_hashes.push_back(r.hash());
-    }
-    block.header.receipts_root = crypto::Blake2b256::merkle_root(receipt_hashes);
+    block.header.receipts_root = receipts_acc.root();
     
     // Store block
     block_store_->store_block(block);
@@ -522,10 +544,6 @@ void Node::produce_block() {
     }
     
     // Remove confirmed transactions from mempool
-    std::vector<Hash256> confirmed;
-    for (const auto& tx : executed_txs) {
-        confirmed.push_back(tx.hash());
-    }
     mempool_->remove_confirmed(confirmed);
     
     // Notify settlement layer
@@ -538,7 +556,7 @@ void Node::produce_block() {
     // Print block info
     auto block_hash = block.header.hash();
     std::cout << "[BLOCK] #" << block.header.number << " produced | ";
-    std::cout << executed_txs.size() << " txs | ";
+    std::cout << block.transactions().size() << " txs | ";
     std::cout << "gas: " << total_gas_used << " | hash: ";
     printf("%02x%02x...%02x%02x", block_hash[0], block_hash[1], block_hash[30], block_hash[31]);
     std::cout << std::endl;
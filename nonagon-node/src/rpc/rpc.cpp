@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <regex>
 #include <algorithm>
+#include <cctype>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -510,6 +511,141 @@ Response EthNamespace::get_storage_at(const Request& req) {
         "\"0x0000000000000000000000000000000000000000000000000000000000000000\"");
 }
 
+/**
+ * Positional eth_getProof params: [address | [address, ...], storageKeys,
+ * blockTag]. Only the first position names accounts; a 32-byte storage
+ * key is as long as an address, so the others must not be scanned for
+ * them. Returns nullopt if the params are not shaped like that.
+ */
+namespace {
+struct ProofParams {
+    std::vector<std::string> addresses;
+    std::vector<std::string> storage_keys;
+};
+} // namespace
+
+static std::optional<ProofParams> parse_proof_params(const std::string& json) {
+    size_t pos = 0;
+    auto skip_ws = [&]() {
+        while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) ++pos;
+    };
+    auto consume = [&](char c) {
+        skip_ws();
+        if (pos < json.size() && json[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    };
+    // "0x" followed by hex digits
+    auto hex_string = [&]() -> std::optional<std::string> {
+        if (!consume('"')) return std::nullopt;
+        size_t end = json.find('"', pos);
+        if (end == std::string::npos) return std::nullopt;
+        std::string value = json.substr(pos, end - pos);
+        pos = end + 1;
+        if (value.size() < 3 || !value.starts_with("0x") ||
+            !std::all_of(value.begin() + 2, value.end(),
+                         [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); })) {
+            return std::nullopt;
+        }
+        return value;
+    };
+    auto hex_array = [&](std::vector<std::string>& out) {
+        if (consume(']')) return true;
+        do {
+            auto value = hex_string();
+            if (!value) return false;
+            out.push_back(std::move(*value));
+        } while (consume(','));
+        return consume(']');
+    };
+    
+    ProofParams params;
+    if (!consume('[')) return std::nullopt;
+    if (consume('[')) {
+        if (!hex_array(params.addresses)) return std::nullopt;
+    } else if (auto addr = hex_string()) {
+        params.addresses.push_back(std::move(*addr));
+    } else {
+        return std::nullopt;
+    }
+    
+    // The block tag after the keys is not read: proofs are always against
+    // the latest state commitment
+    if (consume(',') && consume('[')) {
+        if (!hex_array(params.storage_keys)) return std::nullopt;
+    }
+    return params;
+}
+
+Response EthNamespace::get_proof(const Request& req) {
+    if (!state_ || !req.params) {
+        return Response::make_error(req.id.value_or(0), ErrorCode::InvalidParams, "Missing address");
+    }
+    
+    // Every address in the first position is proven together
+    auto params = parse_proof_params(*req.params);
+    if (!params) {
+        return Response::make_error(req.id.value_or(0), ErrorCode::InvalidParams,
+                                    "Expected [address | [addresses], storageKeys, blockTag]");
+    }
+    if (!params->storage_keys.empty()) {
+        return Response::make_error(req.id.value_or(0), ErrorCode::InvalidParams,
+                                    "Storage proofs are not supported");
+    }
+    
+    std::vector<Address> addrs;
+    for (const auto& hex : params->addresses) {
+        auto addr_opt = Address::from_hex(hex);
+        if (!addr_opt) {
+            return Response::make_error(req.id.value_or(0), ErrorCode::InvalidParams,
+                                        "Invalid address " + hex);
+        }
+        addrs.push_back(*addr_opt);
+    }
+    if (addrs.empty()) {
+        return Response::make_error(req.id.value_or(0), ErrorCode::InvalidParams, "Missing address");
+    }
+    
+    auto proof = state_->get_account_proof(addrs);
+    if (!proof) {
+        return Response::make_error(req.id.value_or(0), ErrorCode::ResourceNotFound,
+                                    "Account not in latest state commitment");
+    }
+    
+    auto write_hex = [](std::ostringstream& ss, const uint8_t* data, size_t len) {
+        ss << "\"0x";
+        for (size_t i = 0; i < len; ++i) {
+            ss << std::hex << std::setw(2) << std::setfill('0') << (int)data[i];
+        }
+        ss << "\"";
+    };
+    
+    std::ostringstream ss;
+    ss << "{\"stateRoot\":";
+    write_hex(ss, proof->root.data(), proof->root.size());
+    ss << ",\"leafCount\":\"0x" << std::hex << proof->leaf_count << "\"";
+    ss << ",\"leaves\":[";
+    for (size_t i = 0; i < proof->leaves.size(); ++i) {
+        const auto& leaf = proof->leaves[i];
+        if (i > 0) ss << ",";
+        ss << "{\"index\":\"0x" << std::hex << leaf.index << "\",\"path\":";
+        write_hex(ss, leaf.path.data(), leaf.path.size());
+        ss << ",\"value\":";
+        write_hex(ss, leaf.value.data(), leaf.value.size());
+        ss << "}";
+    }
+    ss << "],\"accountProof\":[";
+    for (size_t i = 0; i < proof->nodes.size(); ++i) {
+        if (i > 0) ss << ",";
+        write_hex(ss, proof->nodes[i].data(), proof->nodes[i].size());
+    }
+    ss << "],\"storageProof\":[]}";
+    
+    return Response::success(req.id.value_or(0), ss.str());
+}
+
 Response EthNamespace::get_block_by_number(const Request& req) {
     uint64_t num = blocks_->get_head();
     if (req.params) {
@@ -528,26 +664,28 @@ Response EthNamespace::get_block_by_number(const Request& req) {
         }
     }
 
-    auto block_opt = blocks_->get_block(num);
+    // Read through a view: only the fields printed below are decoded
+    auto raw = blocks_->get_block_bytes(num);
+    auto block_opt = raw ? BlockView::parse(*raw) : std::nullopt;
     if (!block_opt) {
         return Response::success(req.id.value_or(0), "null");
     }
     
-    auto& block = *block_opt;
+    const auto& block = *block_opt;
     std::ostringstream ss;
     ss << "{";
-    ss << "\"number\":\"0x" << std::hex << block.header.number << "\"";
+    ss << "\"number\":\"0x" << std::hex << block.number() << "\"";
     ss << ",\"hash\":\"0x";
-    auto hash = block.header.hash();
+    auto hash = block.header_hash();
     for (auto b : hash) ss << std::setw(2) << std::setfill('0') << (int)b;
     ss << "\"";
     ss << ",\"parentHash\":\"0x";
-    for (auto b : block.header.parent_hash) ss << std::setw(2) << std::setfill('0') << (int)b;
+    for (auto b : block.parent_hash()) ss << std::setw(2) << std::setfill('0') << (int)b;
     ss << "\"";
-    ss << ",\"timestamp\":\"0x" << std::hex << block.header.timestamp << "\"";
-    ss << ",\"gasLimit\":\"0x" << std::hex << block.header.gas_limit << "\"";
-    ss << ",\"gasUsed\":\"0x" << std::hex << block.header.gas_used << "\"";
-    ss << ",\"baseFeePerGas\":\"0x" << std::hex << block.header.base_fee << "\"";
+    ss << ",\"timestamp\":\"0x" << std::hex << block.timestamp() << "\"";
+    ss << ",\"gasLimit\":\"0x" << std::hex << block.gas_limit() << "\"";
+    ss << ",\"gasUsed\":\"0x" << std::hex << block.gas_used() << "\"";
+    ss << ",\"baseFeePerGas\":\"0x" << std::hex << block.base_fee() << "\"";
     // Check for full transaction objects request
     bool full_txs = false;
     if (req.params && req.params->find("true") != std::string::npos) {
@@ -555,9 +693,9 @@ Response EthNamespace::get_block_by_number(const Request& req) {
     }
 
     ss << ",\"transactions\":[";
-    for (size_t i = 0; i < block.transactions.size(); ++i) {
+    for (size_t i = 0; i < block.transaction_count(); ++i) {
         if (i > 0) ss << ",";
-        const auto& tx = block.transactions[i];
+        const auto& tx = block.transaction(i);
         
         if (full_txs) {
             ss << "{";
@@ -567,30 +705,29 @@ Response EthNamespace::get_block_by_number(const Request& req) {
             for (auto b : h) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
-            ss << "\"nonce\":\"0x" << std::hex << tx.nonce << "\",";
+            ss << "\"nonce\":\"0x" << std::hex << tx.nonce() << "\",";
             
             ss << "\"blockHash\":\"0x";
-            auto bh = block.header.hash();
-            for (auto b : bh) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : hash) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
-            ss << "\"blockNumber\":\"0x" << std::hex << block.header.number << "\",";
+            ss << "\"blockNumber\":\"0x" << std::hex << block.number() << "\",";
             ss << "\"transactionIndex\":\"0x" << std::hex << i << "\",";
             
             ss << "\"from\":\"0x";
-            for (auto b : tx.from.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : tx.from().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
             ss << "\"to\":\"0x";
-            for (auto b : tx.to.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : tx.to().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
-            ss << "\"value\":\"0x" << std::hex << tx.value << "\",";
-            ss << "\"gas\":\"0x" << std::hex << tx.gas_limit << "\",";
-            ss << "\"gasPrice\":\"0x" << std::hex << tx.max_fee_per_gas << "\",";
+            ss << "\"value\":\"0x" << std::hex << tx.value() << "\",";
+            ss << "\"gas\":\"0x" << std::hex << tx.gas_limit() << "\",";
+            ss << "\"gasPrice\":\"0x" << std::hex << tx.max_fee_per_gas() << "\",";
             
             ss << "\"input\":\"0x";
-            for (auto b : tx.data) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : tx.data()) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\"";
             
             ss << "}";
@@ -612,13 +749,14 @@ Response EthNamespace::get_block_by_hash(const Request& req) {
 }
 
 Response EthNamespace::get_block_transaction_count_by_number(const Request& req) {
-    auto block_opt = blocks_->get_block(blocks_->get_head());
+    auto raw = blocks_->get_block_bytes(blocks_->get_head());
+    auto block_opt = raw ? BlockView::parse(*raw) : std::nullopt;
     if (!block_opt) {
         return Response::success(req.id.value_or(0), "\"0x0\"");
     }
     
     std::ostringstream ss;
-    ss << "\"0x" << std::hex << block_opt->transactions.size() << "\"";
+    ss << "\"0x" << std::hex << block_opt->transaction_count() << "\"";
     return Response::success(req.id.value_or(0), ss.str());
 }
 
@@ -649,39 +787,40 @@ Response EthNamespace::get_transaction_by_hash(const Request& req) {
     auto receipt_opt = blocks_->get_receipt(tx_hash);
     if (!receipt_opt) return Response::success(req.id.value_or(0), "null");
     
-    auto block = blocks_->get_block(receipt_opt->block_number);
-    if (!block || receipt_opt->transaction_index >= block->transactions.size()) 
+    auto raw = blocks_->get_block_bytes(receipt_opt->block_number);
+    auto block = raw ? BlockView::parse(*raw) : std::nullopt;
+    if (!block || receipt_opt->transaction_index >= block->transaction_count()) 
         return Response::success(req.id.value_or(0), "null");
         
-    const auto& tx = block->transactions[receipt_opt->transaction_index];
+    const auto& tx = block->transaction(receipt_opt->transaction_index);
     
     std::ostringstream ss;
     ss << "{";
     ss << "\"hash\":\"0x" << tx_hash_str << "\",";
-    ss << "\"nonce\":\"0x" << std::hex << tx.nonce << "\",";
+    ss << "\"nonce\":\"0x" << std::hex << tx.nonce() << "\",";
     
     ss << "\"blockHash\":\"0x";
-    auto bh = block->header.hash();
+    auto bh = block->header_hash();
     for (auto b : bh) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
     ss << "\",";
     
-    ss << "\"blockNumber\":\"0x" << std::hex << block->header.number << "\",";
+    ss << "\"blockNumber\":\"0x" << std::hex << block->number() << "\",";
     ss << "\"transactionIndex\":\"0x" << std::hex << receipt_opt->transaction_index << "\",";
     
     ss << "\"from\":\"0x";
-    for (auto b : tx.from.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+    for (auto b : tx.from().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
     ss << "\",";
     
     ss << "\"to\":\"0x";
-    for (auto b : tx.to.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+    for (auto b : tx.to().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
     ss << "\",";
     
-    ss << "\"value\":\"0x" << std::hex << tx.value << "\",";
-    ss << "\"gas\":\"0x" << std::hex << tx.gas_limit << "\",";
-    ss << "\"gasPrice\":\"0x" << std::hex << tx.max_fee_per_gas << "\",";
+    ss << "\"value\":\"0x" << std::hex << tx.value() << "\",";
+    ss << "\"gas\":\"0x" << std::hex << tx.gas_limit() << "\",";
+    ss << "\"gasPrice\":\"0x" << std::hex << tx.max_fee_per_gas() << "\",";
     
     ss << "\"input\":\"0x";
-    for (auto b : tx.data) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+    for (auto b : tx.data()) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
     ss << "\"";
     
     ss << "}";
@@ -738,10 +877,11 @@ Response EthNamespace::get_transaction_receipt(const Request& req) {
     ss << "\"transactionIndex\":\"0x" << std::hex << receipt.transaction_index << "\",";
     ss << "\"blockNumber\":\"0x" << std::hex << receipt.block_number << "\",";
     
-    // Fetch block to get hash
-    auto block = blocks_->get_block(receipt.block_number);
+    // Fetch block to get hash; the header alone is enough
+    auto raw = blocks_->get_block_bytes(receipt.block_number);
+    auto block = raw ? BlockView::parse(*raw) : std::nullopt;
     if (block) {
-        auto h = block->header.hash();
+        auto h = block->header_hash();
         ss << "\"blockHash\":\"0x";
         for (auto b : h) ss << std::setfill('0') << std::setw(2) << static_cast<int>(b);
         ss << "\",";
@@ -842,7 +982,10 @@ Response EthNamespace::send_raw_transaction(const Request& req) {
             ErrorCode::InvalidParams, "Failed to decode transaction");
     }
     
-    Transaction tx = *tx_opt;
+    // Shared from here on so the hash below is computed once for RPC,
+    // signature check and mempool
+    auto tx_ptr = Transaction::share(std::move(*tx_opt));
+    const Transaction& tx = *tx_ptr;
     
     // Verify signature
     if (!tx.verify_signature()) {
@@ -861,7 +1004,7 @@ Response EthNamespace::send_raw_transaction(const Request& req) {
     
     // Add to mempool
     if (mempool_) {
-        auto result = mempool_->add_transaction(tx, sender_balance);
+        auto result = mempool_->add_transaction(tx_ptr, sender_balance);
         if (result == consensus::Mempool::AddResult::Added ||
             result == consensus::Mempool::AddResult::Replaced) {
             std::cout << "[RPC] Transaction added to mempool: 0x";
@@ -919,10 +1062,13 @@ Response EthNamespace::get_recent_transactions(const Request& req) {
     bool first = true;
 
     for (uint64_t i = head; i != (uint64_t)-1 && gathered < count; --i) {
-        auto block_opt = blocks_->get_block(i);
+        // Views: no per-tx data vectors for a listing of five fields
+        auto raw = blocks_->get_block_bytes(i);
+        auto block_opt = raw ? BlockView::parse(*raw) : std::nullopt;
         if (!block_opt) continue;
 
-        for (auto it = block_opt->transactions.rbegin(); it != block_opt->transactions.rend() && gathered < count; ++it) {
+        const auto& txs = block_opt->transactions();
+        for (auto it = txs.rbegin(); it != txs.rend() && gathered < count; ++it) {
             if (!first) ss << ",";
             first = false;
 
@@ -935,18 +1081,18 @@ Response EthNamespace::get_recent_transactions(const Request& req) {
             ss << "\",";
             
             ss << "\"blockNumber\":\"0x" << std::hex << i << "\",";
-            ss << "\"timestamp\":\"0x" << std::hex << block_opt->header.timestamp << "\",";
+            ss << "\"timestamp\":\"0x" << std::hex << block_opt->timestamp() << "\",";
             
             ss << "\"from\":\"0x";
-            for (auto b : tx.from.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : tx.from().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
             ss << "\"to\":\"0x";
-            for (auto b : tx.to.payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
+            for (auto b : tx.to().payment_credential) ss << std::setw(2) << std::setfill('0') << std::hex << (int)b;
             ss << "\",";
             
-            ss << "\"value\":\"0x" << std::hex << tx.value << "\",";
-            ss << "\"nonce\":\"0x" << std::hex << tx.nonce << "\"";
+            ss << "\"value\":\"0x" << std::hex << tx.value() << "\",";
+            ss << "\"nonce\":\"0x" << std::hex << tx.nonce() << "\"";
             
             ss << "}";
             gathered++;
@@ -967,6 +1113,7 @@ void EthNamespace::register_methods(Server& server) {
     server.register_method("eth_getTransactionCount", [this](const Request& req) { return get_transaction_count(req); });
     server.register_method("eth_getCode", [this](const Request& req) { return get_code(req); });
     server.register_method("eth_getStorageAt", [this](const Request& req) { return get_storage_at(req); });
+    server.register_method("eth_getProof", [this](const Request& req) { return get_proof(req); });
     server.register_method("eth_getBlockByNumber", [this](const Request& req) { return get_block_by_number(req); });
     server.register_method("eth_getBlockByHash", [this](const Request& req) { return get_block_by_hash(req); });
     server.register_method("eth_getBlockTransactionCountByNumber", [this](const Request& req) { return get_block_transaction_count_by_number(req); });
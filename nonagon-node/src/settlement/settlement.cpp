@@ -362,7 +362,7 @@ bool BatchBuilder::is_ready() const {
     // Check transaction count
     size_t total_txs = 0;
     for (const auto& block : pending_blocks_) {
-        total_txs += block.transactions.size();
+        total_txs += block.transactions().size();
     }
     
     if (total_txs >= config_.max_batch_size) return true;
@@ -391,12 +391,19 @@ std::optional<SettlementBatch> BatchBuilder::build_batch(const Hash256& pre_stat
     batch.pre_state_root = pre_state_root;
     batch.post_state_root = pending_blocks_.back().header.state_root;
     
-    // Compute transactions root
+    // Compute transactions root; the tree is kept to serve withdrawal proofs
     std::vector<Hash256> block_hashes;
+    block_hashes.reserve(pending_blocks_.size());
     for (const auto& block : pending_blocks_) {
         block_hashes.push_back(block.header.hash());
     }
-    batch.transactions_root = crypto::Blake2b256::merkle_root(block_hashes);
+    crypto::MerkleTree tree(std::move(block_hashes));
+    batch.transactions_root = tree.root();
+    
+    batch_trees_[batch.batch_id] = BatchTree{batch.start_block, std::move(tree)};
+    if (batch_trees_.size() > MAX_BATCH_TREES) {
+        batch_trees_.erase(batch_trees_.begin());
+    }
     
     // Compress block data
     Bytes compressed;
@@ -420,6 +427,15 @@ std::optional<SettlementBatch> BatchBuilder::build_batch(const Hash256& pre_stat
     return batch;
 }
 
+std::vector<Hash256> BatchBuilder::block_proof(uint64_t batch_id, uint64_t block_number) const {
+    std::unique_lock lock(mutex_);
+    
+    auto it = batch_trees_.find(batch_id);
+    if (it == batch_trees_.end() || block_number < it->second.start_block) return {};
+    
+    return it->second.tree.proof(block_number - it->second.start_block);
+}
+
 void BatchBuilder::clear() {
     std::unique_lock lock(mutex_);
     pending_blocks_.clear();
@@ -436,7 +452,7 @@ size_t BatchBuilder::pending_transactions() const {
     std::unique_lock lock(mutex_);
     size_t count = 0;
     for (const auto& block : pending_blocks_) {
-        count += block.transactions.size();
+        count += block.transactions().size();
     }
     return count;
 }
@@ -690,6 +706,9 @@ void SettlementManager::process_pending_withdrawals() {
         if (w.status == BridgeWithdrawal::Status::Pending) {
             // Check if batch is finalized
             if (is_batch_finalized(w.batch_id)) {
+                if (builder_) {
+                    w.merkle_proof = builder_->block_proof(w.batch_id, w.l2_block_number);
+                }
                 w.status = BridgeWithdrawal::Status::Claimable;
                 std::cout << "[BRIDGE] Withdrawal ready to claim: " 
                           << w.amount << std::endl;
@@ -1,6 +1,8 @@
 #include "nonagon/storage.hpp"
 #include "nonagon/crypto.hpp"
+#include "nonagon/byte_io.hpp"
 #include <algorithm>
+#include <cstring>
 #ifdef _WIN32
 #include <direct.h>
 #define MKDIR(dir) _mkdir(dir)
@@ -206,6 +208,89 @@ std::unique_ptr<Database::Iterator> PersistentDatabase::new_iterator(const Bytes
     return std::make_unique<MemoryIterator>(data_.cbegin(), data_.cend(), prefix);
 }
 
+// ============================================================================
+// StateKey / DirtyNodeTable Implementation
+// ============================================================================
+
+StateKey StateKey::from_key(const uint8_t* key, size_t len) {
+    StateKey sk;
+    sk.bytes[0] = PREFIX;
+    auto key_hash = crypto::Blake2b256::hash(key, len);
+    std::memcpy(sk.bytes.data() + 1, key_hash.data(), key_hash.size());
+    return sk;
+}
+
+uint64_t StateKey::slot_hash() const {
+    uint64_t h;
+    std::memcpy(&h, path(), sizeof(h));
+    return h;
+}
+
+Bytes& DirtyNodeTable::operator[](const StateKey& key) {
+    // Keep load factor below 3/4
+    if ((size_ + 1) * 4 > slots_.size() * 3) {
+        grow();
+    }
+    
+    size_t mask = slots_.size() - 1;
+    size_t i = key.slot_hash() & mask;
+    while (slots_[i].used) {
+        if (slots_[i].key == key) {
+            return slots_[i].value;
+        }
+        i = (i + 1) & mask;
+    }
+    
+    slots_[i].used = true;
+    slots_[i].key = key;
+    slots_[i].value.clear();
+    size_++;
+    return slots_[i].value;
+}
+
+const Bytes* DirtyNodeTable::find(const StateKey& key) const {
+    if (size_ == 0) return nullptr;
+    
+    size_t mask = slots_.size() - 1;
+    size_t i = key.slot_hash() & mask;
+    while (slots_[i].used) {
+        if (slots_[i].key == key) {
+            return &slots_[i].value;
+        }
+        i = (i + 1) & mask;
+    }
+    return nullptr;
+}
+
+void DirtyNodeTable::clear() {
+    for (auto& slot : slots_) {
+        slot.used = false;
+        slot.value.clear();  // Keeps capacity for the next block
+    }
+    size_ = 0;
+}
+
+void DirtyNodeTable::grow() {
+    size_t new_capacity = slots_.empty() ? INITIAL_CAPACITY : slots_.size() * 2;
+    std::vector<Slot> old = std::move(slots_);
+    slots_.clear();
+    slots_.resize(new_capacity);
+    size_ = 0;
+    
+    size_t mask = new_capacity - 1;
+    for (auto& slot : old) {
+        if (!slot.used) continue;
+        size_t i = slot.key.slot_hash() & mask;
+        while (slots_[i].used) {
+            i = (i + 1) & mask;
+        }
+        slots_[i].used = true;
+        slots_[i].key = slot.key;
+        slots_[i].value = std::move(slot.value);
+        size_++;
+    }
+}
+
 // ============================================================================
 // StateTrie Implementation (Simplified Merkle Patricia Trie)
 // ============================================================================
@@ -217,69 +302,94 @@ StateTrie::StateTrie(std::shared_ptr<Database> db, const Hash256& root)
     : db_(db), root_(root) {}
 
 void StateTrie::put(const Bytes& key, const Bytes& value) {
-    // Hash the key for path
-    auto key_hash = crypto::Blake2b256::hash(key);
-    std::string key_str(key_hash.begin(), key_hash.end());
-    
-    // Store in dirty nodes (will be committed later)
-    dirty_nodes_[key_str] = value;
+    put(StateKey::from_key(key), value);
 }
 
 std::optional<Bytes> StateTrie::get(const Bytes& key) const {
-    auto key_hash = crypto::Blake2b256::hash(key);
-    std::string key_str(key_hash.begin(), key_hash.end());
-    
+    return get(StateKey::from_key(key));
+}
+
+void StateTrie::del(const Bytes& key) {
+    del(StateKey::from_key(key));
+}
+
+void StateTrie::put(const StateKey& key, const Bytes& value) {
+    // Store in dirty nodes (will be committed later)
+    dirty_nodes_[key] = value;
+}
+
+std::optional<Bytes> StateTrie::get(const StateKey& key) const {
     // Check dirty nodes first
-    auto it = dirty_nodes_.find(key_str);
-    if (it != dirty_nodes_.end()) {
-        return it->second;
+    if (const Bytes* dirty = dirty_nodes_.find(key)) {
+        return *dirty;
     }
     
     // Check database
-    Bytes db_key;
-    db_key.push_back(0x01);  // State prefix
-    db_key.insert(db_key.end(), key_hash.begin(), key_hash.end());
-    
-    return db_->get(db_key);
+    return db_->get(key.to_db_key());
 }
 
-void StateTrie::del(const Bytes& key) {
-    auto key_hash = crypto::Blake2b256::hash(key);
-    std::string key_str(key_hash.begin(), key_hash.end());
-    
+void StateTrie::del(const StateKey& key) {
     // Mark as deleted (empty value)
-    dirty_nodes_[key_str] = {};
+    dirty_nodes_[key].clear();
 }
 
+namespace {
+
+constexpr size_t PATH_SIZE = crypto::Blake2b256::HASH_SIZE;
+
+Hash256 state_leaf_hash(const uint8_t* path, const Bytes& value) {
+    return crypto::Blake2bHasher().update(path, PATH_SIZE).update(value).final();
+}
+
+Hash256 hash_pair(const Hash256& left, const Hash256& right) {
+    uint8_t buf[2 * PATH_SIZE];
+    std::memcpy(buf, left.data(), PATH_SIZE);
+    std::memcpy(buf + PATH_SIZE, right.data(), PATH_SIZE);
+    return crypto::Blake2b256::hash(buf, sizeof(buf));
+}
+
+} // namespace
+
 Hash256 StateTrie::commit() {
     Database::WriteBatch batch;
-    std::vector<Hash256> leaf_hashes;
+    std::vector<std::pair<Hash256, Hash256>> leaves;  // (path, leaf hash)
+    batch.puts.reserve(dirty_nodes_.size());
+    leaves.reserve(dirty_nodes_.size());
     
     // Write all dirty nodes to database
-    for (const auto& [key_str, value] : dirty_nodes_) {
-        Bytes db_key;
-        db_key.push_back(0x01);  // State prefix
-        db_key.insert(db_key.end(), key_str.begin(), key_str.end());
-        
+    dirty_nodes_.for_each([&](const StateKey& key, const Bytes& value) {
         if (value.empty()) {
-            batch.deletes.push_back(db_key);
+            batch.deletes.push_back(key.to_db_key());
         } else {
-            batch.puts.emplace_back(db_key, value);
+            batch.puts.emplace_back(key.to_db_key(), value);
             
-            // Compute leaf hash
-            Bytes leaf_data;
-            leaf_data.insert(leaf_data.end(), key_str.begin(), key_str.end());
-            leaf_data.insert(leaf_data.end(), value.begin(), value.end());
-            leaf_hashes.push_back(crypto::Blake2b256::hash(leaf_data));
+            Hash256 path;
+            std::memcpy(path.data(), key.path(), PATH_SIZE);
+            leaves.emplace_back(path, state_leaf_hash(key.path(), value));
         }
-    }
+    });
+    
+    // Order leaves by path so the root does not depend on table layout
+    std::sort(leaves.begin(), leaves.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    
+    std::unique_lock lock(committed_mutex_);
     
     db_->write_batch(batch);
     dirty_nodes_.clear();
     
     // Compute new root
-    if (!leaf_hashes.empty()) {
-        root_ = crypto::Blake2b256::merkle_root(leaf_hashes);
+    if (!leaves.empty()) {
+        std::vector<Hash256> leaf_hashes;
+        leaf_hashes.reserve(leaves.size());
+        committed_paths_.clear();
+        committed_paths_.reserve(leaves.size());
+        for (const auto& [path, leaf] : leaves) {
+            committed_paths_.push_back(path);
+            leaf_hashes.push_back(leaf);
+        }
+        committed_tree_ = crypto::MerkleTree(std::move(leaf_hashes));
+        root_ = committed_tree_.root();
     }
     
     // Store root reference
@@ -291,34 +401,213 @@ Hash256 StateTrie::commit() {
 }
 
 std::vector<Bytes> StateTrie::get_proof(const Bytes& key) const {
-    // Simplified: return path hashes
+    // Single-key case of the multiproof, serialized as one element
     std::vector<Bytes> proof;
     
-    auto key_hash = crypto::Blake2b256::hash(key);
-    proof.emplace_back(key_hash.begin(), key_hash.end());
-    
-    auto value = get(key);
-    if (value) {
-        proof.push_back(*value);
+    auto multi = get_multiproof(std::vector<StateKey>{StateKey::from_key(key)});
+    if (multi) {
+        proof.push_back(multi->encode());
     }
     
-    proof.emplace_back(root_.begin(), root_.end());
-    
     return proof;
 }
 
 bool StateTrie::verify_proof(const Hash256& root, const Bytes& key,
                               const Bytes& value, const std::vector<Bytes>& proof) {
-    // In a real implementation, verify each step of the MPT path
-    if (proof.size() < 3) return false;
+    if (proof.size() != 1) return false;
     
-    // Check root matches
-    Hash256 proof_root;
-    if (proof.back().size() == 32) {
-        std::copy(proof.back().begin(), proof.back().end(), proof_root.begin());
+    auto multi = StateMultiProof::decode(proof[0]);
+    if (!multi || multi->leaves.size() != 1) return false;
+    
+    auto state_key = StateKey::from_key(key);
+    const auto& leaf = multi->leaves[0];
+    if (std::memcmp(leaf.path.data(), state_key.path(), PATH_SIZE) != 0) return false;
+    if (leaf.value != value) return false;
+    
+    return verify_multiproof(root, *multi);
+}
+
+std::optional<StateMultiProof> StateTrie::get_multiproof(const std::vector<Bytes>& keys) const {
+    std::vector<StateKey> state_keys;
+    state_keys.reserve(keys.size());
+    for (const auto& key : keys) {
+        state_keys.push_back(StateKey::from_key(key));
+    }
+    return get_multiproof(state_keys);
+}
+
+std::optional<StateMultiProof> StateTrie::get_multiproof(const std::vector<StateKey>& keys) const {
+    std::shared_lock lock(committed_mutex_);
+    if (committed_tree_.empty() || keys.empty()) return std::nullopt;
+    
+    StateMultiProof proof;
+    proof.root = root_;
+    proof.leaf_count = committed_tree_.leaf_count();
+    proof.leaves.reserve(keys.size());
+    
+    // Locate each key among the committed leaves
+    for (const auto& key : keys) {
+        Hash256 path;
+        std::memcpy(path.data(), key.path(), PATH_SIZE);
+        
+        auto it = std::lower_bound(committed_paths_.begin(), committed_paths_.end(), path);
+        if (it == committed_paths_.end() || *it != path) {
+            return std::nullopt;
+        }
+        
+        auto value = db_->get(key.to_db_key());
+        if (!value) return std::nullopt;
+        
+        StateMultiProof::Leaf leaf;
+        leaf.index = static_cast<uint64_t>(it - committed_paths_.begin());
+        leaf.path = path;
+        leaf.value = std::move(*value);
+        proof.leaves.push_back(std::move(leaf));
+    }
+    
+    std::sort(proof.leaves.begin(), proof.leaves.end(),
+              [](const auto& a, const auto& b) { return a.index < b.index; });
+    proof.leaves.erase(std::unique(proof.leaves.begin(), proof.leaves.end(),
+                                   [](const auto& a, const auto& b) { return a.index == b.index; }),
+                       proof.leaves.end());
+    
+    std::vector<uint64_t> indices;
+    indices.reserve(proof.leaves.size());
+    for (const auto& leaf : proof.leaves) {
+        indices.push_back(leaf.index);
+    }
+    
+    // Walk up level by level. A sibling is emitted only when it is neither
+    // in the known set nor the duplicated last node of an odd level.
+    for (size_t level = 0; level + 1 < committed_tree_.levels(); ++level) {
+        size_t level_size = committed_tree_.level_size(level);
+        std::vector<uint64_t> parents;
+        parents.reserve(indices.size());
+        
+        for (size_t i = 0; i < indices.size(); ++i) {
+            uint64_t idx = indices[i];
+            uint64_t sibling = idx ^ 1;
+            
+            if (sibling >= level_size) {
+                // Odd tail: paired with itself
+            } else if ((idx & 1) == 0 && i + 1 < indices.size() && indices[i + 1] == sibling) {
+                ++i;
+            } else {
+                proof.nodes.push_back(committed_tree_.node(level, sibling));
+            }
+            parents.push_back(idx >> 1);
+        }
+        
+        indices = std::move(parents);
+    }
+    
+    return proof;
+}
+
+bool StateTrie::verify_multiproof(const Hash256& root, const StateMultiProof& proof) {
+    if (proof.root != root || proof.leaf_count == 0 || proof.leaves.empty()) {
+        return false;
+    }
+    
+    // Known (index, hash) pairs at the current level, strictly increasing
+    std::vector<std::pair<uint64_t, Hash256>> known;
+    known.reserve(proof.leaves.size());
+    for (const auto& leaf : proof.leaves) {
+        if (leaf.index >= proof.leaf_count) return false;
+        if (!known.empty() && leaf.index <= known.back().first) return false;
+        known.emplace_back(leaf.index, state_leaf_hash(leaf.path.data(), leaf.value));
+    }
+    
+    size_t next_node = 0;
+    uint64_t level_size = proof.leaf_count;
+    
+    while (level_size > 1) {
+        std::vector<std::pair<uint64_t, Hash256>> parents;
+        parents.reserve(known.size());
+        
+        for (size_t i = 0; i < known.size(); ++i) {
+            const auto& [idx, hash] = known[i];
+            uint64_t sibling = idx ^ 1;
+            Hash256 sibling_hash;
+            
+            if (sibling >= level_size) {
+                sibling_hash = hash;
+            } else if ((idx & 1) == 0 && i + 1 < known.size() && known[i + 1].first == sibling) {
+                sibling_hash = known[++i].second;
+            } else {
+                if (next_node >= proof.nodes.size()) return false;
+                sibling_hash = proof.nodes[next_node++];
+            }
+            
+            Hash256 parent = (idx & 1) == 0 ? hash_pair(hash, sibling_hash)
+                                            : hash_pair(sibling_hash, hash);
+            parents.emplace_back(idx >> 1, parent);
+        }
+        
+        known = std::move(parents);
+        level_size = (level_size + 1) / 2;
     }
     
-    return root == proof_root;
+    return next_node == proof.nodes.size() && known.size() == 1 && known[0].second == root;
+}
+
+// ============================================================================
+// StateMultiProof Implementation
+// ============================================================================
+
+Bytes StateMultiProof::encode() const {
+    size_t size = PATH_SIZE + 8 + 8 + 8 + nodes.size() * PATH_SIZE;
+    for (const auto& leaf : leaves) {
+        size += 8 + PATH_SIZE + 8 + leaf.value.size();
+    }
+    ByteWriter out(size);
+    
+    out.bytes(root);
+    out.u64_be(leaf_count);
+    
+    out.u64_be(leaves.size());
+    for (const auto& leaf : leaves) {
+        out.u64_be(leaf.index);
+        out.bytes(leaf.path);
+        out.prefixed(leaf.value);
+    }
+    
+    out.u64_be(nodes.size());
+    for (const auto& node : nodes) {
+        out.bytes(node);
+    }
+    
+    return out.finish();
+}
+
+std::optional<StateMultiProof> StateMultiProof::decode(const Bytes& data) {
+    StateMultiProof proof;
+    ByteReader in(data);
+    
+    in.bytes(proof.root);
+    proof.leaf_count = in.u64_be();
+    
+    uint64_t count = in.u64_be();
+    if (!in.ok() || count > in.remaining()) return std::nullopt;
+    proof.leaves.resize(count);
+    for (auto& leaf : proof.leaves) {
+        leaf.index = in.u64_be();
+        in.bytes(leaf.path);
+        uint64_t len = in.u64_be();
+        if (!in.ok() || len > in.remaining()) return std::nullopt;
+        const uint8_t* value = in.take(len);
+        leaf.value.assign(value, value + len);
+    }
+    
+    count = in.u64_be();
+    if (!in.ok() || count > in.remaining() / PATH_SIZE) return std::nullopt;
+    proof.nodes.resize(count);
+    for (auto& node : proof.nodes) {
+        in.bytes(node);
+    }
+    
+    if (in.remaining() != 0) return std::nullopt;
+    return proof;
 }
 
 // ============================================================================
@@ -338,15 +627,17 @@ BlockStore::BlockStore(std::shared_ptr<Database> db) : db_(db) {
 }
 
 bool BlockStore::store_block(const Block& block) {
+    return store_encoded_block(block.header.number, block.header.hash(), block.encode());
+}
+
+bool BlockStore::store_encoded_block(uint64_t number, const Hash256& block_hash,
+                                     const Bytes& block_bytes) {
     std::unique_lock lock(mutex_);
     
-    auto block_bytes = block.encode();
-    auto block_hash = block.header.hash();
-    
     // Store by number
     Bytes num_key = {'B', 'N'};
     for (int i = 7; i >= 0; --i) {
-        num_key.push_back(static_cast<uint8_t>((block.header.number >> (i * 8)) & 0xFF));
+        num_key.push_back(static_cast<uint8_t>((number >> (i * 8)) & 0xFF));
     }
     db_->put(num_key, block_bytes);
     
@@ -356,13 +647,13 @@ bool BlockStore::store_block(const Block& block) {
     
     Bytes num_bytes;
     for (int i = 7; i >= 0; --i) {
-        num_bytes.push_back(static_cast<uint8_t>((block.header.number >> (i * 8)) & 0xFF));
+        num_bytes.push_back(static_cast<uint8_t>((number >> (i * 8)) & 0xFF));
     }
     db_->put(hash_key, num_bytes);
     
     // Update head if this is the new highest block
-    if (block.header.number > head_) {
-        head_ = block.header.number;
+    if (number > head_) {
+        head_ = number;
         Bytes head_key = {'H', 'E', 'A', 'D'};
         db_->put(head_key, num_bytes);
     }
@@ -371,6 +662,13 @@ bool BlockStore::store_block(const Block& block) {
 }
 
 std::optional<Block> BlockStore::get_block(uint64_t number) const {
+    auto data = get_block_bytes(number);
+    if (!data) return std::nullopt;
+    
+    return Block::decode(*data);
+}
+
+std::optional<Bytes> BlockStore::get_block_bytes(uint64_t number) const {
     std::shared_lock lock(mutex_);
     
     Bytes num_key = {'B', 'N'};
@@ -378,10 +676,7 @@ std::optional<Block> BlockStore::get_block(uint64_t number) const {
         num_key.push_back(static_cast<uint8_t>((number >> (i * 8)) & 0xFF));
     }
     
-    auto data = db_->get(num_key);
-    if (!data) return std::nullopt;
-    
-    return Block::decode(*data);
+    return db_->get(num_key);
 }
 
 std::optional<Block> BlockStore::get_block_by_hash(const Hash256& hash) const {
@@ -461,141 +756,53 @@ void BlockStore::store_receipt(const TransactionReceipt& receipt) {
     Bytes key = {'R', 'C', 'T'};
     key.insert(key.end(), receipt.transaction_hash.begin(), receipt.transaction_hash.end());
     
-    // Serialize receipt
-    Bytes value;
-    // 1. Success (1 byte)
-    value.push_back(receipt.success ? 1 : 0);
-    
-    // 2. Gas used (8 bytes)
-    for (int i = 7; i >= 0; --i) value.push_back(static_cast<uint8_t>((receipt.gas_used >> (i * 8)) & 0xFF));
-    
-    // 3. Block number (8 bytes)
-    for (int i = 7; i >= 0; --i) value.push_back(static_cast<uint8_t>((receipt.block_number >> (i * 8)) & 0xFF));
+    db_->put(key, receipt.encode());
+}
+
+std::optional<TransactionReceipt> BlockStore::get_receipt(const Hash256& tx_hash) const {
+    Bytes key = {'R', 'C', 'T'};
+    key.insert(key.end(), tx_hash.begin(), tx_hash.end());
     
-    // 4. Transaction index (8 bytes)
-    for (int i = 7; i >= 0; --i) value.push_back(static_cast<uint8_t>((receipt.transaction_index >> (i * 8)) & 0xFF));
+    auto data = db_->get(key);
+    if (!data) return std::nullopt;
     
-    // 5. Cumulative gas used (8 bytes)
-    for (int i = 7; i >= 0; --i) value.push_back(static_cast<uint8_t>((receipt.cumulative_gas_used >> (i * 8)) & 0xFF));
+    return TransactionReceipt::decode(tx_hash, *data);
+}
 
-    // 6. From address (28 bytes)
-    value.insert(value.end(), receipt.from.payment_credential.begin(), receipt.from.payment_credential.end());
+// ============================================================================
+// StateView Implementation
+// ============================================================================
 
-    // 7. To address (28 bytes)
-    value.insert(value.end(), receipt.to.payment_credential.begin(), receipt.to.payment_credential.end());
-    
-    // 8. Contract address (1 byte flag + 28 bytes if present)
-    if (receipt.contract_address) {
-        value.push_back(1);
-        value.insert(value.end(), receipt.contract_address->payment_credential.begin(), receipt.contract_address->payment_credential.end());
-    } else {
-        value.push_back(0);
-    }
+uint64_t StateView::get_balance(const Address& addr) const {
+    return get_account(addr).balance;
+}
 
-    // 9. Logs 
-    // Count (4 bytes)
-    uint32_t log_count = static_cast<uint32_t>(receipt.logs.size());
-    for (int i = 3; i >= 0; --i) value.push_back(static_cast<uint8_t>((log_count >> (i * 8)) & 0xFF));
-    
-    for (const auto& log : receipt.logs) {
-        // Address
-        value.insert(value.end(), log.address.payment_credential.begin(), log.address.payment_credential.end());
-        
-        // Topics count (1 byte)
-        value.push_back(static_cast<uint8_t>(log.topics.size()));
-        for (const auto& topic : log.topics) {
-            value.insert(value.end(), topic.begin(), topic.end());
-        }
-        
-        // Data length (4 bytes)
-        uint32_t data_len = static_cast<uint32_t>(log.data.size());
-        for (int i = 3; i >= 0; --i) value.push_back(static_cast<uint8_t>((data_len >> (i * 8)) & 0xFF));
-        // Data
-        value.insert(value.end(), log.data.begin(), log.data.end());
+void StateView::add_balance(const Address& addr, uint64_t amount) {
+    auto state = get_account(addr);
+    state.balance += amount;
+    set_account(addr, state);
+}
+
+void StateView::sub_balance(const Address& addr, uint64_t amount) {
+    auto state = get_account(addr);
+    if (state.balance >= amount) {
+        state.balance -= amount;
+        set_account(addr, state);
     }
+}
 
-    db_->put(key, value);
+uint64_t StateView::get_nonce(const Address& addr) const {
+    return get_account(addr).nonce;
 }
 
-std::optional<TransactionReceipt> BlockStore::get_receipt(const Hash256& tx_hash) const {
-    Bytes key = {'R', 'C', 'T'};
-    key.insert(key.end(), tx_hash.begin(), tx_hash.end());
-    
-    auto data = db_->get(key);
-    if (!data || data->size() < 17) return std::nullopt;
-    
-    TransactionReceipt receipt;
-    receipt.transaction_hash = tx_hash;
-    size_t offset = 0;
-    
-    // 1. Success
-    if (offset >= data->size()) return std::nullopt;
-    receipt.success = ((*data)[offset++] != 0);
-    receipt.status = receipt.success ? 1 : 0;
-    
-    // Helper to read uint64
-    auto read_uint64 = [&](size_t& off) {
-        uint64_t val = 0;
-        for (int i = 0; i < 8; ++i) val = (val << 8) | (*data)[off++];
-        return val;
-    };
-    
-    if (offset + 32 > data->size()) return std::nullopt; // Ensure enough bytes for basic fields
-    
-    receipt.gas_used = read_uint64(offset);
-    receipt.block_number = read_uint64(offset);
-    receipt.transaction_index = read_uint64(offset);
-    receipt.cumulative_gas_used = read_uint64(offset);
-    
-    // Addresses
-    if (offset + 56 > data->size()) return std::nullopt;
-    std::copy(data->begin() + offset, data->begin() + offset + 28, receipt.from.payment_credential.begin());
-    offset += 28;
-    std::copy(data->begin() + offset, data->begin() + offset + 28, receipt.to.payment_credential.begin());
-    offset += 28;
-    
-    // Contract address
-    if (offset >= data->size()) return std::nullopt;
-    if ((*data)[offset++]) {
-        if (offset + 28 > data->size()) return std::nullopt;
-        Address addr;
-        std::copy(data->begin() + offset, data->begin() + offset + 28, addr.payment_credential.begin());
-        receipt.contract_address = addr;
-        offset += 28;
-    }
-    
-    // Logs
-    if (offset + 4 > data->size()) return std::nullopt;
-    uint32_t log_count = 0;
-    for (int i = 0; i < 4; ++i) log_count = (log_count << 8) | (*data)[offset++];
-    
-    for (uint32_t k = 0; k < log_count; ++k) {
-        Log log;
-        if (offset + 28 >= data->size()) break;
-        std::copy(data->begin() + offset, data->begin() + offset + 28, log.address.payment_credential.begin());
-        offset += 28;
-        
-        uint8_t topic_count = (*data)[offset++];
-        for (int t = 0; t < topic_count; ++t) {
-            if (offset + 32 > data->size()) return std::nullopt;
-            Hash256 topic;
-            std::copy(data->begin() + offset, data->begin() + offset + 32, topic.begin());
-            log.topics.push_back(topic);
-            offset += 32;
-        }
-        
-        if (offset + 4 > data->size()) return std::nullopt;
-        uint32_t data_len = 0;
-        for (int i = 0; i < 4; ++i) data_len = (data_len << 8) | (*data)[offset++];
-        
-        if (offset + data_len > data->size()) return std::nullopt;
-        log.data.assign(data->begin() + offset, data->begin() + offset + data_len);
-        offset += data_len;
-        
-        receipt.logs.push_back(log);
-    }
-    
-    return receipt;
+void StateView::increment_nonce(const Address& addr) {
+    auto state = get_account(addr);
+    state.nonce++;
+    set_account(addr, state);
+}
+
+void StateView::credit_fee(const Address& coinbase, uint64_t amount) {
+    add_balance(coinbase, amount);
 }
 
 // ============================================================================
@@ -608,18 +815,42 @@ StateManager::StateManager(std::shared_ptr<Database> db)
 StateManager::StateManager(std::shared_ptr<Database> db, const Hash256& state_root)
     : db_(db), account_trie_(std::make_unique<StateTrie>(db, state_root)) {}
 
+StateManager::AccountKeyMemo::AccountKeyMemo() : entries_(CAPACITY) {}
+
+StateKey StateManager::AccountKeyMemo::lookup(const Address& addr) {
+    const auto& cred = addr.payment_credential;
+    
+    // FNV-1a over the credential picks the slot
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (uint8_t b : cred) {
+        h = (h ^ b) * 0x100000001b3ULL;
+    }
+    
+    std::lock_guard lock(mutex_);
+    auto& entry = entries_[h & (CAPACITY - 1)];
+    if (!entry.valid || entry.credential != cred) {
+        entry.credential = cred;
+        entry.key = StateKey::from_key(cred.data(), cred.size());
+        entry.valid = true;
+    }
+    return entry.key;
+}
+
 AccountState StateManager::get_account(const Address& addr) const {
-    auto key = Bytes(addr.payment_credential.begin(), addr.payment_credential.end());
-    auto data = account_trie_->get(key);
+    auto data = account_trie_->get(account_key(addr));
     
+    AccountState state;  // Empty account if absent
     if (data) {
-        return AccountState::decode(*data);
+        state = AccountState::decode(*data);
     }
-    return AccountState{};  // Empty account
+    if (pending_fees_ && is_fee_recipient(addr)) {
+        state.balance += *pending_fees_;
+    }
+    return state;
 }
 
 void StateManager::set_account(const Address& addr, const AccountState& state) {
-    auto key = Bytes(addr.payment_credential.begin(), addr.payment_credential.end());
+    auto key = account_key(addr);
     auto value = state.encode();
     
     // Record for journal (revert support)
@@ -632,36 +863,12 @@ void StateManager::set_account(const Address& addr, const AccountState& state) {
     journal_.push_back(entry);
     
     account_trie_->put(key, value);
-}
-
-uint64_t StateManager::get_balance(const Address& addr) const {
-    return get_account(addr).balance;
-}
-
-void StateManager::add_balance(const Address& addr, uint64_t amount) {
-    auto state = get_account(addr);
-    state.balance += amount;
-    set_account(addr, state);
-}
-
-void StateManager::sub_balance(const Address& addr, uint64_t amount) {
-    auto state = get_account(addr);
-    if (state.balance >= amount) {
-        state.balance -= amount;
-        set_account(addr, state);
+    
+    if (is_fee_recipient(addr)) {
+        pending_fees_.reset();
     }
 }
 
-uint64_t StateManager::get_nonce(const Address& addr) const {
-    return get_account(addr).nonce;
-}
-
-void StateManager::increment_nonce(const Address& addr) {
-    auto state = get_account(addr);
-    state.nonce++;
-    set_account(addr, state);
-}
-
 Bytes StateManager::get_storage(const Address& addr, const Hash256& key) const {
     // Storage key = account_address || slot_key
     Bytes storage_key(addr.payment_credential.begin(), addr.payment_credential.end());
@@ -685,30 +892,56 @@ void StateManager::set_storage(const Address& addr, const Hash256& key, const By
 }
 
 Bytes StateManager::get_code(const Address& addr) const {
-    auto state = get_account(addr);
+    return get_code_by_hash(get_account(addr).code_hash);
+}
+
+void StateManager::set_code(const Address& addr, const Bytes& code) {
+    auto code_hash = put_code(code);
     
+    // Update account
+    auto state = get_account(addr);
+    state.code_hash = code_hash;
+    set_account(addr, state);
+}
+
+Bytes StateManager::get_code_by_hash(const Hash256& code_hash) const {
     Bytes db_key = {'C', 'O', 'D', 'E'};
-    db_key.insert(db_key.end(), state.code_hash.begin(), state.code_hash.end());
+    db_key.insert(db_key.end(), code_hash.begin(), code_hash.end());
     
     auto data = db_->get(db_key);
     return data.value_or(Bytes{});
 }
 
-void StateManager::set_code(const Address& addr, const Bytes& code) {
+Hash256 StateManager::put_code(const Bytes& code) {
     auto code_hash = crypto::Blake2b256::hash(code);
     
     // Store code by hash
     Bytes db_key = {'C', 'O', 'D', 'E'};
     db_key.insert(db_key.end(), code_hash.begin(), code_hash.end());
     db_->put(db_key, code);
-    
-    // Update account
-    auto state = get_account(addr);
-    state.code_hash = code_hash;
-    set_account(addr, state);
+    return code_hash;
+}
+
+void StateManager::credit_fee(const Address& coinbase, uint64_t amount) {
+    if (!fee_recipient_) {
+        fee_recipient_ = coinbase;
+    } else if (!is_fee_recipient(coinbase)) {
+        add_balance(coinbase, amount);
+        return;
+    }
+    pending_fees_ = pending_fees_.value_or(0) + amount;
+}
+
+void StateManager::settle_fees() {
+    if (pending_fees_) {
+        // get_account folds the pending fees in; the write clears them
+        set_account(*fee_recipient_, get_account(*fee_recipient_));
+    }
+    fee_recipient_.reset();
 }
 
 Hash256 StateManager::commit() {
+    settle_fees();
     return account_trie_->commit();
 }
 
@@ -716,8 +949,17 @@ Hash256 StateManager::state_root() const {
     return account_trie_->root();
 }
 
+std::optional<StateMultiProof> StateManager::get_account_proof(const std::vector<Address>& addrs) const {
+    std::vector<StateKey> keys;
+    keys.reserve(addrs.size());
+    for (const auto& addr : addrs) {
+        keys.push_back(account_key(addr));
+    }
+    return account_trie_->get_multiproof(keys);
+}
+
 StateManager::Snapshot StateManager::snapshot() const {
-    return Snapshot{account_trie_->root(), journal_.size()};
+    return Snapshot{account_trie_->root(), journal_.size(), pending_fees_};
 }
 
 void StateManager::revert(const Snapshot& snap) {
@@ -725,8 +967,7 @@ void StateManager::revert(const Snapshot& snap) {
     while (journal_.size() > snap.journal_size) {
         auto& entry = journal_.back();
         
-        auto key = Bytes(entry.addr.payment_credential.begin(), 
-                        entry.addr.payment_credential.end());
+        auto key = account_key(entry.addr);
         
         if (entry.prev_state.has_value()) {
             account_trie_->put(key, entry.prev_state->encode());
@@ -736,6 +977,12 @@ void StateManager::revert(const Snapshot& snap) {
         
         journal_.pop_back();
     }
+    
+    // With nothing held back, the next credit may pick a new coinbase
+    pending_fees_ = snap.pending_fees;
+    if (!pending_fees_) {
+        fee_recipient_.reset();
+    }
 }
 
 } // namespace storage